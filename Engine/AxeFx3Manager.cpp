@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2020-2021,2023,2025 Sean Echevarria
+ * Copyright (C) 2020-2021,2023,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -26,7 +26,7 @@
 #include <format>
 #include <algorithm>
 #include <QEvent>
-#include <QApplication>
+#include <QCoreApplication>
 #include <QTimer>
 #include <atomic>
 #include "CrossPlatform.h"
@@ -370,6 +370,14 @@ IsAxeFx3Sysex(const byte * bytes, const int len)
 	return true;
 }
 
+MidiInInterest
+AxeFx3Manager::GetMidiInInterest() const
+{
+	MidiInInterest interest;
+	interest.mSysexPrefixes.push_back({ FRACTAL_SYSEX_HEADER_BYTES, Axe3 });
+	return interest;
+}
+
 bool
 AxeFx3Manager::ReceivedSysex(const byte * bytes, int len)
 {
@@ -413,6 +421,12 @@ AxeFx3Manager::ReceivedSysex(const byte * bytes, int len)
 		{
 			const int curPreset = mCurrentAxePreset;
 			ReceivePresetNumber(&bytes[6], len - 6);
+			if (mCurrentAxePreset != curPreset && mMidiOut)
+			{
+				// maybe changed on the device; what was sent no longer applies
+				mMidiOut->ResetShadowState(mAxeChannel);
+			}
+
 			if (mCurrentAxePreset != curPreset || mPendingPresetRequests > 0)
 			{
 				if (mPendingPresetRequests > 0)
@@ -1208,14 +1222,14 @@ AxeFx3Manager::ReceiveStatusDump(const byte * bytes, int len)
 		{
 			// enable the looper patches (as inactive)
 			for (auto &looperPatch : mLooperPatches)
-				if (looperPatch->SupportsDisabledState())
+				if (looperPatch && looperPatch->SupportsDisabledState())
 					looperPatch->UpdateState(mSwitchDisplay, false);
 		}
 		else
 		{
 			// disable the looper patches
 			for (auto &looperPatch : mLooperPatches)
-				if (looperPatch->SupportsDisabledState())
+				if (looperPatch && looperPatch->SupportsDisabledState())
 					looperPatch->Disable(mSwitchDisplay);
 		}
 	}
@@ -1492,6 +1506,9 @@ AxeFx3Manager::UpdateSceneStatus(int newScene, bool internalUpdate)
 	if (mCurrentScene > -1 && mScenePatches[mCurrentScene])
 		mScenePatches[mCurrentScene]->UpdateState(mSwitchDisplay, false);
 
+	if (!internalUpdate && mMidiOut)
+		mMidiOut->ResetShadowState(mAxeChannel);
+
 	mCurrentScene = newScene;
 
 	if (mScenePatches[mCurrentScene])
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2020-2021,2025 Sean Echevarria
+ * Copyright (C) 2020-2021,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -69,6 +69,7 @@ public:
 	virtual void ReceivedData(byte b1, byte b2, byte b3) override;
 	virtual bool ReceivedSysex(const byte * bytes, int len) override;
 	virtual void Closed(IMidiInPtr midIn) override;
+	virtual MidiInInterest GetMidiInInterest() const override;
 
 	void CompleteInit(MidiControlEnginePtr eng, IMidiOutPtr midiOut);
 	void SubscribeToMidiIn(IMidiInPtr midiIn);
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2010-2015,2018,2020,2025 Sean Echevarria
+ * Copyright (C) 2010-2015,2018,2020,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -27,7 +27,7 @@
 #include <format>
 #include <algorithm>
 #include <QEvent>
-#include <QApplication>
+#include <QCoreApplication>
 #include <QTimer>
 #include <atomic>
 #include "CrossPlatform.h"
@@ -293,6 +293,15 @@ IsAxeFxSysex(const byte * bytes, const int len)
 	return false;
 }
 
+MidiInInterest
+AxeFxManager::GetMidiInInterest() const
+{
+	MidiInInterest interest;
+	for (const byte model : { AxeStd, AxeUltra, Axe2, Axe2XL, Axe2XLPlus })
+		interest.mSysexPrefixes.push_back({ 0xf0, 0x00, 0x01, 0x74, model });
+	return interest;
+}
+
 bool
 AxeFxManager::ReceivedSysex(const byte * bytes, int len)
 {
@@ -377,6 +386,8 @@ AxeFxManager::ReceivedSysex(const byte * bytes, int len)
 	case 0x14:
 		// preset loaded
 		ReceivePresetNumber(&bytes[6], len - 6);
+		if (mMidiOut)
+			mMidiOut->ResetShadowState(mAxeChannel);
 		DelayedNameSyncFromAxe(true);
 		break;
 	case 0x20:
@@ -384,6 +395,8 @@ AxeFxManager::ReceivedSysex(const byte * bytes, int len)
 		break;
 	case 0x21:
 		// x/y change or scene selected
+		if (mMidiOut)
+			mMidiOut->ResetShadowState(mAxeChannel);
 		DelayedEffectsSyncFromAxe();
 		break;
 	case 0x23:
@@ -1343,9 +1356,7 @@ AxeFxManager::ReceivePresetEffectsV2(const byte * bytes, int len)
 				if (inf->mXyPatch)
 				{
 					// X is the active state, Y is inactive
-#ifdef _DEBUG
-					const bool isX = isActive || isBypassed;
-#endif
+					[[maybe_unused]] const bool isX = isActive || isBypassed;
 					const bool isY = isActiveY || isBypassedY;
 					_ASSERTE(isX ^ isY);
 					// Axe-FxII considers X active and Y inactive, but I prefer
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2010-2014,2018,2020-2021,2025 Sean Echevarria
+ * Copyright (C) 2010-2014,2018,2020-2021,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -29,6 +29,7 @@
 #include <qmutex.h>
 #include <time.h>
 #include <set>
+#include <list>
 #include <memory>
 #include "IMidiInSubscriber.h"
 #include "AxemlLoader.h"
@@ -65,6 +66,7 @@ public:
 	virtual void ReceivedData(byte b1, byte b2, byte b3) override;
 	virtual bool ReceivedSysex(const byte * bytes, int len) override;
 	virtual void Closed(IMidiInPtr midIn) override;
+	virtual MidiInInterest GetMidiInInterest() const override;
 
 	void CompleteInit(IMidiOutPtr midiOut);
 	void SubscribeToMidiIn(IMidiInPtr midiIn);
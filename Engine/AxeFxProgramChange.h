@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2010-2012,2018,2020,2025 Sean Echevarria
+ * Copyright (C) 2010-2012,2018,2020,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -49,6 +49,9 @@ public:
 			mAxeMgr->DelayedNameSyncFromAxe();
 	}
 
+	// does more than send
+	const EncodedMidi * GetEncodedMidi(IMidiOut *&) override { return nullptr; }
+
 private:
 	AxeFxProgramChange();
 
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2009-2010,2018,2024-2025 Sean Echevarria
+ * Copyright (C) 2009-2010,2018,2024-2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -44,6 +44,12 @@ public:
 		xp::Sleep(GetSleepAmount()); // amount in milliseconds
 	}
 
+	// PatchCommandScheduler waits instead of calling Exec
+	virtual int GetDelayAmount() override
+	{
+		return GetSleepAmount();
+	}
+
 protected:
 	virtual int GetSleepAmount() = 0;
 };
@@ -42,6 +42,8 @@ public:
 		mEngine->EnableMidiClock(true);
 	}
 
+	virtual bool IsSchedulable() override { return false; }
+
 private:
 	EnableMidiClockCommand();
 
@@ -63,6 +65,8 @@ public:
 		mEngine->EnableMidiClock(false);
 	}
 
+	virtual bool IsSchedulable() override { return false; }
+
 private:
 	DisableMidiClockCommand();
 
@@ -85,6 +89,8 @@ public:
 		mEngine->SetTempo(mTempo);
 	}
 
+	virtual bool IsSchedulable() override { return false; }
+
 private:
 	SetClockTempoCommand();
 
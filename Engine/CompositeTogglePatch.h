@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2021,2025 Sean Echevarria
+ * Copyright (C) 2021,2025-2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -49,6 +49,8 @@ public:
 	}
 
 	virtual std::string GetPatchTypeStr() const override { return "compositeToggle"; }
+	// sub-patches can change state on their own
+	virtual bool IsBankTransitionStateful() const override { return false; }
 
 	virtual void CompleteInit(MidiControlEngine * eng, ITraceDisplay * trc) override
 	{
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2022,2025 Sean Echevarria
+ * Copyright (C) 2022,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -38,6 +38,7 @@ ControllerInputMonitor::ControllerInputMonitor(ISwitchDisplay * switchDisp, ITra
 void
 ControllerInputMonitor::SubscribeToMidiIn(IMidiInPtr midiIn)
 {
+	mMidiIn = midiIn;
 	midiIn->Subscribe(shared_from_this());
 }
 
@@ -53,6 +54,11 @@ ControllerInputMonitor::AddPatch(ControllerTogglePatchPtr p, int channel, int co
 	}
 
 	mPatches[key] = p;
+
+	// the port routes to us only what we were interested in when it last
+	// asked
+	if (IMidiInPtr midiIn = mMidiIn.lock())
+		midiIn->InterestChanged();
 }
 
 void
@@ -76,6 +82,16 @@ ControllerInputMonitor::ReceivedSysex(const byte * bytes, int len)
 	return false;
 }
 
+MidiInInterest
+ControllerInputMonitor::GetMidiInInterest() const
+{
+	// only control changes for the monitored channel/controller pairs
+	MidiInInterest interest;
+	for (const auto & cur : mPatches)
+		interest.mShortMsgs.push_back({ 0xb0, cur.first.first, cur.first.second });
+	return interest;
+}
+
 void
 ControllerInputMonitor::Closed(IMidiInPtr midIn)
 {
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2022 Sean Echevarria
+ * Copyright (C) 2022,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -54,6 +54,7 @@ public:
 	void ReceivedData(byte b1, byte b2, byte b3) override;
 	bool ReceivedSysex(const byte * bytes, int len) override;
 	void Closed(IMidiInPtr midIn) override;
+	MidiInInterest GetMidiInInterest() const override;
 
 private:
 	ITraceDisplay	* mTrace;
@@ -61,6 +62,7 @@ private:
 	using ListenerMapKey = std::pair<int, int>;
 	using ListenerMap = std::map<ListenerMapKey, ControllerTogglePatchPtr>;
 	ListenerMap mPatches;
+	std::weak_ptr<IMidiIn> mMidiIn;	// port subscribed to; it holds a reference to us
 };
 
 #endif // ControllerInputMonitor_h__
@@ -42,7 +42,8 @@ public:
 		const std::string & name,
 		IMidiOutPtr midiOut,
 		int channel,
-		int controller) :
+		int controller,
+		bool stateful = true) :
 		TogglePatch(number, name, midiOut)
 	{
 		Bytes bytesA, bytesB;
@@ -54,8 +55,12 @@ public:
 		bytesB.push_back((byte)controller);
 		bytesB.push_back(0);
 
-		mCmdsA.push_back(std::make_shared<MidiCommandString>(midiOut, bytesA));
-		mCmdsB.push_back(std::make_shared<MidiCommandString>(midiOut, bytesB));
+		auto cmdA = std::make_shared<MidiCommandString>(midiOut, bytesA);
+		auto cmdB = std::make_shared<MidiCommandString>(midiOut, bytesB);
+		cmdA->SetStateful(stateful);
+		cmdB->SetStateful(stateful);
+		mCmdsA.push_back(cmdA);
+		mCmdsB.push_back(cmdB);
 	}
 
 	virtual std::string GetPatchTypeStr() const override { return "controllerToggle"; }
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2024-2025 Sean Echevarria
+ * Copyright (C) 2024-2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -22,10 +22,26 @@
  * Contact Sean: "fester" at the domain of the original project site
  */
 
+#include <atomic>
 #include "DynamicMidiCommand.h"
 #include "IMidiOutGenerator.h"
 
 
+// Patches run on the UI thread and on the PatchCommandScheduler thread, so
+// the random velocity engine and distributions are per thread: a draw
+// neither locks nor races, and nothing is allocated after the first draw
+// on a thread.
+struct RandomVelocityState
+{
+	static constexpr int kMidiChannels = 16;
+
+	std::default_random_engine			mGenerator;
+	std::uniform_int_distribution<int>	mDistribution[kMidiChannels];
+};
+
+static thread_local RandomVelocityState tRandomVelocity;
+
+
 class DynamicMidiData
 {
 public:
@@ -60,9 +76,9 @@ public:
 			mDynamicMidiOut[mDynamicOutPort] = mMidiOutGenerator->GetMidiOut(mMidiOutPortToDeviceIdxMap[mDynamicOutPort]);
 	}
 
-	IMidiOutPtr GetDynamicMidiOut() const
+	IMidiOut * GetDynamicMidiOut() const
 	{
-		return mDynamicMidiOut[mDynamicOutPort];
+		return mDynamicMidiOut[mDynamicOutPort].get();
 	}
 
 	int GetDynamicOutPort() const { return mDynamicOutPort; }
@@ -77,27 +93,29 @@ public:
 
 	void SetDynamicChannelVelocity(int vel)
 	{
-		mRandomNoteVelocityLower[mDynamicChannel] = mRandomNoteVelocityUpper[mDynamicChannel] = vel;
+		SetDynamicChannelRandomVelocity(vel, vel);
 	}
 
 	void SetDynamicChannelRandomVelocity(int lowerVel, int upperVel)
 	{
-		if (lowerVel == upperVel)
-		{
-			SetDynamicChannelVelocity(lowerVel);
-			return;
-		}
-
-		mRandomNoteVelocityLower[mDynamicChannel] = lowerVel;
-		mRandomNoteVelocityUpper[mDynamicChannel] = upperVel;
-		mRandomVelocityDistribution[mDynamicChannel] = std::uniform_int_distribution<int>(mRandomNoteVelocityLower[mDynamicChannel], mRandomNoteVelocityUpper[mDynamicChannel]);
+		if (lowerVel > upperVel)
+			std::swap(lowerVel, upperVel);
+		mVelocityRange[mDynamicChannel] = PackRange(lowerVel, upperVel);
 	}
 
-	int GetDynamicVelocity()
+	int GetDynamicVelocity() const
 	{
-		if (mRandomNoteVelocityLower[mDynamicChannel] == mRandomNoteVelocityUpper[mDynamicChannel])
-			return (byte)mRandomNoteVelocityLower[mDynamicChannel];
-		return (byte)mRandomVelocityDistribution[mDynamicChannel](mGenerator);
+		const int ch = mDynamicChannel;
+		const unsigned int range = mVelocityRange[ch];
+		const int lowerVel = range & 0xffff;
+		const int upperVel = range >> 16;
+		if (lowerVel == upperVel)
+			return (byte)lowerVel;
+
+		std::uniform_int_distribution<int> & dist = tRandomVelocity.mDistribution[ch];
+		if (dist.a() != lowerVel || dist.b() != upperVel)
+			dist.param(std::uniform_int_distribution<int>::param_type(lowerVel, upperVel));
+		return (byte)dist(tRandomVelocity.mGenerator);
 	}
 
 private:
@@ -108,32 +126,30 @@ private:
 	MidiPortToDeviceIdxMap mMidiOutPortToDeviceIdxMap{};
 
 
-	static constexpr int kMidiChannels = 16;
+	static constexpr int kMidiChannels = RandomVelocityState::kMidiChannels;
 	static constexpr int kMaxDynamicPorts = 16;
 	static constexpr int kDefaultVelocity = 127;
 
 	int mDynamicOutPort = 0; // used as index into the sDynamicMidiOut array
 	IMidiOutPtr mDynamicMidiOut[kMaxDynamicPorts];
 
-	int mDynamicChannel = 0; // used as index into the next 3 arrays
+	static constexpr unsigned int PackRange(int lowerVel, int upperVel) { return (unsigned int)lowerVel | ((unsigned int)upperVel << 16); }
+
+	int mDynamicChannel = 0; // used as index into mVelocityRange
 	// velocity can be set independently per channel (even though channel in a particular 
 	// command instance might not be dynamic)
-	// upper and lower are same if not random; start out dynamic but not random
-	int mRandomNoteVelocityLower[kMidiChannels]{
-		kDefaultVelocity, kDefaultVelocity, kDefaultVelocity, kDefaultVelocity,
-		kDefaultVelocity, kDefaultVelocity, kDefaultVelocity, kDefaultVelocity,
-		kDefaultVelocity, kDefaultVelocity, kDefaultVelocity, kDefaultVelocity,
-		kDefaultVelocity, kDefaultVelocity, kDefaultVelocity, kDefaultVelocity
-	};
-	int mRandomNoteVelocityUpper[kMidiChannels]{
-		kDefaultVelocity, kDefaultVelocity, kDefaultVelocity, kDefaultVelocity,
-		kDefaultVelocity, kDefaultVelocity, kDefaultVelocity, kDefaultVelocity,
-		kDefaultVelocity, kDefaultVelocity, kDefaultVelocity, kDefaultVelocity,
-		kDefaultVelocity, kDefaultVelocity, kDefaultVelocity, kDefaultVelocity
+	// lower | upper << 16; upper and lower are same if not random; start out dynamic but not random.
+	// packed so that a concurrent Exec never sees a half updated range.
+	std::atomic<unsigned int> mVelocityRange[kMidiChannels]{
+		PackRange(kDefaultVelocity, kDefaultVelocity), PackRange(kDefaultVelocity, kDefaultVelocity),
+		PackRange(kDefaultVelocity, kDefaultVelocity), PackRange(kDefaultVelocity, kDefaultVelocity),
+		PackRange(kDefaultVelocity, kDefaultVelocity), PackRange(kDefaultVelocity, kDefaultVelocity),
+		PackRange(kDefaultVelocity, kDefaultVelocity), PackRange(kDefaultVelocity, kDefaultVelocity),
+		PackRange(kDefaultVelocity, kDefaultVelocity), PackRange(kDefaultVelocity, kDefaultVelocity),
+		PackRange(kDefaultVelocity, kDefaultVelocity), PackRange(kDefaultVelocity, kDefaultVelocity),
+		PackRange(kDefaultVelocity, kDefaultVelocity), PackRange(kDefaultVelocity, kDefaultVelocity),
+		PackRange(kDefaultVelocity, kDefaultVelocity), PackRange(kDefaultVelocity, kDefaultVelocity)
 	};
-	std::uniform_int_distribution<int> mRandomVelocityDistribution[kMidiChannels];
-
-	std::default_random_engine mGenerator;
 };
 
 DynamicMidiData* gDynamicMidiData = nullptr;
@@ -168,6 +184,22 @@ DynamicMidiCommand::GetDynamicMidiChannel()
 	return pMidiData->GetDynamicChannel();
 }
 
+DynamicMidiCommand::DynamicMidiCommand(IMidiOutPtr midiOut,
+									   const Bytes & midiString,
+									   bool dynamicChannel /*= false*/,
+									   bool dynamicVelocity /*= false*/) :
+	mMidiOut(midiOut),
+	mDynamicChannel(dynamicChannel),
+	mDynamicVelocity(dynamicVelocity)
+{
+	mOtherMsgs.Encode(midiString);
+	if (1 == mOtherMsgs.MessageCount() && !mOtherMsgs.GetMessages()[0].IsSysex())
+	{
+		mEventTemplate = mOtherMsgs.GetMessages()[0].mEvent;
+		mOtherMsgs.Clear();
+	}
+}
+
 void
 DynamicMidiCommand::Exec()
 {
@@ -178,51 +210,39 @@ DynamicMidiCommand::Exec()
 		return;
 	}
 
-	IMidiOutPtr	curMidiOut = mMidiOut ? mMidiOut : pMidiData->GetDynamicMidiOut();
+	// raw pointer; the ports outlive the patches and a shared_ptr copy
+	// is two interlocked operations per send
+	IMidiOut * curMidiOut = mMidiOut ? mMidiOut.get() : pMidiData->GetDynamicMidiOut();
 	if (!curMidiOut)
 		return;
 
-	Bytes commandString(mCommandStringTemplate);
-
-	switch (commandString.size())
+	if (!mEventTemplate.IsValid())
 	{
-	case 3:
-		if ((commandString[0] & 0xF0) == 0x90)
-		{
-			// Note on
-			if (mDynamicChannel)
-				commandString[0] = commandString[0] | (byte)pMidiData->GetDynamicChannel();
-
-			if (mDynamicVelocity)
-				commandString[2] = (byte)pMidiData->GetDynamicVelocity();
-		}
-		else if (mDynamicChannel)
-		{
-			if ((commandString[0] & 0xF0) == 0x80)
-			{
-				// Note off -- don't use dynamic velocity
-				commandString[0] = commandString[0] | (byte)pMidiData->GetDynamicChannel();
-			}
-			else if ((commandString[0] & 0xF0) == 0xb0)
-			{
-				// Control change
-				commandString[0] = commandString[0] | (byte)pMidiData->GetDynamicChannel();
-			}
-		}
+		if (!mOtherMsgs.Empty())
+			curMidiOut->MidiOut(mOtherMsgs);
+		return;
+	}
 
-		curMidiOut->MidiOut(commandString[0], commandString[1], commandString[2]);
-		break;
-	case 2:
-		if (mDynamicChannel && (commandString[0] & 0xF0) == 0xc0) // Program change
-			commandString[0] = commandString[0] | (byte)pMidiData->GetDynamicChannel();
+	MidiEvent evt(mEventTemplate);
+	switch (evt.GetCommand())
+	{
+	case 0x90:
+		// Note on
+		if (mDynamicChannel)
+			evt.AddChannel((byte)pMidiData->GetDynamicChannel());
 
-		curMidiOut->MidiOut(commandString[0], commandString[1]);
+		if (mDynamicVelocity)
+			evt.SetData2((byte)pMidiData->GetDynamicVelocity());
 		break;
-	case 0:
+	case 0x80:		// Note off -- don't use dynamic velocity
+	case 0xb0:		// Control change
+	case 0xc0:		// Program change
+		if (mDynamicChannel)
+			evt.AddChannel((byte)pMidiData->GetDynamicChannel());
 		break;
-	default:
-		curMidiOut->MidiOut(commandString);
 	}
+
+	curMidiOut->MidiOut(evt);
 }
 
 void
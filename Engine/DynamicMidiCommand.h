@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2024 Sean Echevarria
+ * Copyright (C) 2024,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -38,15 +38,9 @@ class DynamicMidiCommand : public IPatchCommand
 {
 public:
 	DynamicMidiCommand(IMidiOutPtr midiOut,
-					  Bytes & midiString,
+					  const Bytes & midiString,
 					  bool dynamicChannel = false,
-					  bool dynamicVelocity = false) :
-		mMidiOut(midiOut),
-		mDynamicChannel(dynamicChannel),
-		mDynamicVelocity(dynamicVelocity)
-	{
-		mCommandStringTemplate.swap(midiString);
-	}
+					  bool dynamicVelocity = false);
 
 	virtual void Exec() override;
 
@@ -59,7 +53,10 @@ private:
 
 private:
 	IMidiOutPtr	mMidiOut = nullptr;
-	Bytes	mCommandStringTemplate;
+	// a single channel message gets the dynamic substitutions; anything
+	// else is sent as-is from mOtherMsgs
+	MidiEvent	mEventTemplate;
+	EncodedMidi	mOtherMsgs;
 	bool	mDynamicChannel = false;
 	bool	mDynamicVelocity = false;
 };
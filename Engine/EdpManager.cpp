@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2021-2023,2025 Sean Echevarria
+ * Copyright (C) 2021-2023,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -68,10 +68,12 @@ EdpManager::ReceivedData(byte b1, byte b2, byte b3)
 // 	}
 }
 
+#define EDP_SYSEX_HEADER_BYTES 0xF0, 0x00, 0x01, 0x30, 0x0B
+
 bool
 IsEdpSysex(const byte * bytes, const int len)
 {
-	constexpr byte kEdpSysexHeader[] = { 0xF0, 0x00, 0x01, 0x30, 0x0B };
+	constexpr byte kEdpSysexHeader[] = { EDP_SYSEX_HEADER_BYTES };
 	if (len < sizeof(kEdpSysexHeader))
 		return false;
 
@@ -81,6 +83,14 @@ IsEdpSysex(const byte * bytes, const int len)
 	return true;
 }
 
+MidiInInterest
+EdpManager::GetMidiInInterest() const
+{
+	MidiInInterest interest;
+	interest.mSysexPrefixes.push_back({ EDP_SYSEX_HEADER_BYTES });
+	return interest;
+}
+
 bool
 EdpManager::ReceivedSysex(const byte * bytesIn, int len)
 {
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2021,2023 Sean Echevarria
+ * Copyright (C) 2021,2023,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -63,6 +63,7 @@ public:
 	void ReceivedData(byte b1, byte b2, byte b3) override;
 	bool ReceivedSysex(const byte * bytes, int len) override;
 	void Closed(IMidiInPtr midIn) override;
+	MidiInInterest GetMidiInInterest() const override;
 
 private:
 	void ReceiveInfoData(const byte * bytes, int len);
@@ -0,0 +1,120 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#include <format>
+#include "EncodedMidi.h"
+
+#define SYSEX			0xF0
+#define EOX				0xF7
+
+
+int
+EncodedMidi::GetDataByteCount(byte statusByte)
+{
+	// number of data bytes for each status
+	static const int kMsgDataBytesLen = 23;
+	static const int kMsgDataBytes[23] = { 2, 2, 2, 2, 1, 1, 2, 0, 1, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+	if (statusByte < 0x80 || SYSEX == statusByte)
+		return -1;
+
+	int statusByteIdx;
+	if ((statusByte & 0xF0) < SYSEX)		// is it a channel message?
+		statusByteIdx = ((statusByte & 0xF0) >> 4) - 8;
+	else		// or system message
+		statusByteIdx = (statusByte & 0x0F) + 7;
+
+	return statusByteIdx >= kMsgDataBytesLen ? 0 : kMsgDataBytes[statusByteIdx];
+}
+
+bool
+EncodedMidi::Encode(const Bytes & bytes,
+					std::string * errMsg /*= nullptr*/)
+{
+	mBytes = bytes;
+	mMsgs.clear();
+
+	const size_t kDataSize = mBytes.size();
+	const byte * dataPtr = mBytes.data();
+	size_t idx = 0;
+
+	while (idx < kDataSize)
+	{
+		const byte statusByte = dataPtr[idx];
+		if (SYSEX == statusByte)
+		{
+			// span runs to the EOX that balances this SYSEX (nesting is
+			// tolerated) or to the end of the string if it is unterminated
+			int sysexDepth = 0;
+			size_t curMsgLen = 0;
+			do
+			{
+				const byte cur = dataPtr[idx + curMsgLen];
+				if (SYSEX == cur)
+					sysexDepth++;
+				else if (EOX == cur)
+					sysexDepth--;
+				++curMsgLen;
+			}
+			while (sysexDepth && (idx + curMsgLen) < kDataSize);
+
+			mMsgs.push_back({MidiEvent(), (unsigned int)idx, (unsigned int)curMsgLen});
+			idx += curMsgLen;
+			continue;
+		}
+
+		const int dataBytes = GetDataByteCount(statusByte);
+		if (dataBytes < 0)
+		{
+			if (errMsg)
+				*errMsg = std::format("Status byte handling error at byte {} ({:x}).\n", idx + 1, statusByte);
+			return false;
+		}
+
+		if ((idx + dataBytes + 1) > kDataSize)
+		{
+			if (errMsg)
+				*errMsg = std::format("Data string consistency error at byte {}.  Missing data byte.\n", idx + 1);
+			return false;
+		}
+
+		unsigned int shortMsg = statusByte;
+		if (dataBytes > 0)
+			shortMsg |= dataPtr[idx + 1] << 8;
+		if (dataBytes > 1)
+			shortMsg |= dataPtr[idx + 2] << 16;
+
+		mMsgs.push_back({MidiEvent(shortMsg), 0, 0});
+		idx += dataBytes + 1;
+	}
+
+	return true;
+}
+
+void
+EncodedMidi::Clear()
+{
+	mBytes.clear();
+	mMsgs.clear();
+}
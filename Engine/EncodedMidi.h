@@ -0,0 +1,86 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#ifndef EncodedMidi_h__
+#define EncodedMidi_h__
+
+#include <string>
+#include <vector>
+#include "MidiEvent.h"
+
+using byte = unsigned char;
+using Bytes = std::vector<byte>;
+
+
+// EncodedMidi
+// ----------------------------------------------------------------------------
+// A midi byte string split at message boundaries ahead of time so that
+// sending it requires no parsing.
+// Channel and system messages are packed as MidiEvents; sysex is kept as a
+// span into mBytes.
+//
+class EncodedMidi
+{
+public:
+	struct Msg
+	{
+		MidiEvent		mEvent;			// empty for sysex
+		unsigned int	mSysexOffset;
+		unsigned int	mSysexLength;
+
+		bool IsSysex() const { return mSysexLength != 0; }
+	};
+
+	using Msgs = std::vector<Msg>;
+
+	EncodedMidi() = default;
+	explicit EncodedMidi(const Bytes & bytes) { Encode(bytes); }
+
+	// on malformed data, returns false (with description in errMsg) and
+	// retains the messages that preceded the error
+	bool Encode(const Bytes & bytes, std::string * errMsg = nullptr);
+	void Clear();
+
+	bool Empty() const { return mMsgs.empty(); }
+	size_t MessageCount() const { return mMsgs.size(); }
+	const Msgs & GetMessages() const { return mMsgs; }
+	const Bytes & GetBytes() const { return mBytes; }
+	const byte * GetSysexData(const Msg & msg) const { return &mBytes[msg.mSysexOffset]; }
+
+	// sets a state (a toggle's A or B) rather than triggering something, so
+	// its control changes can be dropped when the device already has their
+	// values (see MidiOutShadow)
+	void SetStateful(bool stateful) { mStateful = stateful; }
+	bool IsStateful() const { return mStateful; }
+
+	// number of data bytes that follow the status byte; -1 for data bytes and sysex
+	static int GetDataByteCount(byte statusByte);
+
+private:
+	Bytes	mBytes;
+	Msgs	mMsgs;
+	bool	mStateful = false;
+};
+
+#endif // EncodedMidi_h__
@@ -68,6 +68,8 @@
 #include "SimpleProgramChangePatch.h"
 #include "RestCommand.h"
 #include "ClockCommands.h"
+#include "PatchCommandScheduler.h"
+#include "MidiInCapture.h"
 #include "CrossPlatform.h"
 
 
@@ -111,7 +113,7 @@ EngineLoader::CreateEngine(const std::string & engineSettingsFile)
 
 	{
 		size_t pos = engineSettingsFile.rfind("/");
-		if (pos != std::_Meta_npos)
+		if (pos != std::string::npos)
 			mConfigFileDirectory = engineSettingsFile.substr(0, pos + 1);
 	}
 
@@ -170,6 +172,7 @@ EngineLoader::CreateEngine(const std::string & engineSettingsFile)
 	}
 
 	DynamicMidiCommand::InitDynamicData(mMidiOutGenerator, mMidiOutPortToDeviceIdxMap);
+	PatchCommandScheduler::Init();
 	GenerateDefaultNotePatches();
 
 	pElem = hRoot.FirstChild("patches").FirstChildElement().Element();
@@ -295,15 +298,41 @@ EngineLoader::LoadSystemConfig(TiXmlElement * pElem)
 
 	// <midiDevice port="1" outIdx="3" activityIndicatorId="100" />
 	// <midiDevice port="2" out="Axe-Fx II" in="Axe-Fx II" activityIndicatorId="100" />
-	pChildElem = hRoot.FirstChild("MidiDevices").FirstChildElement().Element();
-	if (!pChildElem)
-		pChildElem = hRoot.FirstChild("midiDevices").FirstChildElement().Element();
+	// <midiDevice port="3" out="MIDISPORT" runningStatus="1" bandwidth="3125" />
+	// <midiDevice port="4" outIdx="2" shadowState="1" /> redundant sends are not made
+	// <midiDevices capture="stage.midicap"> records all midi input
+	MidiInCaptureWriterPtr midiInCapture;
+	std::vector<IMidiOutPtr> shadowedMidiOuts;
+	TiXmlElement * midiDevicesElem = hRoot.FirstChild("MidiDevices").Element();
+	if (!midiDevicesElem)
+		midiDevicesElem = hRoot.FirstChild("midiDevices").Element();
+	if (midiDevicesElem && midiDevicesElem->Attribute("capture") && mMidiInGenerator)
+	{
+		const std::string captureFile(midiDevicesElem->Attribute("capture"));
+		midiInCapture = std::make_shared<MidiInCaptureWriter>();
+		if (midiInCapture->Open(captureFile))
+		{
+			if (mTraceDisplay)
+				mTraceDisplay->Trace(std::format("Capturing MIDI input to {}\n", captureFile));
+		}
+		else
+		{
+			if (mTraceDisplay)
+				mTraceDisplay->Trace(std::format("Error loading config file midiDevices section: failed to open MIDI input capture file {}\n", captureFile));
+			midiInCapture = nullptr;
+		}
+	}
+
+	pChildElem = midiDevicesElem ? midiDevicesElem->FirstChildElement() : nullptr;
 	for ( ; pChildElem; pChildElem = pChildElem->NextSiblingElement())
 	{
 		int deviceIdx = -1;
 		int inDeviceIdx = -1;
 		int activityIndicatorId = -1;
 		int port = 1;
+		int runningStatus = 0;
+		int bandwidth = -1;
+		int shadowState = 0;
 		std::string inDevice, outDevice;
 
 		if (pChildElem->Attribute("in"))
@@ -314,6 +343,9 @@ EngineLoader::LoadSystemConfig(TiXmlElement * pElem)
 		pChildElem->QueryIntAttribute("port", &port);
 		pChildElem->QueryIntAttribute("outIdx", &deviceIdx);
 		pChildElem->QueryIntAttribute("activityIndicatorId", &activityIndicatorId);
+		pChildElem->QueryIntAttribute("runningStatus", &runningStatus);
+		pChildElem->QueryIntAttribute("bandwidth", &bandwidth);
+		pChildElem->QueryIntAttribute("shadowState", &shadowState);
 
 		unsigned int ledActiveColor = UINT_MAX;
 		unsigned int ledInactiveColor = UINT_MAX; // ignored
@@ -369,8 +401,24 @@ EngineLoader::LoadSystemConfig(TiXmlElement * pElem)
 			// first successful port binding is last one attempted for that port
 			if (mMidiOutPortToDeviceIdxMap.find(port) == mMidiOutPortToDeviceIdxMap.end())
 			{
-				if (mMidiOutGenerator->CreateMidiOut(deviceIdx, activityIndicatorId, ledActiveColor))
+				IMidiOutPtr midiOut = mMidiOutGenerator->CreateMidiOut(deviceIdx, activityIndicatorId, ledActiveColor);
+				if (midiOut)
+				{
 					mMidiOutPortToDeviceIdxMap[port] = deviceIdx;
+					if (1 == runningStatus || mRunningStatusPorts.find(port) != mRunningStatusPorts.end())
+						midiOut->EnableRunningStatus(true);
+					if (-1 != bandwidth)
+						midiOut->SetBandwidth(bandwidth);
+					if (1 == shadowState)
+					{
+						const unsigned int channels = 0xFFFF & ~mShadowExcludedChannels[port];
+						int axeFxChannel = mAxeFx3Manager && port == mAxe3SyncPort ? mAxeFx3Manager->GetChannel() : -1;
+						if (axeFxChannel < 0 || axeFxChannel > 15 || !(channels & (1u << axeFxChannel)))
+							axeFxChannel = -1;
+						midiOut->EnableShadowState(channels, axeFxChannel);
+						shadowedMidiOuts.push_back(midiOut);
+					}
+				}
 			}
 		}
 
@@ -383,6 +431,8 @@ EngineLoader::LoadSystemConfig(TiXmlElement * pElem)
 				if (midiIn)
 				{
 					mMidiInPortToDeviceIdxMap[port] = inDeviceIdx;
+					if (midiInCapture)
+						midiIn->SetCapture(midiInCapture, port);
 					if (mAxeFx3Manager && port == mAxe3SyncPort)
 						mAxeFx3Manager->SubscribeToMidiIn(midiIn);
 					if (mAxeFxManager && port == mAxeSyncPort)
@@ -405,6 +455,8 @@ EngineLoader::LoadSystemConfig(TiXmlElement * pElem)
 
 	mEngine = std::make_shared<MidiControlEngine>(mApp, mMainDisplay, mSwitchDisplay, mTraceDisplay,
 		mMidiOutGenerator, engOut, mAxeFxManager, mAxeFx3Manager, mEdpManager, incrementSwitch, decrementSwitch, modeSwitch);
+	for (const IMidiOutPtr & midiOut : shadowedMidiOuts)
+		mEngine->AddShadowedMidiOut(midiOut);
 
 	// <expression port="">
 	//   <globaExpr inputNumber="1" assignmentNumber="1" channel="" controller="" min="" max="" invert="0" enable="" />
@@ -644,10 +696,10 @@ EngineLoader::GeneratePatchNumbers(TiXmlElement* pElem, int &autoGeneratedPatchN
 			if (pElem->ValueStr() == "importPatches")
 			{
 				std::string importPatchFileStr = pElem->GetText();
-				if (std::_Meta_npos == importPatchFileStr.rfind(":"))
+				if (std::string::npos == importPatchFileStr.rfind(":") && '/' != importPatchFileStr[0])
 				{
-					if (std::_Meta_npos == importPatchFileStr.rfind("..") ||
-						std::_Meta_npos == importPatchFileStr.rfind("/"))
+					if (std::string::npos == importPatchFileStr.rfind("..") ||
+						std::string::npos == importPatchFileStr.rfind("/"))
 					{
 						// relative path, or filename only
 						importPatchFileStr = mConfigFileDirectory;
@@ -795,10 +847,10 @@ EngineLoader::LoadPatches(TiXmlElement * pElem)
 			if (pElem->ValueStr() == "importPatches")
 			{
 				std::string importPatchFileStr = pElem->GetText();
-				if (std::_Meta_npos == importPatchFileStr.rfind(":"))
+				if (std::string::npos == importPatchFileStr.rfind(":") && '/' != importPatchFileStr[0])
 				{
-					if (std::_Meta_npos == importPatchFileStr.rfind("..") ||
-						std::_Meta_npos == importPatchFileStr.rfind("/"))
+					if (std::string::npos == importPatchFileStr.rfind("..") ||
+						std::string::npos == importPatchFileStr.rfind("/"))
 					{
 						// relative path, or filename only
 						importPatchFileStr = mConfigFileDirectory;
@@ -927,11 +979,35 @@ EngineLoader::LoadPatches(TiXmlElement * pElem)
 		const bool kHasSingleChild = firstChildElem && !firstChildElem->NextSiblingElement();
 		int simpleProgramChangeChannel = -1;
 
+		// commands from elements with shadowState="0" are always sent, even
+		// by toggles
+		std::set<const IPatchCommand *> unshadowedCmds;
+		size_t elemCmdsStart = 0, elemCmds2Start = 0;
+		bool elemUnshadowed = false;
+		const auto noteUnshadowedCmds = [&]()
+		{
+			if (!elemUnshadowed)
+				return;
+
+			for (size_t idx = elemCmdsStart; idx < cmds.size(); ++idx)
+				unshadowedCmds.insert(cmds[idx].get());
+			for (size_t idx = elemCmds2Start; idx < cmds2.size(); ++idx)
+				unshadowedCmds.insert(cmds2[idx].get());
+		};
+
 		TiXmlElement * childElem;
 		for (childElem = firstChildElem;
 			 childElem; 
 			 childElem = childElem->NextSiblingElement())
 		{
+			// commands of the previous element are all in place
+			noteUnshadowedCmds();
+			elemCmdsStart = cmds.size();
+			elemCmds2Start = cmds2.size();
+			int elemShadowState = 1;
+			childElem->QueryIntAttribute("shadowState", &elemShadowState);
+			elemUnshadowed = 0 == elemShadowState;
+
 			bool isDynamicVel = false;
 			Bytes bytes;
 			const std::string& patchElement = childElem->ValueStr();
@@ -954,6 +1030,25 @@ EngineLoader::LoadPatches(TiXmlElement * pElem)
 						mTraceDisplay->Trace(std::format("Error loading config file: invalid midiByteString in patch '{}'\n", patchName));
 					continue;
 				}
+
+				// split into messages now so that Exec doesn't parse
+				EncodedMidi encoded;
+				std::string encodeErr;
+				if (!encoded.Encode(bytes, &encodeErr))
+				{
+					if (mTraceDisplay)
+						mTraceDisplay->Trace(std::format("Error loading config file: invalid midiByteString in patch '{}': {}", patchName, encodeErr));
+					continue;
+				}
+
+				if (!encoded.Empty())
+				{
+					if (group == "B")
+						cmds2.push_back(std::make_shared<MidiCommandString>(midiOut, std::move(encoded)));
+					else
+						cmds.push_back(std::make_shared<MidiCommandString>(midiOut, std::move(encoded)));
+				}
+				continue;
 			}
 			else if (patchElement == "RefirePedal")
 			{
@@ -1393,6 +1488,8 @@ EngineLoader::LoadPatches(TiXmlElement * pElem)
 			}
 		}
 
+		noteUnshadowedCmds();
+
 		int axeFxScene = 0;
 		int axeFxBlockId = 0;
 		int axeFxBlockChannel = 0;
@@ -1498,6 +1595,13 @@ EngineLoader::LoadPatches(TiXmlElement * pElem)
 			}
 		}
 
+		// the patches take the command lists; hold on to the commands in
+		// case they are stateful (see below)
+		PatchCommands patchCmds(cmds);
+		patchCmds.insert(patchCmds.end(), cmds2.begin(), cmds2.end());
+		int patchShadowState = 1;
+		pElem->QueryIntAttribute("shadowState", &patchShadowState);
+
 		bool patchTypeErr = false;
 		PatchPtr newPatch = nullptr;
 		if (patchType == "simpleProgramChange")
@@ -1549,7 +1653,7 @@ EngineLoader::LoadPatches(TiXmlElement * pElem)
 				continue;
 			}
 
-			ControllerTogglePatchPtr ctp{std::make_shared<ControllerTogglePatch>(patchNumber, patchName, midiOut, patchDefaultCh, data1)};
+			ControllerTogglePatchPtr ctp{std::make_shared<ControllerTogglePatch>(patchNumber, patchName, midiOut, patchDefaultCh, data1, 0 != patchShadowState)};
 			newPatch = ctp;
 
 			// [issue: #18] if attribute "inputDevice" exists, set up input monitor
@@ -1774,6 +1878,24 @@ EngineLoader::LoadPatches(TiXmlElement * pElem)
 				isAxeLooperPatch = mgr->SetLooperPatch(newPatch);
 		}
 
+		// only what toggles send to go to A or B is a state that need not be
+		// resent; momentary, normal, tap tempo, looper and scene commands act
+		// every time
+		if (patchShadowState && 
+			!isAxeLooperPatch && 
+			!axeFxScene &&
+			(patchType == "toggle" || patchType == "AxeToggle" || patchType == "persistentPedalOverride"))
+		{
+			for (const auto & cmd : patchCmds)
+			{
+				if (unshadowedCmds.find(cmd.get()) == unshadowedCmds.end())
+				{
+					if (auto cmdStr = std::dynamic_pointer_cast<MidiCommandString>(cmd))
+						cmdStr->SetStateful(true);
+				}
+			}
+		}
+
 		// setup patch led color
 		{
 			unsigned int ledActiveColor = UINT_MAX;
@@ -2706,6 +2828,8 @@ EngineLoader::LoadDeviceChannelMap(TiXmlElement * pElem)
 	<DeviceChannelMap>
 		<device channel="1" port="1">EDP</>
 		<device channel="2" port="2">H8000</>
+		<device channel="3" port="3" runningStatus="1">Pedal synth</>
+		<device channel="4" port="3" shadowState="0">Looper</>
 	</DeviceChannelMap>
  */
 	std::string dev;
@@ -2738,12 +2862,35 @@ EngineLoader::LoadDeviceChannelMap(TiXmlElement * pElem)
 		pElem->QueryIntAttribute("port", &port);
 		mDevicePorts[dev] = port;
 
+		// optional running status for the port (applied when midiDevices creates the port)
+		int runningStatus = 0;
+		pElem->QueryIntAttribute("runningStatus", &runningStatus);
+		if (1 == runningStatus)
+			mRunningStatusPorts.insert(-1 == port ? 1 : port);
+
+		// device changes state on its own (front panel, other controllers), 
+		// so its port's shadow state can't be trusted for its channel
+		int shadowState = 1;
+		pElem->QueryIntAttribute("shadowState", &shadowState);
+		const int shadowChannel = ::atoi(ch.c_str()) - 1;
+		const auto excludeFromShadow = [&]()
+		{
+			if (shadowChannel >= 0 && shadowChannel < 16)
+				mShadowExcludedChannels[-1 == port ? 1 : port] |= 1u << shadowChannel;
+		};
+
+		if (0 == shadowState)
+			excludeFromShadow();
+
 		if (dev == "EDP" || 
 			dev == "EDP+" ||
 			dev == "Echoplex Digital Pro" ||
 			dev == "Echoplex Digital Pro Plus" ||
 			dev == "Echoplex Digital Pro+")
 		{
+			// looper control changes are commands, not settings
+			excludeFromShadow();
+
 			if (!mEdpManager)
 			{
 				mEdpManager = std::make_shared<EdpManager>(mMainDisplay, mSwitchDisplay, mTraceDisplay);
@@ -108,6 +108,8 @@ private:
 	EdpManagerPtr			mEdpManager;
 	std::map<std::string, std::string> mDeviceChannels; // outboard device channels
 	std::map<std::string, int> mDevicePorts; // computer midi ports used to address outboard devices
+	std::set<int>			mRunningStatusPorts; // ports on which outgoing channel messages use running status
+	std::map<int, unsigned int> mShadowExcludedChannels; // per port, channels of devices that are not shadowed
 	std::string				mAxeDeviceName;
 	std::string				mAxe3DeviceName;
 	int						mAxeSyncPort = -1;
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2007-2011,2014-2015,2018,2020,2023,2025 Sean Echevarria
+ * Copyright (C) 2007-2011,2014-2015,2018,2020,2023,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -506,39 +506,36 @@ ExpressionControl::AdcValueChange(IMainDisplay * mainDisplay,
 				if (oldCoarseCcVal < newCoarseCcVal)
 				{
 					for (oldFineCcVal += kFineIncVal; oldFineCcVal < 127; oldFineCcVal += kFineIncVal)
-						mMidiOut->MidiOut(mMidiData[0], fineCh, oldFineCcVal, false);
+						mMidiOut->MidiOut(MidiEvent(mMidiData[0], fineCh, oldFineCcVal), false);
 
 					oldFineCcVal = 0;
-					mMidiOut->MidiOut(mMidiData[0], coarseCh, ++oldCoarseCcVal, false);
+					mMidiOut->MidiOut(MidiEvent(mMidiData[0], coarseCh, ++oldCoarseCcVal), false);
 				}
 				else
 				{
 					for (oldFineCcVal -= kFineIncVal; oldFineCcVal > 0 && oldFineCcVal < 127; oldFineCcVal -= kFineIncVal)
-						mMidiOut->MidiOut(mMidiData[0], fineCh, oldFineCcVal, false);
+						mMidiOut->MidiOut(MidiEvent(mMidiData[0], fineCh, oldFineCcVal), false);
 
 					oldFineCcVal = 127;
-					mMidiOut->MidiOut(mMidiData[0], coarseCh, --oldCoarseCcVal, false);
+					mMidiOut->MidiOut(MidiEvent(mMidiData[0], coarseCh, --oldCoarseCcVal), false);
 				}
 			}
 
 			if (oldFineCcVal < newFineCcVal)
 			{
 				for (oldFineCcVal += kFineIncVal; oldFineCcVal < newFineCcVal; oldFineCcVal += kFineIncVal)
-					mMidiOut->MidiOut(mMidiData[0], fineCh, oldFineCcVal, false);
+					mMidiOut->MidiOut(MidiEvent(mMidiData[0], fineCh, oldFineCcVal), false);
 			}
 			else if (oldFineCcVal > newFineCcVal)
 			{
 				for (oldFineCcVal -= kFineIncVal; oldFineCcVal > newFineCcVal && oldFineCcVal < 127; oldFineCcVal -= kFineIncVal)
-					mMidiOut->MidiOut(mMidiData[0], fineCh, oldFineCcVal, false);
+					mMidiOut->MidiOut(MidiEvent(mMidiData[0], fineCh, oldFineCcVal), false);
 			}
 
-			mMidiOut->MidiOut(mMidiData[0], fineCh, newFineCcVal, showStatus);
+			mMidiOut->MidiOut(MidiEvent(mMidiData[0], fineCh, newFineCcVal), showStatus);
 #else
 			if (mMidiOut)
-			{
-				mMidiOut->MidiOut(mMidiData[0], mMidiData[1], newCoarseCcVal, showStatus);
-				mMidiOut->MidiOut(mMidiData[0], mMidiData[1] + 32, newFineCcVal, showStatus);
-			}
+				mMidiOut->ControlChange14LatestValue(mMidiData[0], mMidiData[1], newCoarseCcVal, newFineCcVal, showStatus);
 #endif
 
 			mMidiData[4] = mMidiData[3];
@@ -574,7 +571,7 @@ ExpressionControl::AdcValueChange(IMainDisplay * mainDisplay,
 			mMidiData[3] = mMidiData[2];
 			mMidiData[2] = (byte)newCcVal;
 			if (mMidiOut)
-				mMidiOut->MidiOut(mMidiData[0], mMidiData[1], mMidiData[2], showStatus);
+				mMidiOut->ControlChangeLatestValue(mMidiData[0], mMidiData[1], mMidiData[2], showStatus);
 		}
 	}
 
@@ -798,16 +795,13 @@ ExpressionControl::Refire(IMainDisplay * mainDisplay)
 		if (0xff != mMidiData[2] && 0xff != mMidiData[3])
 		{
 			if (mMidiOut)
-			{
-				mMidiOut->MidiOut(mMidiData[0], mMidiData[1], mMidiData[2], true);
-				mMidiOut->MidiOut(mMidiData[0], mMidiData[1] + 32, mMidiData[3], true);
-			}
+				mMidiOut->ControlChange14LatestValue(mMidiData[0], mMidiData[1], mMidiData[2], mMidiData[3], true);
 		}
 	}
 	else
 	{
 		if (mMidiData[2] != 0xff && mMidiOut)
-			mMidiOut->MidiOut(mMidiData[0], mMidiData[1], mMidiData[2], true);
+			mMidiOut->ControlChangeLatestValue(mMidiData[0], mMidiData[1], mMidiData[2], true);
 	}
 }
 
@@ -846,9 +840,7 @@ public:
 	bool OpenMidiOut(unsigned int deviceIdx) override {return false;}
 	bool IsMidiOutOpen() const override {return false;}
 	bool MidiOut(const Bytes & bytes) override {return false;}
-	void MidiOut(byte singleByte, bool useIndicator = true) override {}
-	void MidiOut(byte byte1, byte byte2, bool useIndicator = true) override {}
-	void MidiOut(byte byte1, byte byte2, byte byte3, bool useIndicator = true) override {}
+	void MidiOut(MidiEvent evt, bool useIndicator = true) override {}
 	void CloseMidiOut() override {}
 	bool SuspendMidiOut() override { return false; }
 	bool ResumeMidiOut() override { return false; }
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2007-2010,2014-2015,2018,2020,2023,2025 Sean Echevarria
+ * Copyright (C) 2007-2010,2014-2015,2018,2020,2023,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -27,6 +27,7 @@
 
 #include <memory>
 #include "../Monome40h/IMonome40hInputSubscriber.h"
+#include "CrossPlatform.h"
 
 class Patch;
 class IMainDisplay;
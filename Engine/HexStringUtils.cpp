@@ -1,5 +1,5 @@
 /*
-Original code copyright (c) 2007-2009,2010,2015,2020,2025 Sean Echevarria ( http://www.creepingfog.com/sean/ )
+Original code copyright (c) 2007-2009,2010,2015,2020,2025,2026 Sean Echevarria ( http://www.creepingfog.com/sean/ )
 
 This software is provided 'as-is', without any express or implied
 warranty. In no event will the authors be held liable for any
@@ -26,6 +26,7 @@ distribution.
 #include <stdio.h>
 #include <assert.h>
 #include "HexStringUtils.h"
+#include "CrossPlatform.h"
 
 
 byte 
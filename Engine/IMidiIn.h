@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2010,2013,2018 Sean Echevarria
+ * Copyright (C) 2010,2013,2018,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -30,13 +30,29 @@
 
 using byte = unsigned char;
 class IMidiInSubscriber;
+class MidiInCaptureWriter;
 
 using IMidiInSubscriberPtr = std::shared_ptr<IMidiInSubscriber>;
+using MidiInCaptureWriterPtr = std::shared_ptr<MidiInCaptureWriter>;
+
+// events received by a port and handed to its subscribers.
+// latency is from the driver callback to the start of dispatch.
+struct MidiInStats
+{
+	unsigned long long	mEventsDispatched = 0;
+	unsigned long long	mTotalLatencyUs = 0;
+	unsigned int		mMaxLatencyUs = 0;
+	unsigned int		mOverruns = 0;		// events dropped because the input queue was full
+	unsigned int		mMaxDepth = 0;		// most events waiting for dispatch at once
+	unsigned int		mSysexDropped = 0;	// larger than the reassembly limit
+	unsigned int		mSysexTruncated = 0;	// cut off before the EOX
+};
 
 
 // IMidiIn
 // ----------------------------------------------------------------------------
 // use to receive MIDI
+// Subscribe and Unsubscribe can be called while the port is open.
 //
 class IMidiIn : public std::enable_shared_from_this<IMidiIn>
 {
@@ -49,6 +65,11 @@ public:
 	virtual bool IsMidiInOpen() const = 0;
 	virtual bool Subscribe(IMidiInSubscriberPtr sub) = 0;
 	virtual void Unsubscribe(IMidiInSubscriberPtr sub) = 0;
+	// call when the MidiInInterest of a subscriber has changed
+	virtual void InterestChanged() = 0;
+	virtual MidiInStats GetMidiInStats() const = 0;
+	// record everything received on the port (set before opening; nullptr to stop)
+	virtual void SetCapture(MidiInCaptureWriterPtr capture, int port) = 0;
 	virtual bool SuspendMidiIn() = 0;
 	virtual bool ResumeMidiIn() = 0;
 	virtual void CloseMidiIn() = 0;
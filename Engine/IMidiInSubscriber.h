@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2010,2018,2021,2025 Sean Echevarria
+ * Copyright (C) 2010,2018,2021,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -26,12 +26,47 @@
 #define IMidiInSubscriber_h__
 
 #include <memory>
+#include <vector>
 
 using byte = unsigned char;
 class IMidiIn;
 
 using IMidiInPtr = std::shared_ptr<IMidiIn>;
 
+// MidiInInterest
+// ----------------------------------------------------------------------------
+// The input a subscriber wants.  The port only delivers matching messages.
+// mStatus is the status byte with the channel bits clear for channel
+// messages (0x80-0xE0) or the whole status byte for system messages
+// (0xF1-0xFF; mChannel and mData1 are ignored).
+// Sysex is matched on leading bytes (including the F0).
+//
+struct MidiInInterest
+{
+	enum { kAny = -1 };
+
+	struct ShortMsg
+	{
+		int		mStatus;
+		int		mChannel = kAny;
+		int		mData1 = kAny;
+	};
+
+	std::vector<ShortMsg>				mShortMsgs;
+	std::vector<std::vector<byte>>		mSysexPrefixes;
+
+	static MidiInInterest Everything()
+	{
+		MidiInInterest all;
+		for (int status = 0x80; status < 0xF0; status += 0x10)
+			all.mShortMsgs.push_back({ status });
+		for (int status = 0xF1; status <= 0xFF; ++status)
+			all.mShortMsgs.push_back({ status });
+		all.mSysexPrefixes.push_back({ 0xF0 });
+		return all;
+	}
+};
+
 // IMidiInSubscriber
 // ----------------------------------------------------------------------------
 // Implement to get notification of MIDI IN events
@@ -44,6 +79,9 @@ public:
 	virtual void ReceivedData(byte b1, byte b2, byte b3) = 0;
 	virtual bool ReceivedSysex(const byte * bytes, int len) = 0;
 	virtual void Closed(IMidiInPtr midIn) = 0;
+	// read when the port builds its routing table (on subscribe, on open
+	// and on IMidiIn::InterestChanged)
+	virtual MidiInInterest GetMidiInInterest() const { return MidiInInterest::Everything(); }
 };
 
 using IMidiInSubscriberPtr = std::shared_ptr<IMidiInSubscriber>;
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2007-2008,2013,2018,2020,2022 Sean Echevarria
+ * Copyright (C) 2007-2008,2013,2018,2020,2022,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -28,12 +28,34 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <span>
+#include "EncodedMidi.h"
 
 using byte = unsigned char;
 using Bytes = std::vector<byte>;
 class ISwitchDisplay;
 
 
+// intervals between clock ticks, compared to the ideal interval at the
+// current tempo (jitter is the absolute difference)
+struct MidiClockStats
+{
+	unsigned int		mTicks = 0;
+	unsigned int		mMeanIntervalUs = 0;
+	unsigned int		mMeanJitterUs = 0;
+	unsigned int		mP99JitterUs = 0;
+	unsigned int		mMaxJitterUs = 0;
+};
+
+// sends dropped by the device shadow state because the device already had
+// the state they would have set
+struct MidiShadowStats
+{
+	unsigned long long	mMessagesSuppressed = 0;
+	unsigned long long	mBytesSuppressed = 0;
+};
+
+
 // IMidiOut
 // ----------------------------------------------------------------------------
 // use to send MIDI
@@ -50,15 +72,38 @@ public:
 	virtual void EnableActivityIndicator(bool enable) = 0;
 	virtual bool OpenMidiOut(unsigned int deviceIdx) = 0;
 	virtual bool IsMidiOutOpen() const = 0;
+	// arbitrary byte string (sysex, or several messages); parsed on each call
 	virtual bool MidiOut(const Bytes & bytes, bool useIndicator = true) = 0;
-	virtual void MidiOut(byte singleByte, bool useIndicator = true) = 0;
-	virtual void MidiOut(byte byte1, byte byte2, bool useIndicator = true) = 0;
-	virtual void MidiOut(byte byte1, byte byte2, byte byte3, bool useIndicator = true) = 0;
+	virtual bool MidiOut(const EncodedMidi & msgs, bool useIndicator = true) = 0;
+	// consecutive sends from one command list; one indicator flash and one
+	// hand-off to the backend
+	virtual bool MidiOutBatch(std::span<const EncodedMidi * const> batch, bool useIndicator = true) = 0;
+	// single channel or system message; no allocation
+	virtual void MidiOut(MidiEvent evt, bool useIndicator = true) = 0;
+	// control change that may be coalesced with a pending send of the same 
+	// channel/controller (latest value wins); for continuous sources like pedals
+	virtual void ControlChangeLatestValue(byte statusByte, byte controller, byte value, bool useIndicator = true) = 0;
+	// as above for a 14-bit control change (controller 0-31, LSB on
+	// controller + 32); the pair is coalesced together
+	virtual void ControlChange14LatestValue(byte statusByte, byte controller, byte msb, byte lsb, bool useIndicator = true) = 0;
+	// opt-in; omit repeated channel status bytes (for slow serial links)
+	virtual void EnableRunningStatus(bool enable) = 0;
+	// output is paced to this many bytes per second (0 for no pacing)
+	virtual void SetBandwidth(unsigned int bytesPerSecond) = 0;
+	// opt-in; control changes and program changes on the channels in the mask
+	// (bit n for channel n), and Axe-Fx III block bypass/channel and scene
+	// sysex if axeFxChannel is not -1, are not sent if the device already
+	// has the state they set (see MidiOutShadow)
+	virtual void EnableShadowState(unsigned int channelMask, int axeFxChannel = -1) = 0;
+	// the device on the channel may have changed state on its own (-1 for all)
+	virtual void ResetShadowState(int channel) = 0;
+	virtual MidiShadowStats GetShadowStats() const = 0;
 
 	virtual void EnableMidiClock(bool enable) = 0;
 	virtual bool IsMidiClockEnabled() = 0;
 	virtual void SetTempo(int bpm) = 0;
 	virtual int GetTempo() const = 0;
+	virtual MidiClockStats GetMidiClockStats() const = 0;
 
 	virtual bool SuspendMidiOut() = 0;
 	virtual bool ResumeMidiOut() = 0;
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2009,2018 Sean Echevarria
+ * Copyright (C) 2009,2018,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -29,6 +29,8 @@
 #include <vector>
 #include <memory>
 
+class IMidiOut;
+class EncodedMidi;
 
 class IPatchCommand
 {
@@ -36,6 +38,16 @@ public:
 	IPatchCommand() = default;
 	virtual ~IPatchCommand() = default;
 	virtual void Exec() = 0;
+	// milliseconds; non-negative only for commands that are a pause in 
+	// the command list (see PatchCommandScheduler)
+	virtual int GetDelayAmount() { return -1; }
+	// for commands whose only effect is sending pre-encoded MIDI, so that
+	// consecutive sends to a port can be batched (see PatchCommandScheduler)
+	virtual const EncodedMidi * GetEncodedMidi(IMidiOut *& midiOut) { return nullptr; }
+	// false for commands that change engine or display state, which is only
+	// done on the thread that runs the engine, so they can't be left to the 
+	// PatchCommandScheduler thread
+	virtual bool IsSchedulable() { return true; }
 };
 
 
@@ -0,0 +1,200 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include <atomic>
+#include <bit>
+#include <format>
+#include "InputLatency.h"
+
+
+// values below kLinearBuckets get a bucket each; above that each power
+// of 2 is split into kSubBuckets buckets
+enum
+{
+	kSubBits = 3,
+	kSubBuckets = 1 << kSubBits,
+	kLinearBuckets = kSubBuckets * 2,
+	kBuckets = kLinearBuckets + (32 - kSubBits - 1) * kSubBuckets
+};
+
+struct StageHistogram
+{
+	std::atomic<unsigned int>			mBuckets[kBuckets];
+	std::atomic<unsigned long long>		mCount;
+	std::atomic<unsigned int>			mMaxUs;
+};
+
+static StageHistogram sStages[InputLatency::stCount];
+static thread_local InputLatency::Clock::time_point tCurrentArrival;
+
+static const char * kStageNames[InputLatency::stCount] = 
+{
+	"driver to callback",
+	"callback to dispatch",
+	"callback to UpdateState",
+	"callback to LED posted",
+	"callback to LED painted"
+};
+
+
+static unsigned int
+BucketFromUs(unsigned int us)
+{
+	if (us < kLinearBuckets)
+		return us;
+
+	const int shift = std::bit_width(us) - 1 - kSubBits;
+	return kLinearBuckets + (shift - 1) * kSubBuckets + ((us >> shift) & (kSubBuckets - 1));
+}
+
+// largest value that falls in the bucket
+static unsigned int
+UsFromBucket(unsigned int bucket)
+{
+	if (bucket < kLinearBuckets)
+		return bucket;
+
+	const unsigned int shift = (bucket - kLinearBuckets) / kSubBuckets + 1;
+	const unsigned long long sub = (bucket - kLinearBuckets) % kSubBuckets;
+	return (unsigned int)(((kSubBuckets + sub + 1) << shift) - 1);
+}
+
+// reports the top of the bucket, but never more than the largest sample
+static unsigned int
+Percentile(const unsigned int (&buckets)[kBuckets],
+		   unsigned long long total,
+		   unsigned int maxUs,
+		   unsigned int pct)
+{
+	const unsigned long long target = (total * pct + 99) / 100;
+	unsigned long long count = 0;
+	for (unsigned int idx = 0; idx < kBuckets; ++idx)
+	{
+		count += buckets[idx];
+		if (count >= target)
+		{
+			const unsigned int us = UsFromBucket(idx);
+			return us < maxUs ? us : maxUs;
+		}
+	}
+
+	return maxUs;
+}
+
+
+InputLatency::ScopedArrival::ScopedArrival(Clock::time_point arrival) :
+	mPrevious(tCurrentArrival)
+{
+	tCurrentArrival = arrival;
+}
+
+InputLatency::ScopedArrival::~ScopedArrival()
+{
+	tCurrentArrival = mPrevious;
+}
+
+InputLatency::Clock::time_point
+InputLatency::CurrentArrival()
+{
+	return tCurrentArrival;
+}
+
+void
+InputLatency::Record(Stage stage,
+					 Clock::duration latency)
+{
+	const long long us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+	// clock granularity can put the driver timestamp after the callback
+	const unsigned int latencyUs = us < 0 ? 0 : us > 0xffffffffLL ? 0xffffffff : (unsigned int)us;
+
+	StageHistogram & hist = sStages[stage];
+	hist.mBuckets[BucketFromUs(latencyUs)].fetch_add(1, std::memory_order_relaxed);
+	if (latencyUs > hist.mMaxUs.load(std::memory_order_relaxed))
+		hist.mMaxUs.store(latencyUs, std::memory_order_relaxed);
+	hist.mCount.fetch_add(1, std::memory_order_release);
+}
+
+void
+InputLatency::RecordSince(Stage stage,
+						  Clock::time_point arrival)
+{
+	if (arrival != Clock::time_point())
+		Record(stage, Clock::now() - arrival);
+}
+
+void
+InputLatency::RecordStage(Stage stage)
+{
+	RecordSince(stage, tCurrentArrival);
+}
+
+unsigned long long
+InputLatency::GetCount(Stage stage)
+{
+	return sStages[stage].mCount.load(std::memory_order_acquire);
+}
+
+std::string
+InputLatency::Report()
+{
+	// values are read individually while input is running; close enough for display
+	std::string report("MIDI input latency (us):\n");
+	for (int stage = 0; stage < stCount; ++stage)
+	{
+		const StageHistogram & hist = sStages[stage];
+		unsigned int buckets[kBuckets];
+		unsigned long long total = 0;
+		for (unsigned int idx = 0; idx < kBuckets; ++idx)
+		{
+			buckets[idx] = hist.mBuckets[idx].load(std::memory_order_relaxed);
+			total += buckets[idx];
+		}
+
+		if (!total)
+		{
+			report += std::format("  {}: no samples\n", kStageNames[stage]);
+			continue;
+		}
+
+		const unsigned int maxUs = hist.mMaxUs.load(std::memory_order_relaxed);
+		report += std::format("  {}: {} samples, p50 {}, p90 {}, p99 {}, max {}\n",
+			kStageNames[stage], total, Percentile(buckets, total, maxUs, 50), 
+			Percentile(buckets, total, maxUs, 90), Percentile(buckets, total, maxUs, 99), maxUs);
+	}
+
+	return report;
+}
+
+void
+InputLatency::Reset()
+{
+	for (StageHistogram & hist : sStages)
+	{
+		for (auto & bucket : hist.mBuckets)
+			bucket.store(0, std::memory_order_relaxed);
+		hist.mCount = 0;
+		hist.mMaxUs = 0;
+	}
+}
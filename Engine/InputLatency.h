@@ -0,0 +1,89 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef InputLatency_h__
+#define InputLatency_h__
+
+#include <chrono>
+#include <string>
+
+
+// InputLatency
+// ----------------------------------------------------------------------------
+// Follows received MIDI from the driver to the switch LEDs it changes.
+// The input dispatch thread marks the arrival time (driver callback) of the
+// event it is handing to subscribers for as long as they run; anything
+// they do on that thread (patch UpdateState, switch display updates)
+// records its stage relative to that time.  Work that continues on
+// another thread (LED paint) carries the arrival time along itself.
+// Each stage keeps a log-linear histogram (1us resolution up to 16us, then
+// 8 buckets per power of 2) so percentiles are within 12.5%.
+// Recording is lock-free and safe from any thread.
+//
+class InputLatency
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	enum Stage
+	{
+		stCallback,			// driver timestamp to driver callback (ms resolution)
+		stDispatch,			// callback to subscriber dispatch
+		stUpdateState,		// callback to patch UpdateState
+		stDisplayPosted,	// callback to switch display update posted to the UI
+		stDisplayPainted,	// callback to switch LED painted
+		stCount
+	};
+
+	// marks the event being dispatched on the current thread
+	class ScopedArrival
+	{
+	public:
+		ScopedArrival(Clock::time_point arrival);
+		~ScopedArrival();
+
+	private:
+		ScopedArrival(const ScopedArrival &) = delete;
+		ScopedArrival & operator=(const ScopedArrival &) = delete;
+
+		Clock::time_point	mPrevious;
+	};
+
+	// arrival time of the event being dispatched on this thread; 
+	// default constructed when not called as a result of MIDI input
+	static Clock::time_point CurrentArrival();
+
+	static void Record(Stage stage, Clock::duration latency);
+	static void RecordSince(Stage stage, Clock::time_point arrival);
+	// records against the current arrival, if any
+	static void RecordStage(Stage stage);
+
+	// per stage count and p50/p90/p99/max, one line each
+	static std::string Report();
+	static unsigned long long GetCount(Stage stage);
+	static void Reset();
+};
+
+#endif // InputLatency_h__
@@ -0,0 +1,167 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include "MidiActivityIndicator.h"
+#include "ISwitchDisplay.h"
+
+
+// an LED shown by one or more indicators
+struct ActivityLed
+{
+	ISwitchDisplay		* mDisplay;
+	int					mSwitchNumber;
+	unsigned int		mLedColor;
+	bool				mLit;
+	bool				mActive;		// during TickAll
+};
+
+static std::mutex sIndicatorsLock;
+static std::vector<MidiActivityIndicator *> sIndicators;
+static std::vector<ActivityLed> sLeds;		// LEDs that have been lit
+static std::atomic<unsigned int> sUpdateCount = 0;
+
+
+static ActivityLed *
+FindLed(ISwitchDisplay * display,
+		int switchNumber)
+{
+	for (ActivityLed & led : sLeds)
+	{
+		if (led.mDisplay == display && led.mSwitchNumber == switchNumber)
+			return &led;
+	}
+
+	return nullptr;
+}
+
+
+MidiActivityIndicator::MidiActivityIndicator()
+{
+	std::lock_guard<std::mutex> lock(sIndicatorsLock);
+	sIndicators.push_back(this);
+}
+
+MidiActivityIndicator::~MidiActivityIndicator()
+{
+	std::lock_guard<std::mutex> lock(sIndicatorsLock);
+	sIndicators.erase(std::remove(sIndicators.begin(), sIndicators.end(), this), sIndicators.end());
+	Detach();
+}
+
+void
+MidiActivityIndicator::SetIndicator(ISwitchDisplay * display,
+									int switchNumber,
+									unsigned int ledColor)
+{
+	std::lock_guard<std::mutex> lock(sIndicatorsLock);
+	mEnabled = false;
+	Detach();
+	mDisplay = display;
+	mSwitchNumber = switchNumber;
+	mLedColor = ledColor;
+	mEnabled = mSwitchNumber > 0 && mDisplay != nullptr;
+}
+
+void
+MidiActivityIndicator::Enable(bool enable)
+{
+	std::lock_guard<std::mutex> lock(sIndicatorsLock);
+	mEnabled = enable && mSwitchNumber > 0 && mDisplay != nullptr;
+	if (!mEnabled)
+		Detach();
+}
+
+void
+MidiActivityIndicator::TickAll()
+{
+	std::lock_guard<std::mutex> lock(sIndicatorsLock);
+	for (ActivityLed & led : sLeds)
+		led.mActive = false;
+
+	// an LED is active if any indicator on it is
+	for (MidiActivityIndicator * cur : sIndicators)
+	{
+		const bool active = cur->mPending.exchange(false, std::memory_order_relaxed);
+		if (!active || !cur->mEnabled)
+			continue;
+
+		ActivityLed * led = FindLed(cur->mDisplay, cur->mSwitchNumber);
+		if (!led)
+			led = &sLeds.emplace_back(ActivityLed{ cur->mDisplay, cur->mSwitchNumber, cur->mLedColor, false, false });
+		else if (led->mActive)
+			continue;
+
+		led->mActive = true;
+		led->mLedColor = cur->mLedColor;
+	}
+
+	// one change per LED per tick
+	for (ActivityLed & led : sLeds)
+	{
+		if (led.mActive == led.mLit)
+			continue;
+
+		if (led.mActive)
+			led.mDisplay->SetSwitchDisplay(led.mSwitchNumber, led.mLedColor);
+		else
+			led.mDisplay->TurnOffSwitchDisplay(led.mSwitchNumber);
+		led.mLit = led.mActive;
+		++sUpdateCount;
+	}
+}
+
+unsigned int
+MidiActivityIndicator::GetUpdateCount()
+{
+	return sUpdateCount;
+}
+
+// Called when this indicator stops showing on its LED.  If no other
+// enabled indicator shows on the LED, it is turned off now (the display
+// may be going away); otherwise the next tick decides.
+void
+MidiActivityIndicator::Detach()
+{
+	mPending = false;
+	ActivityLed * led = FindLed(mDisplay, mSwitchNumber);
+	if (!led)
+		return;
+
+	for (const MidiActivityIndicator * cur : sIndicators)
+	{
+		if (cur != this && cur->mEnabled && cur->mDisplay == mDisplay && cur->mSwitchNumber == mSwitchNumber)
+			return;
+	}
+
+	if (led->mLit)
+	{
+		mDisplay->TurnOffSwitchDisplay(mSwitchNumber);
+		++sUpdateCount;
+	}
+	sLeds.erase(sLeds.begin() + (led - sLeds.data()));
+}
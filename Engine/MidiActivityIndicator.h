@@ -0,0 +1,79 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef MidiActivityIndicator_h__
+#define MidiActivityIndicator_h__
+
+#include <atomic>
+
+class ISwitchDisplay;
+
+
+// MidiActivityIndicator
+// ----------------------------------------------------------------------------
+// Sampled activity LED for a MIDI port.
+// Activity() only sets a flag, so it is cheap to call for every message on
+// any thread.  TickAll() is called by the UI kTicksPerSecond times a second;
+// each tick turns the LED on if there was activity since the last tick and
+// off if there wasn't, so an LED changes at most kTicksPerSecond times a
+// second regardless of message rate.
+// Ports can share an LED; it is lit if any of them had activity.
+//
+class MidiActivityIndicator
+{
+public:
+	MidiActivityIndicator();
+	~MidiActivityIndicator();
+
+	enum { kTicksPerSecond = 10 };
+
+	void SetIndicator(ISwitchDisplay * display, int switchNumber, unsigned int ledColor);
+	void Enable(bool enable);
+	void Activity()
+	{
+		if (mEnabled.load(std::memory_order_relaxed))
+			mPending.store(true, std::memory_order_relaxed);
+	}
+
+	static void TickAll();
+	// number of LED on/off changes made by all indicators
+	static unsigned int GetUpdateCount();
+
+private:
+	MidiActivityIndicator(const MidiActivityIndicator &) = delete;
+	MidiActivityIndicator & operator=(const MidiActivityIndicator &) = delete;
+
+	void Detach();
+
+	// changed and read with the registry lock held
+	ISwitchDisplay		* mDisplay = nullptr;
+	int					mSwitchNumber = 0;
+	unsigned int		mLedColor = 0;
+
+	std::atomic_bool	mEnabled = false;
+	std::atomic_bool	mPending = false;
+};
+
+#endif // MidiActivityIndicator_h__
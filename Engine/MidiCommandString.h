@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2009,2018,2025 Sean Echevarria
+ * Copyright (C) 2009,2018,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -33,38 +33,41 @@ class MidiCommandString : public IPatchCommand
 {
 public:
 	MidiCommandString(IMidiOutPtr midiOut, 
-					  Bytes midiString) :
-		mMidiOut(midiOut)
+					  const Bytes & midiString) :
+		mMidiOut(midiOut),
+		mCommandString(midiString)
+	{
+	}
+
+	MidiCommandString(IMidiOutPtr midiOut, 
+					  EncodedMidi && midiString) :
+		mMidiOut(midiOut),
+		mCommandString(std::move(midiString))
 	{
-		mCommandString.swap(midiString);
 	}
 
 	virtual void Exec() override
 	{
-		if (!mMidiOut)
+		if (!mMidiOut || mCommandString.Empty())
 			return;
 
-		switch (mCommandString.size())
-		{
-		case 3:
-			mMidiOut->MidiOut(mCommandString[0], mCommandString[1], mCommandString[2]);
-			break;
-		case 2:
-			mMidiOut->MidiOut(mCommandString[0], mCommandString[1]);
-			break;
-		case 0:
-			break;
-		default:
-			mMidiOut->MidiOut(mCommandString);
-		}
+		mMidiOut->MidiOut(mCommandString);
 	}
 
+	virtual const EncodedMidi * GetEncodedMidi(IMidiOut *& midiOut) override
+	{
+		midiOut = mMidiOut.get();
+		return &mCommandString;
+	}
+
+	void SetStateful(bool stateful) { mCommandString.SetStateful(stateful); }
+
 private:
 	MidiCommandString();
 
 private:
 	IMidiOutPtr	mMidiOut;
-	Bytes	mCommandString;
+	EncodedMidi	mCommandString;
 };
 
 #endif // MidiCommandString_h__
@@ -42,6 +42,7 @@
 #include "MetaPatch_SyncAxeFx.h"
 #include "MetaPatch_AxeFxNav.h"
 #include "DynamicMidiCommand.h"
+#include "PatchCommandScheduler.h"
 #include "TwoStatePatch.h"
 #include "CrossPlatform.h"
 
@@ -340,6 +341,7 @@ MidiControlEngine::CompleteInit(const PedalCalibration * pedalCalibrationSetting
 void
 MidiControlEngine::Shutdown()
 {
+	PatchCommandScheduler::Release();
 	gActivePatchPedals = nullptr;
 	DynamicMidiCommand::ReleaseDynamicData();
 	for (const auto& mgr : mAxeMgrs)
@@ -356,6 +358,7 @@ MidiControlEngine::Shutdown()
 	mPatches.clear();
 	mPatchGroups.clear();
 	mMidiOut = nullptr;
+	mShadowedMidiOuts.clear();
 }
 
 void
@@ -763,7 +766,7 @@ MidiControlEngine::LoadBank(int bankIndex)
 		return false;
 
 	if (mActiveBank)
-		mActiveBank->Unload(mMainDisplay, mSwitchDisplay);
+		mActiveBank->Unload(mMainDisplay, mSwitchDisplay, bank.get());
 
 	mActiveBank = bank;
 
@@ -1218,11 +1221,11 @@ MidiControlEngine::ChangeMode(EngineMode newMode)
 					// clock mode: 
 					// 	1 		2 		3 		4 		5
 					// 	6		7		8		9		0
-					// 	Commit	Toggle	(tap)	Decr	Incr
+					// 	Stats	Toggle	Commit	Decr	Incr
 					mSwitchDisplay->SetSwitchText(mIncrementSwitchNumber, "Clear");
 					mSwitchDisplay->ForceSwitchDisplay(mIncrementSwitchNumber, mEngineLedColor);
-					mSwitchDisplay->SetSwitchText(10, "");
-					// mSwitchDisplay->ForceSwitchDisplay(10, mEngineLedColor);
+					mSwitchDisplay->SetSwitchText(10, "Clock timing stats");
+					mSwitchDisplay->ForceSwitchDisplay(10, mEngineLedColor);
 					mSwitchDisplay->SetSwitchText(11, "Toggle clock on/off");
 					mSwitchDisplay->ForceSwitchDisplay(11, mEngineLedColor);
 					mSwitchDisplay->SetSwitchText(12, "Set tempo");
@@ -2094,6 +2097,19 @@ MidiControlEngine::IsMidiClockEnabled() const
 	return false;
 }
 
+MidiShadowStats
+MidiControlEngine::GetMidiShadowStats() const
+{
+	MidiShadowStats stats;
+	for (const IMidiOutPtr & midiOut : mShadowedMidiOuts)
+	{
+		const MidiShadowStats portStats(midiOut->GetShadowStats());
+		stats.mMessagesSuppressed += portStats.mMessagesSuppressed;
+		stats.mBytesSuppressed += portStats.mBytesSuppressed;
+	}
+	return stats;
+}
+
 void
 MidiControlEngine::SwitchPressed_ClockSetup(int switchNumber)
 {
@@ -2114,6 +2130,21 @@ MidiControlEngine::SwitchPressed_ClockSetup(int switchNumber)
 	case 8:		mDirectNumber += "9";	break;
 	case 9:		mDirectNumber += "0";	break;
 	case 10:
+		// clock timing stats
+		if (mMidiOut && mMainDisplay)
+		{
+			if (IsMidiClockEnabled())
+			{
+				const MidiClockStats stats(mMidiOut->GetMidiClockStats());
+				msg = std::format("MIDI clock {} BPM, {} ticks\r\ninterval avg {} us (ideal {} us)\r\njitter avg {} us, p99 {} us, max {} us",
+					mMidiOut->GetTempo(), stats.mTicks, stats.mMeanIntervalUs, 2500000 / mMidiOut->GetTempo(),
+					stats.mMeanJitterUs, stats.mP99JitterUs, stats.mMaxJitterUs);
+			}
+			else
+				msg = "MIDI clock disabled";
+
+			mMainDisplay->TextOut(msg);
+		}
 		return;
 	case 11:
 		// toggle clock on/off
@@ -2353,7 +2384,7 @@ MidiControlEngine::ReleaseProgramChangePatchForChannel(int channel,
 }
 
 void
-MidiControlEngine::CheckForDeviceProgramChange(PatchPtr patch,
+MidiControlEngine::CheckForDeviceProgramChange(const PatchPtr & patch,
 	ISwitchDisplay * switchDisplay,
 	IMainDisplay * mainDisplay)
 {
@@ -35,6 +35,7 @@
 #include "ExpressionPedals.h"
 #include "../Monome40h/IMonome40hInputSubscriber.h"
 #include "IAxeFx.h"
+#include "IMidiOut.h"
 #include "EngineLoader.h"
 #include "EdpManager.h"
 
@@ -112,6 +113,9 @@ public:
 	PatchPtr				GetPatch(int number);
 	int						GetPatchNumber(const std::string & name) const;
 	ISwitchDisplay *		GetSwitchDisplay() const { return mSwitchDisplay; }
+	using Banks = std::vector<PatchBankPtr>;
+	const Banks &			GetBanksInNavOrder() const { return mBanksInNavOrder; } // for tools and benchmarks
+	int						GetModeSwitchNumber() const { return mModeSwitchNumber; }
 	bool					IsBankActive(PatchBank * bnk) const { return mActiveBank.get() == bnk; }
 
 	void					SwitchPressed(int switchNumber);
@@ -120,7 +124,7 @@ public:
 	void					DeactivateVolatilePatches(IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay);
 	void					DeactivateRestOfPatchGroup(const std::string &groupId, TwoStatePatch * activePatch, IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay);
 	void					ReleaseProgramChangePatchForChannel(int channel, ISwitchDisplay * switchDisplay, IMainDisplay * mainDisplay);
-	void					CheckForDeviceProgramChange(PatchPtr patch, ISwitchDisplay * switchDisplay, IMainDisplay * mainDisplay);
+	void					CheckForDeviceProgramChange(const PatchPtr & patch, ISwitchDisplay * switchDisplay, IMainDisplay * mainDisplay);
 	virtual void			AdcValueChanged(int port, int curValue) override;
 	void					RefirePedal(int pedal);
 	void					ResetBankPatches();
@@ -142,6 +146,11 @@ public:
 	void					EnableMidiClock(bool enable);
 	bool					IsMidiClockEnabled() const;
 
+	// ports with device shadow state (see IMidiOut::EnableShadowState)
+	void					AddShadowedMidiOut(IMidiOutPtr midiOut) { mShadowedMidiOuts.push_back(midiOut); }
+	// totals for all shadowed ports since they were opened
+	MidiShadowStats			GetMidiShadowStats() const;
+
 private:
 	void					SetBankNavOrder(std::vector<std::string> &setorder);
 	void					LoadStartupBank();
@@ -197,6 +206,7 @@ private:
 	ISwitchDisplay *		mSwitchDisplay = nullptr;
 	IMidiOutGenerator *		mMidiOutGenerator = nullptr;
 	IMidiOutPtr				mMidiOut; // only used for emProgramChangeDirect / emControlChangeDirect / emClockSetup
+	std::vector<IMidiOutPtr> mShadowedMidiOuts;
 	std::vector<IAxeFxPtr>	mAxeMgrs;
 	EdpManagerPtr			mEdpMgr;
 	using ListenerMap = std::map<int, ControllerInputMonitorPtr>;
@@ -222,7 +232,6 @@ private:
 
 	// retained in different form
 	Patches					mPatches;		// patchNum is key
-	using Banks = std::vector<PatchBankPtr>;
 	Banks					mBanks;			// compressed; bankNum is not index; used during init and as backing store
 	Banks					mBanksInNavOrder; // used at runtime -- could be identical to mBanks
 	std::map<std::string, std::vector<TwoStatePatch*>> mPatchGroups;
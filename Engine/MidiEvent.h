@@ -0,0 +1,78 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef MidiEvent_h__
+#define MidiEvent_h__
+
+#include <type_traits>
+
+using byte = unsigned char;
+
+
+// MidiEvent
+// ----------------------------------------------------------------------------
+// A complete channel or system (non-sysex) message packed into 32 bits as
+// status | data1 << 8 | data2 << 16 (same layout as midiOutShortMsg).
+// Trivially copyable so that it can be passed by value, stored in command
+// objects and queued without touching the heap.  Sysex stays in Bytes.
+//
+class MidiEvent
+{
+public:
+	constexpr MidiEvent() = default;
+	constexpr explicit MidiEvent(unsigned int shortMsg) : mShortMsg(shortMsg) { }
+	constexpr MidiEvent(byte status, byte data1, byte data2 = 0) :
+		mShortMsg(status | (data1 << 8) | (data2 << 16)) { }
+
+	constexpr unsigned int GetShortMsg() const { return mShortMsg; }
+	constexpr bool IsValid() const { return (mShortMsg & 0x80) && GetStatus() != 0xF0; }
+
+	constexpr byte GetStatus() const { return (byte)(mShortMsg & 0xff); }
+	constexpr byte GetData1() const { return (byte)((mShortMsg >> 8) & 0xff); }
+	constexpr byte GetData2() const { return (byte)((mShortMsg >> 16) & 0xff); }
+
+	// 0x80 - 0xE0 for channel messages, otherwise the full status byte
+	constexpr byte GetCommand() const { return GetStatus() < 0xF0 ? (byte)(GetStatus() & 0xF0) : GetStatus(); }
+	constexpr bool IsChannelMessage() const { return GetStatus() >= 0x80 && GetStatus() < 0xF0; }
+	constexpr byte GetChannel() const { return (byte)(mShortMsg & 0x0F); }
+
+	// ORs channel into the status of a channel message
+	constexpr void AddChannel(byte channel)
+	{
+		if (IsChannelMessage())
+			mShortMsg |= channel & 0x0F;
+	}
+
+	constexpr void SetData2(byte data2) { mShortMsg = (mShortMsg & 0xff00ffff) | (data2 << 16); }
+
+	constexpr bool operator==(const MidiEvent & rhs) const = default;
+
+private:
+	unsigned int	mShortMsg = 0;
+};
+
+static_assert(sizeof(MidiEvent) == 4 && std::is_trivially_copyable_v<MidiEvent>);
+
+#endif // MidiEvent_h__
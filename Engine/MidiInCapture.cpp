@@ -0,0 +1,262 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include "MidiInCapture.h"
+#include <cstring>
+#include "CrossPlatform.h"
+#include "EncodedMidi.h"
+
+
+static const char kSignature[8] = { 'm', 'T', 'r', 'l', 'C', 'a', 'p', '1' };
+
+// writes are buffered and flushed at this size
+constexpr size_t kWriteBufferSize = 64 * 1024;
+
+static FILE *
+OpenFile(const std::string & filename, 
+		 const char * mode)
+{
+#ifdef _MSC_VER
+	FILE * file = nullptr;
+	if (::fopen_s(&file, filename.c_str(), mode))
+		return nullptr;
+	return file;
+#else
+	return ::fopen(filename.c_str(), mode);
+#endif
+}
+
+
+MidiInCaptureWriter::~MidiInCaptureWriter()
+{
+	Close();
+}
+
+bool
+MidiInCaptureWriter::Open(const std::string & filename)
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	_ASSERTE(!mFile);
+	mFile = OpenFile(filename, "wb");
+	if (!mFile)
+		return false;
+
+	::fwrite(kSignature, sizeof(kSignature), 1, mFile);
+	mFirstRecord = true;
+	mRecords = 0;
+	mBuffer.clear();
+	mBuffer.reserve(kWriteBufferSize + 1024);
+	return true;
+}
+
+void
+MidiInCaptureWriter::Close()
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	if (!mFile)
+		return;
+
+	if (!mBuffer.empty())
+		::fwrite(mBuffer.data(), mBuffer.size(), 1, mFile);
+	::fclose(mFile);
+	mFile = nullptr;
+	mBuffer.clear();
+}
+
+void
+MidiInCaptureWriter::RecordData(int port, 
+								Clock::time_point received, 
+								unsigned int shortMsg)
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	if (!mFile)
+		return;
+
+	WriteHeader(port, received);
+	const byte status = (byte)(shortMsg & 0xff);
+	mBuffer.push_back(status);
+	const int dataBytes = EncodedMidi::GetDataByteCount(status);
+	for (int idx = 1; idx <= dataBytes; ++idx)
+		mBuffer.push_back((byte)((shortMsg >> (8 * idx)) & 0x7f));
+
+	if (mBuffer.size() >= kWriteBufferSize)
+	{
+		::fwrite(mBuffer.data(), mBuffer.size(), 1, mFile);
+		mBuffer.clear();
+	}
+}
+
+void
+MidiInCaptureWriter::RecordSysex(int port, 
+								 Clock::time_point received, 
+								 std::span<const byte> msg)
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	if (!mFile || msg.size() < 2 || msg[0] != 0xF0)
+		return;
+
+	WriteHeader(port, received);
+	mBuffer.push_back(0xF0);
+	WriteVarint(msg.size() - 1);
+	if (mBuffer.size() + msg.size() >= kWriteBufferSize)
+	{
+		::fwrite(mBuffer.data(), mBuffer.size(), 1, mFile);
+		mBuffer.clear();
+		::fwrite(msg.data() + 1, msg.size() - 1, 1, mFile);
+		return;
+	}
+
+	mBuffer.insert(mBuffer.end(), msg.begin() + 1, msg.end());
+}
+
+void
+MidiInCaptureWriter::WriteHeader(int port, 
+								 Clock::time_point received)
+{
+	if (mFirstRecord)
+	{
+		mPrevTime = received;
+		mFirstRecord = false;
+	}
+
+	// events from different ports are recorded by different threads, so
+	// they can show up slightly out of order
+	unsigned long long deltaUs = 0;
+	if (received > mPrevTime)
+	{
+		deltaUs = std::chrono::duration_cast<std::chrono::microseconds>(received - mPrevTime).count();
+		mPrevTime += std::chrono::microseconds(deltaUs);
+	}
+
+	WriteVarint(deltaUs);
+	WriteVarint(port < 0 ? 0 : (unsigned int)port);
+	++mRecords;
+}
+
+void
+MidiInCaptureWriter::WriteVarint(unsigned long long val)
+{
+	// 7 bits per byte, low bits first; high bit set on all but the last byte
+	while (val >= 0x80)
+	{
+		mBuffer.push_back((byte)(val | 0x80));
+		val >>= 7;
+	}
+	mBuffer.push_back((byte)val);
+}
+
+
+static bool
+ReadVarint(const std::vector<byte> & data, 
+		   size_t & pos, 
+		   unsigned long long & val)
+{
+	val = 0;
+	for (int shift = 0; pos < data.size() && shift < 64; shift += 7)
+	{
+		const byte cur = data[pos++];
+		val |= (unsigned long long)(cur & 0x7f) << shift;
+		if (!(cur & 0x80))
+			return true;
+	}
+
+	return false;
+}
+
+bool
+MidiInCaptureReader::Load(const std::string & filename, 
+						  std::string & errMsg)
+{
+	mEvents.clear();
+	mSysexData.clear();
+
+	FILE * file = OpenFile(filename, "rb");
+	if (!file)
+	{
+		errMsg = "failed to open " + filename;
+		return false;
+	}
+
+	std::vector<byte> data;
+	byte buf[64 * 1024];
+	size_t bytesRead;
+	while ((bytesRead = ::fread(buf, 1, sizeof(buf), file)) > 0)
+		data.insert(data.end(), buf, buf + bytesRead);
+	::fclose(file);
+
+	if (data.size() < sizeof(kSignature) || ::memcmp(data.data(), kSignature, sizeof(kSignature)))
+	{
+		errMsg = filename + " is not a MIDI input capture";
+		return false;
+	}
+
+	size_t pos = sizeof(kSignature);
+	unsigned long long timeUs = 0;
+	while (pos < data.size())
+	{
+		unsigned long long deltaUs, port;
+		if (!ReadVarint(data, pos, deltaUs) || !ReadVarint(data, pos, port) || pos >= data.size())
+		{
+			errMsg = "capture is truncated";
+			return false;
+		}
+
+		timeUs += deltaUs;
+		Event evt{ timeUs, (int)port, 0, 0, 0 };
+		const byte status = data[pos++];
+		if (0xF0 == status)
+		{
+			unsigned long long len;
+			if (!ReadVarint(data, pos, len) || len > data.size() - pos)
+			{
+				errMsg = "capture is truncated";
+				return false;
+			}
+
+			evt.mSysexOffset = mSysexData.size();
+			evt.mSysexLen = (size_t)len + 1;
+			mSysexData.push_back(0xF0);
+			mSysexData.insert(mSysexData.end(), data.begin() + pos, data.begin() + pos + (size_t)len);
+			pos += (size_t)len;
+		}
+		else
+		{
+			const int dataBytes = EncodedMidi::GetDataByteCount(status);
+			if (dataBytes < 0 || pos + dataBytes > data.size())
+			{
+				errMsg = "capture is corrupt";
+				return false;
+			}
+
+			evt.mShortMsg = status;
+			for (int idx = 1; idx <= dataBytes; ++idx)
+				evt.mShortMsg |= (unsigned int)data[pos++] << (8 * idx);
+		}
+
+		mEvents.push_back(evt);
+	}
+
+	return true;
+}
@@ -0,0 +1,120 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef MidiInCapture_h__
+#define MidiInCapture_h__
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+using byte = unsigned char;
+
+
+// MidiInCaptureWriter
+// ----------------------------------------------------------------------------
+// Records MIDI input from any number of ports to a compact binary file,
+// with microsecond timestamps, for replay by MidiInCaptureReader.
+// Thread safe; each port records from its own dispatch thread.
+//
+// File format: the 8 byte signature "mTrlCap1" followed by records of
+//   varint	microseconds since the previous record
+//   varint	port
+//   bytes	the message: a short message is its status byte and the data
+//			bytes implied by it; sysex is F0, a varint count of the bytes
+//			that follow the F0 (through the F7), then those bytes
+//
+class MidiInCaptureWriter
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	MidiInCaptureWriter() = default;
+	~MidiInCaptureWriter();
+
+	bool Open(const std::string & filename);
+	void Close();
+	bool IsOpen() const { return mFile != nullptr; }
+
+	void RecordData(int port, Clock::time_point received, unsigned int shortMsg);
+	void RecordSysex(int port, Clock::time_point received, std::span<const byte> msg);
+
+	unsigned long long GetRecordCount() const { return mRecords; }
+
+private:
+	MidiInCaptureWriter(const MidiInCaptureWriter &) = delete;
+	MidiInCaptureWriter & operator=(const MidiInCaptureWriter &) = delete;
+
+	void WriteHeader(int port, Clock::time_point received);
+	void WriteVarint(unsigned long long val);
+
+	std::mutex					mLock;
+	FILE						* mFile = nullptr;
+	Clock::time_point			mPrevTime;
+	bool						mFirstRecord = true;
+	unsigned long long			mRecords = 0;
+	std::vector<byte>			mBuffer;
+};
+
+using MidiInCaptureWriterPtr = std::shared_ptr<MidiInCaptureWriter>;
+
+
+// MidiInCaptureReader
+// ----------------------------------------------------------------------------
+// Loads a capture written by MidiInCaptureWriter.  Sysex data of all
+// records is kept in one buffer.
+//
+class MidiInCaptureReader
+{
+public:
+	struct Event
+	{
+		unsigned long long	mTimeUs;		// since the first event
+		int					mPort;
+		unsigned int		mShortMsg;		// status in the low byte; 0 for sysex
+		size_t				mSysexOffset;
+		size_t				mSysexLen;
+
+		bool IsSysex() const { return mSysexLen != 0; }
+	};
+
+	bool Load(const std::string & filename, std::string & errMsg);
+
+	const std::vector<Event> & GetEvents() const { return mEvents; }
+	std::span<const byte> GetSysex(const Event & evt) const
+	{
+		return std::span<const byte>(mSysexData.data() + evt.mSysexOffset, evt.mSysexLen);
+	}
+
+private:
+	std::vector<Event>			mEvents;
+	std::vector<byte>			mSysexData;
+};
+
+#endif // MidiInCapture_h__
@@ -29,6 +29,7 @@
 #include "IMainDisplay.h"
 #include "ISwitchDisplay.h"
 #include "ITraceDisplay.h"
+#include "InputLatency.h"
 
 
 ExpressionPedals * gActivePatchPedals = nullptr;
@@ -192,6 +193,7 @@ Patch::ActivateSwitchDisplay(ISwitchDisplay * switchDisplay,
 void
 Patch::UpdateState(ISwitchDisplay * switchDisplay, bool active)
 {
+	InputLatency::RecordStage(InputLatency::stUpdateState);
 	if (mPatchIsActive == active)
 	{
 		if (!mPatchSupportsDisabledState)
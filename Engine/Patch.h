@@ -80,6 +80,12 @@ public:
 
 	virtual void BankTransitionActivation() = 0;
 	virtual void BankTransitionDeactivation() = 0;
+	// true if the bank transitions do nothing more than put the patch in the
+	// active or inactive state, so that a transition to the state the patch
+	// is already in can be skipped
+	virtual bool IsBankTransitionStateful() const { return false; }
+	// called in place of a skipped BankTransitionActivation
+	virtual void BankTransitionActivationSkipped() { }
 
 protected:
 	Patch(int number, const std::string & name, IMidiOutPtr midiOut = nullptr);
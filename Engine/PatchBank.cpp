@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2007-2008,2010-2016,2018,2021,2024-2025 Sean Echevarria
+ * Copyright (C) 2007-2008,2010-2016,2018,2021,2024-2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -163,6 +163,8 @@ PatchBank::SetDefaultMappings(const PatchBankPtr defaultMapping)
 				curPatches.push_back(std::make_shared<BankPatchState>(*curItem));
 		}
 	}
+
+	CompileSwitchTable();
 }
 
 void
@@ -209,114 +211,193 @@ PatchBank::InitPatches(const MidiControlEngine::Patches & enginePatches,
 			}
 		}
 	}
+
+	CompileSwitchTable();
 }
 
 void
-PatchBank::CalibrateExprSettings(const PedalCalibration * pedalCalibration, ITraceDisplay * traceDisp)
+PatchBank::CompileSwitchTable()
 {
+	mSwitchTable.clear();
+	mSwitchPatches.clear();
+	mGroupSwitches.clear();
+
+	int maxSwitchNumber = -1;
+	for (const auto & curPatch : mPatches)
+		maxSwitchNumber = std::max(maxSwitchNumber, curPatch.first);
+	for (const auto & curGroup : mGroupFromSwitch)
+		maxSwitchNumber = std::max(maxSwitchNumber, curGroup.first);
+	if (maxSwitchNumber < 0)
+		return;
+
+	mSwitchTable.resize(maxSwitchNumber + 1);
 	for (auto & curPatch : mPatches)
 	{
+		if (curPatch.first < 0)
+			continue;
+
+		SwitchEntry & entry = mSwitchTable[curPatch.first];
+		entry.mSfOp = curPatch.second.mSfOp;
 		for (int idx = ssPrimary; idx < ssCount; ++idx)
 		{
 			SwitchFunctionAssignment ss = static_cast<SwitchFunctionAssignment>(idx);
-			PatchVect & patches = curPatch.second.GetPatchVect(ss);
-			for (const BankPatchStatePtr& curItem : patches)
+			entry.mFirstPatch[idx] = (unsigned int)mSwitchPatches.size();
+			for (const BankPatchStatePtr& curItem : curPatch.second.GetPatchVect(ss))
 			{
-				if (curItem && curItem->mPatch)
-				{
-					ExpressionPedals & pedals = curItem->mPatch->GetPedals();
-					pedals.Calibrate(pedalCalibration, mEngine.get(), traceDisp);
-				}
+				if (!curItem || !curItem->mPatch)
+					continue;
+
+				mSwitchPatches.push_back({ curItem->mPatch.get(), curItem.get(), curItem->mPatchStateOverride, curItem->mPatchSyncState });
+			}
+			entry.mPatchCount[idx] = (unsigned int)mSwitchPatches.size() - entry.mFirstPatch[idx];
+		}
+	}
+
+	for (const auto & curGroup : mGroupFromSwitch)
+	{
+		if (curGroup.first < 0 || !curGroup.second)
+			continue;
+
+		SwitchEntry & entry = mSwitchTable[curGroup.first];
+		entry.mFirstGroupSwitch = (unsigned int)mGroupSwitches.size();
+		mGroupSwitches.insert(mGroupSwitches.end(), curGroup.second->begin(), curGroup.second->end());
+		entry.mGroupSwitchCount = (unsigned int)mGroupSwitches.size() - entry.mFirstGroupSwitch;
+	}
+
+	// transitions in the order that Load and Unload used to walk the switches
+	mLoadPlan.clear();
+	mUnloadPlan.clear();
+	mLoadPlanPatches.clear();
+	for (const SwitchEntry & entry : mSwitchTable)
+	{
+		for (int idx = ssPrimary; idx < ssCount; ++idx)
+		{
+			SwitchFunctionAssignment ss = static_cast<SwitchFunctionAssignment>(idx);
+			const SwitchPatches patches(GetSwitchPatches(entry, ss));
+			for (size_t pos = 0; pos < patches.size(); ++pos)
+			{
+				const SwitchPatch & curItem = patches[pos];
+				if (stIgnore != curItem.mState->mPatchStateAtBankLoad)
+					mLoadPlan.push_back({ curItem.mPatch, curItem.mState, curItem.mState->mPatchStateAtBankLoad, ssPrimary == ss && pos > 0 });
+				if (stIgnore != curItem.mState->mPatchStateAtBankUnload)
+					mUnloadPlan.push_back({ curItem.mPatch, curItem.mState, curItem.mState->mPatchStateAtBankUnload, pos > 0 });
 			}
 		}
 	}
+
+	for (const BankTransition & curItem : mLoadPlan)
+		mLoadPlanPatches.push_back(curItem.mPatch);
+	std::sort(mLoadPlanPatches.begin(), mLoadPlanPatches.end());
+	mLoadPlanPatches.erase(std::unique(mLoadPlanPatches.begin(), mLoadPlanPatches.end()), mLoadPlanPatches.end());
+}
+
+bool
+PatchBank::SwitchHasSecondaryLogic(int switchNumber) const
+{
+	return GetSwitchEntry(switchNumber).mSfOp != sfoNone;
 }
 
 void
-PatchBank::Load(IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay)
+PatchBank::CalibrateExprSettings(const PedalCalibration * pedalCalibration, ITraceDisplay * traceDisp)
 {
-	mLoaded = true;
 	for (auto & curPatch : mPatches)
 	{
 		for (int idx = ssPrimary; idx < ssCount; ++idx)
 		{
-			bool once = true;
 			SwitchFunctionAssignment ss = static_cast<SwitchFunctionAssignment>(idx);
 			PatchVect & patches = curPatch.second.GetPatchVect(ss);
 			for (const BankPatchStatePtr& curItem : patches)
 			{
-				if (!curItem || !curItem->mPatch)
-					continue;
-
-				if (!once)
-					curItem->mPatch->OverridePedals(true); // expression pedals only apply to first patch
-
-				if (stA == curItem->mPatchStateAtBankLoad)
-				{
-					curItem->mPatch->BankTransitionActivation();
-					mEngine->CheckForDeviceProgramChange(curItem.get()->mPatch, switchDisplay, mainDisplay);
-				}
-				else if (stB == curItem->mPatchStateAtBankLoad)
-					curItem->mPatch->BankTransitionDeactivation();
-
-				// only assign a switch to the first patch (if multiple 
-				// patches are assigned to the same switch)
-				if (once && ssPrimary == ss)
+				if (curItem && curItem->mPatch)
 				{
-					once = false;
-					curItem->mPatch->AssignSwitch(curPatch.first, switchDisplay);
-					if (curItem->mOverrideSwitchName.length() && switchDisplay)
-						switchDisplay->SetSwitchText(curPatch.first, curItem->mOverrideSwitchName);
+					ExpressionPedals & pedals = curItem->mPatch->GetPedals();
+					pedals.Calibrate(pedalCalibration, mEngine.get(), traceDisp);
 				}
-				else
-					curItem->mPatch->OverridePedals(false);
-// 				else
-// 					curItem->mPatch->AssignSwitch(-1, NULL);
 			}
 		}
 	}
+}
 
+void
+PatchBank::Load(IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay)
+{
+	mLoaded = true;
+	ExecTransitions(mLoadPlan, nullptr, mainDisplay, switchDisplay);
+	AssignSwitches(switchDisplay);
 	DisplayInfo(mainDisplay, switchDisplay, true, false);
 }
 
+// nextBank is the bank about to be loaded, if any; unload transitions of
+// patches that its load plan also moves are left to its load
 void
-PatchBank::Unload(IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay)
+PatchBank::Unload(IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay, const PatchBank * nextBank)
 {
 	mLoaded = false;
-	for (auto & curPatch : mPatches)
-	{
-		for (int idx = ssPrimary; idx < ssCount; ++idx)
-		{
-			bool once = true;
-			SwitchFunctionAssignment ss = static_cast<SwitchFunctionAssignment>(idx);
-			PatchVect & patches = curPatch.second.GetPatchVect(ss);
-			for (const BankPatchStatePtr& curItem : patches)
-			{
-				if (!curItem || !curItem->mPatch)
-					continue;
+	ExecTransitions(mUnloadPlan, nextBank, mainDisplay, switchDisplay);
 
-				if (!once)
-					curItem->mPatch->OverridePedals(true);
+	for (const SwitchPatch & curItem : mSwitchPatches)
+		curItem.mPatch->ClearSwitch(switchDisplay);
 
-				if (stA == curItem->mPatchStateAtBankUnload)
-				{
-					curItem->mPatch->BankTransitionActivation();
-					mEngine->CheckForDeviceProgramChange(curItem.get()->mPatch, switchDisplay, mainDisplay);
-				}
-				else if (stB == curItem->mPatchStateAtBankUnload)
-					curItem->mPatch->BankTransitionDeactivation();
+//	mainDisplay->ClearDisplay();
+}
 
-				if (once)
-					once = false;
-				else
-					curItem->mPatch->OverridePedals(false);
+// Runs the transitions of a plan that change something: stateful patches
+// that are already in the target state are skipped (patches are shared
+// across banks, so they often are).
+void
+PatchBank::ExecTransitions(const BankTransitions & plan, 
+						   const PatchBank * nextBank, 
+						   IMainDisplay * mainDisplay, 
+						   ISwitchDisplay * switchDisplay)
+{
+	for (const BankTransition & curItem : plan)
+	{
+		Patch * patch = curItem.mPatch;
+		const bool kStateful = patch->IsBankTransitionStateful();
+		if (kStateful && nextBank && nextBank->IsLoadTransitionTarget(patch))
+			continue;
 
-				curItem->mPatch->ClearSwitch(switchDisplay);
-			}
+		if (curItem.mOverridePedals)
+			patch->OverridePedals(true); // expression pedals only apply to first patch
+
+		if (stA == curItem.mTargetState)
+		{
+			if (kStateful && patch->IsActive())
+				patch->BankTransitionActivationSkipped();
+			else
+				patch->BankTransitionActivation();
+			mEngine->CheckForDeviceProgramChange(curItem.mState->mPatch, switchDisplay, mainDisplay);
 		}
+		else if (!kStateful || patch->IsActive())
+			patch->BankTransitionDeactivation();
+
+		if (curItem.mOverridePedals)
+			patch->OverridePedals(false);
 	}
+}
 
-//	mainDisplay->ClearDisplay();
+bool
+PatchBank::IsLoadTransitionTarget(const Patch * patch) const
+{
+	return std::binary_search(mLoadPlanPatches.begin(), mLoadPlanPatches.end(), patch);
+}
+
+void
+PatchBank::AssignSwitches(ISwitchDisplay * switchDisplay)
+{
+	for (int switchNumber = 0; switchNumber < (int)mSwitchTable.size(); ++switchNumber)
+	{
+		// only assign a switch to the first patch (if multiple 
+		// patches are assigned to the same switch)
+		const SwitchPatches patches(GetSwitchPatches(mSwitchTable[switchNumber], ssPrimary));
+		if (patches.empty())
+			continue;
+
+		const SwitchPatch & curItem = patches.front();
+		curItem.mPatch->AssignSwitch(switchNumber, switchDisplay);
+		if (curItem.mState->mOverrideSwitchName.length() && switchDisplay)
+			switchDisplay->SetSwitchText(switchNumber, curItem.mState->mOverrideSwitchName);
+	}
 }
 
 void
@@ -326,30 +407,7 @@ PatchBank::ReengageSwitchesWithoutLoad(ISwitchDisplay * switchDisplay)
 	if (!mLoaded)
 		return;
 
-	for (auto & curPatch : mPatches)
-	{
-		for (int idx = ssPrimary; idx < ssCount; ++idx)
-		{
-			bool once = true;
-			SwitchFunctionAssignment ss = static_cast<SwitchFunctionAssignment>(idx);
-			PatchVect & patches = curPatch.second.GetPatchVect(ss);
-			for (const BankPatchStatePtr& curItem : patches)
-			{
-				if (!curItem || !curItem->mPatch)
-					continue;
-
-				// only assign a switch to the first patch (if multiple 
-				// patches are assigned to the same switch)
-				if (once && ssPrimary == ss)
-				{
-					once = false;
-					curItem->mPatch->AssignSwitch(curPatch.first, switchDisplay);
-					if (curItem->mOverrideSwitchName.length() && switchDisplay)
-						switchDisplay->SetSwitchText(curPatch.first, curItem->mOverrideSwitchName);
-				}
-			}
-		}
-	}
+	AssignSwitches(switchDisplay);
 }
 
 void
@@ -359,21 +417,8 @@ PatchBank::DisengageSwitchesWithoutUnload(ISwitchDisplay * switchDisplay)
 	if (!mLoaded)
 		return;
 
-	for (auto & curPatch : mPatches)
-	{
-		for (int idx = ssPrimary; idx < ssCount; ++idx)
-		{
-			SwitchFunctionAssignment ss = static_cast<SwitchFunctionAssignment>(idx);
-			PatchVect & patches = curPatch.second.GetPatchVect(ss);
-			for (const BankPatchStatePtr& curItem : patches)
-			{
-				if (!curItem || !curItem->mPatch)
-					continue;
-
-				curItem->mPatch->ClearSwitch(switchDisplay);
-			}
-		}
-	}
+	for (const SwitchPatch & curItem : mSwitchPatches)
+		curItem.mPatch->ClearSwitch(switchDisplay);
 }
 
 void
@@ -397,20 +442,14 @@ PatchBank::PatchSwitchPressed(SwitchFunctionAssignment st,
 							  IMainDisplay * mainDisplay, 
 							  ISwitchDisplay * switchDisplay)
 {
-	PatchVect & curPatches = mPatches[switchNumber].GetPatchVect(st);
-	PatchVect::iterator it;
+	const SwitchEntry & entry = GetSwitchEntry(switchNumber);
+	const SwitchPatches curPatches(GetSwitchPatches(entry, st));
 
 	// if any patch for the switch is normal, then need to do normal processing
 	// on current normal patches.
-	for (it = curPatches.begin();
-		 it != curPatches.end();
-		 ++it)
+	for (const SwitchPatch & curSwitchItem : curPatches)
 	{
-		BankPatchStatePtr curSwitchItem = *it;
-		if (!curSwitchItem || !curSwitchItem->mPatch)
-			continue;
-
-		if (curSwitchItem->mPatch->IsPatchVolatile())
+		if (curSwitchItem.mPatch->IsPatchVolatile())
 		{
 			// do B processing
 			mEngine->DeactivateVolatilePatches(mainDisplay, switchDisplay);
@@ -418,36 +457,28 @@ PatchBank::PatchSwitchPressed(SwitchFunctionAssignment st,
 		}
 	}
 
-	GroupSwitchesPtr grp = mGroupFromSwitch[switchNumber];
-	if (grp)
+	const std::span<const int> grp(GetGroupSwitches(entry));
+	if (!grp.empty())
 	{
 		bool isRepress = false;
 		bool isAnyPatchInGroupActiveThatIsNotCurrentSwitch = false;
-		for (const int kCurSwitchNumber : *grp)
+		for (const int kCurSwitchNumber : grp)
 		{
-			PatchVect & prevPatches = mPatches[kCurSwitchNumber].GetPatchVect(st);
-			for (it = prevPatches.begin();
-				it != prevPatches.end();
-				++it)
-			{
-				BankPatchStatePtr curSwitchItem = *it;
-				if (!curSwitchItem || !curSwitchItem->mPatch)
-					continue;
-
-				if (kCurSwitchNumber == switchNumber)
-					isRepress = true;
-				else if (curSwitchItem->mPatch->IsActive())
-					isAnyPatchInGroupActiveThatIsNotCurrentSwitch = true;
+			const SwitchPatches prevPatches(GetSwitchPatches(GetSwitchEntry(kCurSwitchNumber), st));
+			if (prevPatches.empty())
+				continue;
 
-				// only check the first patch
-				break;
-			}
+			// only check the first patch
+			if (kCurSwitchNumber == switchNumber)
+				isRepress = true;
+			else if (prevPatches.front().mPatch->IsActive())
+				isAnyPatchInGroupActiveThatIsNotCurrentSwitch = true;
 		}
 
 		if (!isRepress || isAnyPatchInGroupActiveThatIsNotCurrentSwitch)
 		{
 			// turn off any in group that are active
-			for (const int kCurSwitchNumber : *grp)
+			for (const int kCurSwitchNumber : grp)
 			{
 				if (kCurSwitchNumber == switchNumber)
 					continue; // don't deactivate if pressing the same switch multiple times
@@ -455,19 +486,12 @@ PatchBank::PatchSwitchPressed(SwitchFunctionAssignment st,
 				// exclusive groups don't really support secondary functions.
 				// keep secondary function groups separate from primary function groups.
 				// basically unsupported for now.
-				PatchVect & prevPatches = mPatches[kCurSwitchNumber].GetPatchVect(st);
-				for (it = prevPatches.begin();
-					it != prevPatches.end();
-					++it)
+				for (const SwitchPatch & curSwitchItem : GetSwitchPatches(GetSwitchEntry(kCurSwitchNumber), st))
 				{
-					BankPatchStatePtr curSwitchItem = *it;
-					if (!curSwitchItem || !curSwitchItem->mPatch)
-						continue;
-
-					curSwitchItem->mPatch->Deactivate(mainDisplay, switchDisplay);
+					curSwitchItem.mPatch->Deactivate(mainDisplay, switchDisplay);
 
 					// force displays off for all other patches in group
-					curSwitchItem->mPatch->UpdateDisplays(mainDisplay, switchDisplay);
+					curSwitchItem.mPatch->UpdateDisplays(mainDisplay, switchDisplay);
 				}
 			}
 		}
@@ -475,30 +499,18 @@ PatchBank::PatchSwitchPressed(SwitchFunctionAssignment st,
 
 	bool doDisplayUpdate = true;
 
-	it = curPatches.begin();
-	bool masterPatchIsActive = false;
-	if (it != curPatches.end())
-	{
-		BankPatchStatePtr curSwitchItem = *it;
-		if (curSwitchItem && curSwitchItem->mPatch && curSwitchItem->mPatch->IsActive())
-			masterPatchIsActive = true; // master patch is just the first
-	}
+	// master patch is just the first
+	const bool masterPatchIsActive = !curPatches.empty() && curPatches.front().mPatch->IsActive();
 
 	// do standard pressed processing (send A)
 	bool once = (st == ssPrimary);
 	std::string msgstr;
-	for (it = curPatches.begin();
-		 it != curPatches.end();
-		 ++it)
+	for (const SwitchPatch & curSwitchItem : curPatches)
 	{
-		BankPatchStatePtr curSwitchItem = *it;
-		if (!curSwitchItem || !curSwitchItem->mPatch)
-			continue;
-
 		if (!once)
-			curSwitchItem->mPatch->OverridePedals(true); // expression pedals only apply to first patch
+			curSwitchItem.mPatch->OverridePedals(true); // expression pedals only apply to first patch
 
-		if (syncIgnore != curSwitchItem->mPatchSyncState)
+		if (syncIgnore != curSwitchItem.mPatchSyncState)
 		{
 			// sync mode
 			// sync options work relative to first mapping
@@ -511,40 +523,40 @@ PatchBank::PatchSwitchPressed(SwitchFunctionAssignment st,
 			// Consider: option for sync on activate only - override no change after load?
 			// Consider: option for override on deactivate only - override no change on load?
 
-			if (syncInPhase == curSwitchItem->mPatchSyncState)
+			if (syncInPhase == curSwitchItem.mPatchSyncState)
 			{
-				if (curSwitchItem->mPatch->IsActive() != masterPatchIsActive)
-					curSwitchItem->mPatch->SwitchPressed(nullptr, switchDisplay);
+				if (curSwitchItem.mPatch->IsActive() != masterPatchIsActive)
+					curSwitchItem.mPatch->SwitchPressed(nullptr, switchDisplay);
 			}
 			else
 			{
-				if (curSwitchItem->mPatch->IsActive() == masterPatchIsActive)
-					curSwitchItem->mPatch->SwitchPressed(nullptr, switchDisplay);
+				if (curSwitchItem.mPatch->IsActive() == masterPatchIsActive)
+					curSwitchItem.mPatch->SwitchPressed(nullptr, switchDisplay);
 			}
 		}
 
-		if (stIgnore == curSwitchItem->mPatchStateOverride ||
-			(stA == curSwitchItem->mPatchStateOverride && !curSwitchItem->mPatch->IsActive()) ||
-			(stB == curSwitchItem->mPatchStateOverride && curSwitchItem->mPatch->IsActive()))
-			curSwitchItem->mPatch->SwitchPressed(nullptr, switchDisplay);
+		if (stIgnore == curSwitchItem.mPatchStateOverride ||
+			(stA == curSwitchItem.mPatchStateOverride && !curSwitchItem.mPatch->IsActive()) ||
+			(stB == curSwitchItem.mPatchStateOverride && curSwitchItem.mPatch->IsActive()))
+			curSwitchItem.mPatch->SwitchPressed(nullptr, switchDisplay);
 		else
-			curSwitchItem->mPatch->UpdateDisplays(nullptr, switchDisplay);
+			curSwitchItem.mPatch->UpdateDisplays(nullptr, switchDisplay);
 
 		if (once)
 			once = false;
 		else
-			curSwitchItem->mPatch->OverridePedals(false);
+			curSwitchItem.mPatch->OverridePedals(false);
 
-		if (curSwitchItem->mPatch->IsPatchVolatile())
-			mEngine->VolatilePatchIsActive(curSwitchItem->mPatch);
+		if (curSwitchItem.mPatch->IsPatchVolatile())
+			mEngine->VolatilePatchIsActive(curSwitchItem.mState->mPatch);
 
-		mEngine->CheckForDeviceProgramChange(curSwitchItem.get()->mPatch, switchDisplay, mainDisplay);
+		mEngine->CheckForDeviceProgramChange(curSwitchItem.mState->mPatch, switchDisplay, mainDisplay);
 
-		if (curSwitchItem->mPatch->UpdateMainDisplayOnPress())
+		if (curSwitchItem.mPatch->UpdateMainDisplayOnPress())
 		{
-			const std::string txt(curSwitchItem->mPatch->GetDisplayText(true));
+			const std::string txt(curSwitchItem.mPatch->GetDisplayText(true));
 			msgstr += txt;
-			const int patchNum = curSwitchItem->mPatch->GetNumber();
+			const int patchNum = curSwitchItem.mPatch->GetNumber();
 			if (patchNum > 0)
 			{
 #ifdef _DEBUG
@@ -586,6 +598,7 @@ PatchBank::PatchSwitchReleased(int switchNumber,
 							   ISwitchDisplay * switchDisplay, 
 							   SwitchPressDuration dur)
 {
+	const SwitchEntry & entry = GetSwitchEntry(switchNumber);
 	const bool kHasSecondaryLogic = SwitchHasSecondaryLogic(switchNumber);
 	if (kHasSecondaryLogic)
 	{
@@ -593,20 +606,16 @@ PatchBank::PatchSwitchReleased(int switchNumber,
 		{
 			// long press changes switch mode; handle transition
 			ToggleDualFunctionState(switchNumber, mainDisplay, switchDisplay);
-			if (ssPrimary == mPatches[switchNumber].mCurrentSwitchState)
+			if (ssPrimary == entry.mCurrentSwitchState)
 			{
 				// back in primary mode, no more work to do, except update main display
 				if (mLoaded)
 				{
-					PatchVect & patches = mPatches[switchNumber].GetPatchVect();
-					for (const BankPatchStatePtr& curItem : patches)
+					const SwitchPatches patches(GetSwitchPatches(entry));
+					if (!patches.empty())
 					{
-						if (!curItem || !curItem->mPatch)
-							continue;
-
 						// update main display to note new function state registered
-						curItem->mPatch->UpdateDisplays(mainDisplay, nullptr);
-						break;
+						patches.front().mPatch->UpdateDisplays(mainDisplay, nullptr);
 					}
 				}
 				return;
@@ -626,12 +635,12 @@ PatchBank::PatchSwitchReleased(int switchNumber,
 				return;
 			}
 
-			switch (mPatches[switchNumber].mSfOp)
+			switch (entry.mSfOp)
 			{
 			case sfoAuto:
 			case sfoAutoEnable:
 				// activate on press if not already active
-				if (mPatches[switchNumber].mSecondaryPatches[0]->mPatch->IsActive())
+				if (GetSwitchPatches(entry, ssSecondary).front().mPatch->IsActive())
 					return; 
 				break;
 			case sfoStatelessToggle:
@@ -643,24 +652,24 @@ PatchBank::PatchSwitchReleased(int switchNumber,
 		}
 
 		// since PatchSwitchPressed was ignored, handle now
-		PatchSwitchPressed(mPatches[switchNumber].mCurrentSwitchState, switchNumber, mainDisplay, switchDisplay);
+		PatchSwitchPressed(entry.mCurrentSwitchState, switchNumber, mainDisplay, switchDisplay);
 	}
 
 	// this only happens during short-press or during sfoAuto* long-press
-	PatchSwitchReleased(mPatches[switchNumber].mCurrentSwitchState, switchNumber, mainDisplay, switchDisplay);
+	PatchSwitchReleased(entry.mCurrentSwitchState, switchNumber, mainDisplay, switchDisplay);
 
-	if (kHasSecondaryLogic && ssSecondary == mPatches[switchNumber].mCurrentSwitchState)
+	if (kHasSecondaryLogic && ssSecondary == entry.mCurrentSwitchState)
 	{
 		// in secondary mode, see if we need to go back to primary mode
 		switch (dur)
 		{
 		case spdShort:
-			switch (mPatches[switchNumber].mSfOp)
+			switch (entry.mSfOp)
 			{
 			case sfoAuto:
 			case sfoAutoDisable:
 				// toggle switch function on release if no longer active
-				if (mPatches[switchNumber].mSecondaryPatches[0]->mPatch->IsActive())
+				if (GetSwitchPatches(entry, ssSecondary).front().mPatch->IsActive())
 					return; 
 				break;
 			case sfoStatelessToggle:
@@ -675,7 +684,7 @@ PatchBank::PatchSwitchReleased(int switchNumber,
 			break;
 
 		case spdLong:
-			if (sfoStatelessToggle == mPatches[switchNumber].mSfOp)
+			if (sfoStatelessToggle == entry.mSfOp)
 			{
 				// handle transition from secondary mode back to standard/primary mode for sfoStatelessToggle
 				ToggleDualFunctionState(switchNumber, mainDisplay, switchDisplay);
@@ -691,18 +700,13 @@ PatchBank::PatchSwitchReleased(SwitchFunctionAssignment st,
 							   IMainDisplay * mainDisplay, 
 							   ISwitchDisplay * switchDisplay)
 {
-	PatchVect & curPatches = mPatches[switchNumber].GetPatchVect(st);
-
 	bool once = (st == ssPrimary);
-	for (const BankPatchStatePtr& curSwitchItem : curPatches)
+	for (const SwitchPatch & curSwitchItem : GetSwitchPatches(GetSwitchEntry(switchNumber), st))
 	{
-		if (!curSwitchItem || !curSwitchItem->mPatch)
-			continue;
-
 		if (!once)
-			curSwitchItem->mPatch->OverridePedals(true); // expression pedals only apply to first patch
+			curSwitchItem.mPatch->OverridePedals(true); // expression pedals only apply to first patch
 
-		curSwitchItem->mPatch->SwitchReleased(mainDisplay, switchDisplay);
+		curSwitchItem.mPatch->SwitchReleased(mainDisplay, switchDisplay);
 
 		if (mainDisplay && mAdditionalText.size() > 1 && mEngine->IsBankActive(this))
 		{
@@ -722,7 +726,7 @@ PatchBank::PatchSwitchReleased(SwitchFunctionAssignment st,
 		if (once)
 			once = false;
 		else
-			curSwitchItem->mPatch->OverridePedals(false);
+			curSwitchItem.mPatch->OverridePedals(false);
 	}
 }
 
@@ -731,43 +735,35 @@ PatchBank::ToggleDualFunctionState(int switchNumber,
 								   IMainDisplay * mainDisplay, 
 								   ISwitchDisplay * switchDisplay)
 {
+	_ASSERTE(switchNumber >= 0 && switchNumber < (int)mSwitchTable.size());
+	SwitchEntry & entry = mSwitchTable[switchNumber];
 	if (mLoaded)
 	{
 		// clear switch assignment of current functions (extract of Unload).
 		// only do if loaded, since unload should have already handled
-		PatchVect & patches = mPatches[switchNumber].GetPatchVect();
-		for (const BankPatchStatePtr& curItem : patches)
-		{
-			if (!curItem || !curItem->mPatch)
-				continue;
-
-			curItem->mPatch->RemoveSwitch(switchNumber, switchDisplay);
-		}
+		for (const SwitchPatch & curItem : GetSwitchPatches(entry))
+			curItem.mPatch->RemoveSwitch(switchNumber, switchDisplay);
 	}
 
 	// toggle the function
-	mPatches[switchNumber].mCurrentSwitchState = 
-		(mPatches[switchNumber].mCurrentSwitchState == ssPrimary) ? ssSecondary : ssPrimary;
+	entry.mCurrentSwitchState = (entry.mCurrentSwitchState == ssPrimary) ? ssSecondary : ssPrimary;
 
 	if (mLoaded)
 	{
 		// assign switch to first current function (extract of Load).
 		// only do if loaded, since we don't want to modify switches under control
 		// of another now loaded bank
-		PatchVect & patches = mPatches[switchNumber].GetPatchVect();
-		for (const BankPatchStatePtr& curItem : patches)
+		const SwitchPatches patches(GetSwitchPatches(entry));
+		if (!patches.empty())
 		{
-			if (!curItem || !curItem->mPatch)
-				continue;
-
-			curItem->mPatch->AssignSwitch(switchNumber, switchDisplay);
-			if (curItem->mOverrideSwitchName.length() && switchDisplay)
-				switchDisplay->SetSwitchText(switchNumber, curItem->mOverrideSwitchName);
+			const SwitchPatch & curItem = patches.front();
+			curItem.mPatch->AssignSwitch(switchNumber, switchDisplay);
+			if (curItem.mState->mOverrideSwitchName.length() && switchDisplay)
+				switchDisplay->SetSwitchText(switchNumber, curItem.mState->mOverrideSwitchName);
 
 			// update main display to note new function state registered
-			if (mPatches[switchNumber].mCurrentSwitchState == ssSecondary)
-				curItem->mPatch->UpdateDisplays(mainDisplay, nullptr);
-			break;
+			if (entry.mCurrentSwitchState == ssSecondary)
+				curItem.mPatch->UpdateDisplays(mainDisplay, nullptr);
 		}
 	}
 }
@@ -794,41 +790,38 @@ PatchBank::DisplayInfo(IMainDisplay * mainDisplay,
 	if (showPatchInfo)
 	{
 		info += '\n';
-		for (auto & curPatch : mPatches)
+		for (int switchNumber = 0; switchNumber < (int)mSwitchTable.size(); ++switchNumber)
 		{
+			const SwitchEntry & entry = mSwitchTable[switchNumber];
 			for (int idx = ssPrimary; idx < ssCount; ++idx)
 			{
 				SwitchFunctionAssignment ss = static_cast<SwitchFunctionAssignment>(idx);
-				PatchVect & patches = curPatch.second.GetPatchVect(ss);
 				bool once = true;
-				for (const BankPatchStatePtr& curItem : patches)
+				for (const SwitchPatch & curItem : GetSwitchPatches(entry, ss))
 				{
-					if (!curItem || !curItem->mPatch)
-						continue;
-
 #ifdef _DEBUG
-					const int patchNum = curItem->mPatch->GetNumber();
+					const int patchNum = curItem.mPatch->GetNumber();
 #endif
 					if (once)
 					{
 						// primary patch
 						once = false;
 						if (temporaryDisplay)
-							curItem->mPatch->ClearSwitch(nullptr);
-						if (ssPrimary == ss && ssPrimary == curPatch.second.mCurrentSwitchState)
+							curItem.mPatch->ClearSwitch(nullptr);
+						if (ssPrimary == ss && ssPrimary == entry.mCurrentSwitchState)
 						{
-							curItem->mPatch->AssignSwitch(curPatch.first, switchDisplay);
-							if (curItem->mOverrideSwitchName.length() && switchDisplay)
-								switchDisplay->SetSwitchText(curPatch.first, curItem->mOverrideSwitchName);
+							curItem.mPatch->AssignSwitch(switchNumber, switchDisplay);
+							if (curItem.mState->mOverrideSwitchName.length() && switchDisplay)
+								switchDisplay->SetSwitchText(switchNumber, curItem.mState->mOverrideSwitchName);
 						}
-						else if (ssSecondary == ss && ssSecondary == curPatch.second.mCurrentSwitchState)
+						else if (ssSecondary == ss && ssSecondary == entry.mCurrentSwitchState)
 						{
-							curItem->mPatch->AssignSwitch(curPatch.first, switchDisplay);
-							if (curItem->mOverrideSwitchName.length() && switchDisplay)
-								switchDisplay->SetSwitchText(curPatch.first, curItem->mOverrideSwitchName);
+							curItem.mPatch->AssignSwitch(switchNumber, switchDisplay);
+							if (curItem.mState->mOverrideSwitchName.length() && switchDisplay)
+								switchDisplay->SetSwitchText(switchNumber, curItem.mState->mOverrideSwitchName);
 						}
 
-						std::format_to(std::back_inserter(info), "sw{:2}", curPatch.first + 1);
+						std::format_to(std::back_inserter(info), "sw{:2}", switchNumber + 1);
 						if (ssSecondary == idx)
 							info += "-2:";
 						else
@@ -836,8 +829,8 @@ PatchBank::DisplayInfo(IMainDisplay * mainDisplay,
 		
 						if (temporaryDisplay)
 						{
-//							curItem->mPatch->AssignSwitch(-1, NULL);
-							curItem->mPatch->ClearSwitch(nullptr);
+//							curItem.mPatch->AssignSwitch(-1, NULL);
+							curItem.mPatch->ClearSwitch(nullptr);
 						}
 					}
 					else
@@ -846,7 +839,7 @@ PatchBank::DisplayInfo(IMainDisplay * mainDisplay,
 						info += "       ";
 					}
 
-					info += curItem->mPatch->GetName();
+					info += curItem.mPatch->GetName();
 #ifdef _DEBUG
 					if (patchNum > 0)
 						std::format_to(std::back_inserter(info), "   ({})\n", patchNum);
@@ -874,48 +867,37 @@ PatchBank::DisplayDetailedPatchInfo(int switchNumber, IMainDisplay * mainDisplay
 	);
 
 	bool displayedPatchheader = false;
+	const SwitchEntry & entry = GetSwitchEntry(switchNumber);
 	for (int idx = ssPrimary; idx < ssCount; ++idx)
 	{
-		for (auto & curPatch : mPatches)
-		{
-			if (curPatch.first != switchNumber)
-				continue;
-
-			int cnt = 0;
-			SwitchFunctionAssignment ss = static_cast<SwitchFunctionAssignment>(idx);
-			PatchVect & patches = curPatch.second.GetPatchVect(ss);
-			if (ssSecondary == ss && !patches.empty())
-				info += "secondary switch functions:\n";
+		int cnt = 0;
+		SwitchFunctionAssignment ss = static_cast<SwitchFunctionAssignment>(idx);
+		const SwitchPatches patches(GetSwitchPatches(entry, ss));
+		if (ssSecondary == ss && !patches.empty())
+			info += "secondary switch functions:\n";
 
-			for (const BankPatchStatePtr& curItem : patches)
+		for (const SwitchPatch & curItem : patches)
+		{
+			if (cnt == 0 && !displayedPatchheader)
 			{
-				if (!curItem || !curItem->mPatch)
-					continue;
-
-				if (cnt == 0 && !displayedPatchheader)
-				{
-					info += "Status / Type / Name (num)\n";
-					displayedPatchheader = true;
-				}
+				info += "Status / Type / Name (num)\n";
+				displayedPatchheader = true;
+			}
 
-// 				if (cnt == 1)
-// 					info += "(Hidden patches)\n";
+// 			if (cnt == 1)
+// 				info += "(Hidden patches)\n";
 
-				 
-				std::format_to(std::back_inserter(info), "{}{:<19}  {}", (curItem->mPatch->IsActive() ? "ON   " : "off  "), curItem->mPatch->GetPatchTypeStr(), curItem->mPatch->GetName());
+			std::format_to(std::back_inserter(info), "{}{:<19}  {}", (curItem.mPatch->IsActive() ? "ON   " : "off  "), curItem.mPatch->GetPatchTypeStr(), curItem.mPatch->GetName());
 
 #ifdef _DEBUG
-				const int patchNum = curItem->mPatch->GetNumber();
-				if (patchNum > 0)
-					std::format_to(std::back_inserter(info), "   ({})\n", patchNum);
-				else
+			const int patchNum = curItem.mPatch->GetNumber();
+			if (patchNum > 0)
+				std::format_to(std::back_inserter(info), "   ({})\n", patchNum);
+			else
 #endif
-					info += '\n';
-
-				++cnt;
-			}
+				info += '\n';
 
-			break;
+			++cnt;
 		}
 	}
 
@@ -927,19 +909,13 @@ void
 PatchBank::ResetPatches(IMainDisplay * mainDisplay, 
 						ISwitchDisplay * switchDisplay)
 {
-	for (auto & curPatch : mPatches)
+	for (const SwitchEntry & entry : mSwitchTable)
 	{
 		for (int idx = ssPrimary; idx < ssCount; ++idx)
 		{
 			SwitchFunctionAssignment ss = static_cast<SwitchFunctionAssignment>(idx);
-			PatchVect & patches = curPatch.second.GetPatchVect(ss);
-			for (const BankPatchStatePtr& curItem : patches)
-			{
-				if (!curItem || !curItem->mPatch)
-					continue;
-
-				curItem->mPatch->UpdateState(switchDisplay, false);
-			}
+			for (const SwitchPatch & curItem : GetSwitchPatches(entry, ss))
+				curItem.mPatch->UpdateState(switchDisplay, false);
 		}
 	}
 
@@ -947,6 +923,30 @@ PatchBank::ResetPatches(IMainDisplay * mainDisplay,
 		mainDisplay->TextOut("Bank patches reset\n");
 }
 
+std::vector<int>
+PatchBank::GetSwitchNumbers() const
+{
+	std::vector<int> switchNumbers;
+	for (int switchNumber = 0; switchNumber < (int)mSwitchTable.size(); ++switchNumber)
+	{
+		const SwitchEntry & entry = mSwitchTable[switchNumber];
+		if (entry.mPatchCount[ssPrimary] || entry.mPatchCount[ssSecondary])
+			switchNumbers.push_back(switchNumber);
+	}
+	return switchNumbers;
+}
+
+// the patch that owns the switch for the given function
+PatchPtr
+PatchBank::GetSwitchPatch(int switchNumber, 
+						  SwitchFunctionAssignment st) const
+{
+	const SwitchPatches patches(GetSwitchPatches(GetSwitchEntry(switchNumber), st));
+	if (patches.empty())
+		return nullptr;
+	return patches.front().mState->mPatch;
+}
+
 void
 PatchBank::CreateExclusiveGroup(GroupSwitchesPtr switchNumbers)
 {
@@ -965,24 +965,14 @@ void
 PatchBank::ResetExclusiveGroup(ISwitchDisplay * switchDisplay, 
 							   int switchNumberToSet)
 {
-	GroupSwitchesPtr grp = mGroupFromSwitch[switchNumberToSet];
-	if (!grp)
-		return;
-
-	for (const int kCurSwitchNumber : *grp)
+	for (const int kCurSwitchNumber : GetGroupSwitches(GetSwitchEntry(switchNumberToSet)))
 	{
 		const bool enabled = kCurSwitchNumber == switchNumberToSet;
 
 		// exclusive groups don't really support secondary functions.
 		// keep secondary function groups separate from primary function groups.
 		// basically unsupported for now.
-		PatchVect & prevPatches = mPatches[kCurSwitchNumber].GetPatchVect(ssPrimary);
-		for (const BankPatchStatePtr& curSwitchItem : prevPatches)
-		{
-			if (!curSwitchItem || !curSwitchItem->mPatch)
-				continue;
-
-			curSwitchItem->mPatch->UpdateState(switchDisplay, enabled);
-		}
+		for (const SwitchPatch & curSwitchItem : GetSwitchPatches(GetSwitchEntry(kCurSwitchNumber), ssPrimary))
+			curSwitchItem.mPatch->UpdateState(switchDisplay, enabled);
 	}
 }
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2007-2008,2010,2012-2015,2018,2024-2025 Sean Echevarria
+ * Copyright (C) 2007-2008,2010,2012-2015,2018,2024-2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -30,6 +30,8 @@
 #include <string>
 #include <set>
 #include <memory>
+#include <span>
+#include <vector>
 #include "MidiControlEngine.h"
 
 class Patch;
@@ -90,7 +92,7 @@ public:
 	void SetDefaultMappings(const PatchBankPtr defaultMapping);
 
 	void Load(IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay);
-	void Unload(IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay);
+	void Unload(IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay, const PatchBank * nextBank = nullptr);
 	void ReengageSwitchesWithoutLoad(ISwitchDisplay * switchDisplay);
 	void DisengageSwitchesWithoutUnload(ISwitchDisplay * switchDisplay);
 	void DisplayInfo(IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay, bool showPatchInfo, bool temporaryDisplay);
@@ -104,13 +106,19 @@ public:
 	int GetBankNumber() const {return mNumber;}
 	const std::string & GetBankName() const {return mName;}
 
+	// read-only view of the switch assignments (for tools and benchmarks)
+	std::vector<int> GetSwitchNumbers() const;
+	PatchPtr GetSwitchPatch(int switchNumber, SwitchFunctionAssignment st = ssPrimary) const;
+
 	// support for exclusive switch groups
 	using GroupSwitches = std::set<int>;			// contains the switches for an exclusive group
 	using GroupSwitchesPtr = std::shared_ptr<GroupSwitches>;
 	void CreateExclusiveGroup(GroupSwitchesPtr switches);
 
 private:
-	bool SwitchHasSecondaryLogic(int switchNumber) { return mPatches[switchNumber].mSfOp != sfoNone; }
+	bool SwitchHasSecondaryLogic(int switchNumber) const;
+	void CompileSwitchTable();
+	void AssignSwitches(ISwitchDisplay * switchDisplay);
 	void ToggleDualFunctionState(int switchNumber, IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay);
 	void PatchSwitchPressed(SwitchFunctionAssignment st, int switchNumber, IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay);
 	void PatchSwitchReleased(SwitchFunctionAssignment st, int switchNumber, IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay);
@@ -156,17 +164,11 @@ private:
 
 	struct DualPatchVect
 	{
-		SwitchFunctionAssignment	mCurrentSwitchState;	// events affect primary or secondary patches
 		SecondFunctionOperation		mSfOp;					// assigned from first secondary patch
 		PatchVect					mPrimaryPatches;
 		PatchVect					mSecondaryPatches;
 
-		DualPatchVect() : mCurrentSwitchState(ssPrimary), mSfOp(sfoNone) { }
-
-		PatchVect &					GetPatchVect()
-		{
-			return GetPatchVect(mCurrentSwitchState);
-		}
+		DualPatchVect() : mSfOp(sfoNone) { }
 
 		PatchVect &					GetPatchVect(SwitchFunctionAssignment ss)
 		{
@@ -193,7 +195,65 @@ private:
 	// only the first patch associated with a switch gets control of the switch
 	// only the name of the first patch will be displayed
 	using PatchMaps = std::map<int, DualPatchVect>;
-	PatchMaps					mPatches;	// switchNumber is key
+	PatchMaps					mPatches;	// switchNumber is key; creation/init only
+
+	// mPatches and the exclusive groups compiled into flat arrays by
+	// InitPatches and SetDefaultMappings; all switch events go through these.
+	// Entries hold the patches that resolved, in assignment order.
+	struct SwitchPatch
+	{
+		Patch				* mPatch;
+		BankPatchState		* mState;	// owns mPatch
+		PatchState			mPatchStateOverride;
+		PatchSyncState		mPatchSyncState;
+	};
+	using SwitchPatches = std::span<const SwitchPatch>;
+
+	struct SwitchEntry
+	{
+		SwitchFunctionAssignment	mCurrentSwitchState = ssPrimary;	// events affect primary or secondary patches
+		SecondFunctionOperation		mSfOp = sfoNone;
+		unsigned int				mFirstPatch[ssCount] = { };		// index into mSwitchPatches
+		unsigned int				mPatchCount[ssCount] = { };
+		unsigned int				mFirstGroupSwitch = 0;			// index into mGroupSwitches
+		unsigned int				mGroupSwitchCount = 0;
+	};
+
+	// switches outside of the table have no patches
+	const SwitchEntry & GetSwitchEntry(int switchNumber) const
+	{
+		static const SwitchEntry kUnassigned;
+		return (switchNumber >= 0 && switchNumber < (int)mSwitchTable.size()) ? mSwitchTable[switchNumber] : kUnassigned;
+	}
+	SwitchPatches GetSwitchPatches(const SwitchEntry & entry, SwitchFunctionAssignment ss) const
+	{
+		const int idx = (ssPrimary == ss) ? ssPrimary : ssSecondary; // any other value is considered secondary
+		return SwitchPatches(mSwitchPatches.data() + entry.mFirstPatch[idx], entry.mPatchCount[idx]);
+	}
+	SwitchPatches GetSwitchPatches(const SwitchEntry & entry) const { return GetSwitchPatches(entry, entry.mCurrentSwitchState); }
+	std::span<const int> GetGroupSwitches(const SwitchEntry & entry) const { return std::span<const int>(mGroupSwitches.data() + entry.mFirstGroupSwitch, entry.mGroupSwitchCount); }
+
+	std::vector<SwitchEntry>	mSwitchTable;		// switchNumber is index
+	std::vector<SwitchPatch>	mSwitchPatches;		// contiguous per switch and function
+	std::vector<int>			mGroupSwitches;		// exclusive group members, contiguous per switch
+
+	// the loadState and unloadState changes of the bank, compiled with the
+	// switch table.  Executed as a diff against the current patch states.
+	struct BankTransition
+	{
+		Patch				* mPatch;
+		BankPatchState		* mState;			// owns mPatch
+		PatchState			mTargetState;		// stA or stB
+		bool				mOverridePedals;	// expression pedals only apply to first patch
+	};
+	using BankTransitions = std::vector<BankTransition>;
+
+	void ExecTransitions(const BankTransitions & plan, const PatchBank * nextBank, IMainDisplay * mainDisplay, ISwitchDisplay * switchDisplay);
+	bool IsLoadTransitionTarget(const Patch * patch) const;
+
+	BankTransitions				mLoadPlan;
+	BankTransitions				mUnloadPlan;
+	std::vector<const Patch *>	mLoadPlanPatches;	// sorted
 
 	// support for exclusive switch groups
 	using Groups = std::list<GroupSwitchesPtr>;					// contains all of the GroupSwitches for the current bank
@@ -0,0 +1,308 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#include "PatchCommandScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include "IMidiOut.h"
+#include "CrossPlatform.h"
+
+
+// Runs commands that contain no delays.  Consecutive commands that only
+// send pre-encoded MIDI to the same port are handed to the port as a batch.
+template<typename It>
+static void
+ExecRun(It first,
+		It last)
+{
+	enum { kMaxBatch = 32 };
+	const EncodedMidi * batch[kMaxBatch];
+	size_t batchLen = 0;
+	IMidiOut * batchOut = nullptr;
+
+	const auto flush = [&]()
+	{
+		if (1 == batchLen)
+			batchOut->MidiOut(*batch[0]);
+		else if (batchLen)
+			batchOut->MidiOutBatch(std::span<const EncodedMidi * const>(batch, batchLen));
+		batchLen = 0;
+	};
+
+	for (; first != last; ++first)
+	{
+		const IPatchCommandPtr & cmd = *first;
+		IMidiOut * midiOut = nullptr;
+		const EncodedMidi * msgs = cmd->GetEncodedMidi(midiOut);
+		if (!msgs || !midiOut)
+		{
+			flush();
+			cmd->Exec();
+			continue;
+		}
+
+		if (msgs->Empty())
+			continue;
+
+		if (midiOut != batchOut || kMaxBatch == batchLen)
+		{
+			flush();
+			batchOut = midiOut;
+		}
+
+		batch[batchLen++] = msgs;
+	}
+
+	flush();
+}
+
+template<typename It>
+static bool
+IsSchedulable(It first,
+			  It last)
+{
+	return std::all_of(first, last, [](const IPatchCommandPtr & cmd) { return cmd->IsSchedulable(); });
+}
+
+
+class TimelineScheduler
+{
+public:
+	TimelineScheduler();
+	~TimelineScheduler();
+
+	void Exec(const void * owner, const PatchCommands & cmds);
+
+private:
+	using Clock = std::chrono::steady_clock;
+	using DueList = std::multimap<Clock::time_point, const void *>;
+
+	struct Timeline
+	{
+		std::deque<IPatchCommandPtr>	mCmds;
+		Clock::time_point				mDeadline;
+	};
+
+	using Timelines = std::map<const void *, Timeline>;
+
+	void WorkerThread();
+	void RunTimeline(std::unique_lock<std::mutex> & lock, const void * owner);
+	void Wait(Timeline & timeline, int delay);
+
+	std::mutex					mLock;
+	std::condition_variable		mWake;
+	std::condition_variable		mIdle;		// a timeline finished
+	Timelines					mTimelines;
+	DueList						mDue;
+	bool						mRunning = true;
+	std::thread					mWorker;
+	PatchCommands				mRun;		// worker thread only
+};
+
+static TimelineScheduler * gScheduler = nullptr;
+
+
+void
+PatchCommandScheduler::Init()
+{
+	_ASSERTE(!gScheduler);
+	if (!gScheduler)
+		gScheduler = new TimelineScheduler;
+}
+
+void
+PatchCommandScheduler::Release()
+{
+	// pending timelines are dropped
+	delete gScheduler;
+	gScheduler = nullptr;
+}
+
+void
+PatchCommandScheduler::Exec(const void * owner,
+							const PatchCommands & cmds)
+{
+	if (gScheduler)
+	{
+		gScheduler->Exec(owner, cmds);
+		return;
+	}
+
+	ExecBlocking(cmds);
+}
+
+void
+PatchCommandScheduler::ExecBlocking(const PatchCommands & cmds)
+{
+	// delay commands block in Exec
+	ExecRun(cmds.begin(), cmds.end());
+}
+
+
+TimelineScheduler::TimelineScheduler() :
+	mWorker(&TimelineScheduler::WorkerThread, this)
+{
+}
+
+TimelineScheduler::~TimelineScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock(mLock);
+		mRunning = false;
+	}
+	mWake.notify_one();
+	mWorker.join();
+}
+
+void
+TimelineScheduler::Exec(const void * owner,
+						const PatchCommands & cmds)
+{
+	{
+		std::unique_lock<std::mutex> lock(mLock);
+		auto it = mTimelines.find(owner);
+		if (it != mTimelines.end())
+		{
+			if (IsSchedulable(cmds.begin(), cmds.end()))
+			{
+				// previous exec of this patch is still running; queue behind it
+				it->second.mCmds.insert(it->second.mCmds.end(), cmds.begin(), cmds.end());
+				return;
+			}
+
+			// can't be queued behind it, so wait for it
+			mIdle.wait(lock, [&]() { return mTimelines.find(owner) == mTimelines.end(); });
+		}
+	}
+
+	// run everything up to the first delay immediately
+	auto cmdIt = cmds.begin();
+	int delay = -1;
+	for (; cmdIt != cmds.end(); ++cmdIt)
+	{
+		delay = (*cmdIt)->GetDelayAmount();
+		if (delay >= 0)
+			break;
+	}
+
+	if (!IsSchedulable(cmdIt, cmds.end()))
+	{
+		// the commands after the delay can't run on the worker thread
+		ExecRun(cmds.begin(), cmds.end());
+		return;
+	}
+
+	ExecRun(cmds.begin(), cmdIt);
+	if (cmdIt == cmds.end())
+		return;
+
+	std::lock_guard<std::mutex> lock(mLock);
+	Timeline & timeline = mTimelines[owner];
+	_ASSERTE(timeline.mCmds.empty());
+	timeline.mCmds.assign(cmdIt + 1, cmds.end());
+	timeline.mDeadline = Clock::now();
+	Wait(timeline, delay);
+	mDue.emplace(timeline.mDeadline, owner);
+	mWake.notify_one();
+}
+
+void
+TimelineScheduler::Wait(Timeline & timeline,
+						int delay)
+{
+	// advance from the previous deadline rather than from now so that
+	// a series of delays doesn't accumulate scheduling latency
+	timeline.mDeadline += std::chrono::milliseconds(delay);
+}
+
+void
+TimelineScheduler::WorkerThread()
+{
+	std::unique_lock<std::mutex> lock(mLock);
+	while (mRunning)
+	{
+		if (mDue.empty())
+		{
+			mWake.wait(lock);
+			continue;
+		}
+
+		const auto next = mDue.begin();
+		if (next->first > Clock::now())
+		{
+			mWake.wait_until(lock, next->first);
+			continue;
+		}
+
+		const void * owner = next->second;
+		mDue.erase(next);
+		RunTimeline(lock, owner);
+	}
+}
+
+void
+TimelineScheduler::RunTimeline(std::unique_lock<std::mutex> & lock,
+							   const void * owner)
+{
+	for (;;)
+	{
+		// only this thread removes timelines, but Exec may have added
+		// commands while the lock was released
+		auto it = mTimelines.find(owner);
+		_ASSERTE(it != mTimelines.end());
+		Timeline & timeline = it->second;
+		if (timeline.mCmds.empty())
+		{
+			mTimelines.erase(it);
+			mIdle.notify_all();
+			return;
+		}
+
+		const int delay = timeline.mCmds.front()->GetDelayAmount();
+		if (delay >= 0)
+		{
+			timeline.mCmds.pop_front();
+			Wait(timeline, delay);
+			mDue.emplace(timeline.mDeadline, owner);
+			return;
+		}
+
+		// take commands up to the next delay
+		while (!timeline.mCmds.empty() && timeline.mCmds.front()->GetDelayAmount() < 0)
+		{
+			mRun.push_back(std::move(timeline.mCmds.front()));
+			timeline.mCmds.pop_front();
+		}
+
+		lock.unlock();
+		ExecRun(mRun.begin(), mRun.end());
+		mRun.clear();
+		lock.lock();
+	}
+}
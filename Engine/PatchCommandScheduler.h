@@ -0,0 +1,66 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#ifndef PatchCommandScheduler_h__
+#define PatchCommandScheduler_h__
+
+#include "IPatchCommand.h"
+
+
+// PatchCommandScheduler
+// -----------------------------------------------------------------------------
+// Runs patch command lists as timelines so that Sleep, SleepRandom and Rest
+// don't block the thread that pressed the switch.
+//
+// Commands up to the first delay run immediately on the calling thread.
+// The rest of the list is handed to a shared worker thread that runs it
+// when the delay expires (deadlines accumulate, so consecutive rests don't
+// drift).  Timelines of different patches run concurrently.  Command lists
+// executed by the same owner (patch) while a previous one is still pending
+// are appended to it, so per-patch ordering is the same as when everything
+// ran synchronously.
+//
+// Commands that aren't schedulable (see IPatchCommand::IsSchedulable) must
+// run on the calling thread, so a list that has any of them after a delay
+// runs synchronously (blocking sleeps), after any pending commands of the
+// owner.
+//
+// If the scheduler has not been initialized, Exec runs commands
+// synchronously (blocking sleeps).
+//
+// Consecutive commands that send pre-encoded MIDI to the same port are
+// sent to the port as one batch (see IMidiOut::MidiOutBatch).
+//
+class PatchCommandScheduler
+{
+public:
+	static void Init();
+	static void Release();
+
+	static void Exec(const void * owner, const PatchCommands & cmds);
+	// batched like Exec, but delays block the calling thread
+	static void ExecBlocking(const PatchCommands & cmds);
+};
+
+#endif // PatchCommandScheduler_h__
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2015,2018,2025 Sean Echevarria
+ * Copyright (C) 2015,2018,2025-2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -72,6 +72,7 @@ public:
 
 	virtual void ExecCommandsA() override;
 	virtual void ExecCommandsB() override;
+	virtual bool IsBankTransitionStateful() const override { return false; }
 
 	static bool PedalOverridePatchIsActive() 
 	{ 
@@ -46,6 +46,9 @@ public:
 		mEngine->RefirePedal(mPedalNumber);
 	}
 
+	// updates the display and the active pedals
+	virtual bool IsSchedulable() override { return false; }
+
 private:
 	RefirePedalCommand();
 
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2023-2025 Sean Echevarria
+ * Copyright (C) 2023-2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -26,6 +26,7 @@
 #define RepeatingPatch_h__
 
 #include "TwoStatePatch.h"
+#include "PatchCommandScheduler.h"
 #include <atomic>
 #include <qthread.h>
 
@@ -107,6 +108,16 @@ public:
 		while (mThreadShouldRun);
 	}
 
+protected:
+	virtual void ExecCmds(const PatchCommands & cmds) override
+	{
+		// the repeat thread paces itself with the delays in the list
+		if (QThread::currentThread() == this)
+			PatchCommandScheduler::ExecBlocking(cmds);
+		else
+			TwoStatePatch::ExecCmds(cmds);
+	}
+
 private:
 	std::atomic_bool mThreadIsRunning = false;
 	std::atomic_bool mThreadShouldRun = false;
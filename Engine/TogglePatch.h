@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2007-2009,2017-2018,2024-2025 Sean Echevarria
+ * Copyright (C) 2007-2009,2017-2018,2024-2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -181,6 +181,9 @@ public:
 			Base::Deactivate(mainDisplay, switchDisplay); // for toggle, calls SwitchPressed if is active
 	}
 
+	// momentary and hybrid state doesn't last
+	virtual bool IsBankTransitionStateful() const override { return PatchLogicStyle::Toggle == mPatchLogicStyle; }
+
 	virtual const std::string & GetDisplayText(bool checkState = false) const override
 	{
 		if (IsTogglePatchType())
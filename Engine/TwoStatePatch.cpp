@@ -1,6 +1,6 @@
 /*
 * mTroll MIDI Controller
-* Copyright (C) 2015-2016,2018,2024 Sean Echevarria
+* Copyright (C) 2015-2016,2018,2024,2026 Sean Echevarria
 *
 * This file is part of mTroll.
 *
@@ -25,6 +25,7 @@
 #include "TwoStatePatch.h"
 #include "PersistentPedalOverridePatch.h"
 #include "MidiControlEngine.h"
+#include "PatchCommandScheduler.h"
 
 
 void
@@ -58,7 +59,13 @@ void
 TwoStatePatch::ExecCommandsA()
 {
 	mPatchIsActive = true;
+	SelectPedals();
+	ExecCmds(mCmdsA);
+}
 
+void
+TwoStatePatch::SelectPedals()
+{
 	if (!mOverridePedals)
 	{
 		if (psDisallow != mPedalSupport)
@@ -79,16 +86,12 @@ TwoStatePatch::ExecCommandsA()
 			}
 		}
 	}
-
-	for (const auto& cmd : mCmdsA)
-		cmd->Exec();
 }
 
 void
 TwoStatePatch::ExecCommandsB()
 {
-	for (const auto &cmd : mCmdsB)
-		cmd->Exec();
+	ExecCmds(mCmdsB);
 
 	mPatchIsActive = false;
 
@@ -98,3 +101,9 @@ TwoStatePatch::ExecCommandsB()
 			gActivePatchPedals = nullptr;
 	}
 }
+
+void
+TwoStatePatch::ExecCmds(const PatchCommands & cmds)
+{
+	PatchCommandScheduler::Exec(this, cmds);
+}
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2007-2010,2013,2015,2018,2021,2024-2025 Sean Echevarria
+ * Copyright (C) 2007-2010,2013,2015,2018,2021,2024-2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -84,10 +84,17 @@ public:
 
 	virtual void BankTransitionActivation() override;
 	virtual void BankTransitionDeactivation() override { ExecCommandsB(); }
+	virtual void BankTransitionActivationSkipped() override { SelectPedals(); }
 
 	virtual void ExecCommandsA();
 	virtual void ExecCommandsB();
 
+protected:
+	// runs the list on PatchCommandScheduler so that delays don't block
+	virtual void ExecCmds(const PatchCommands & cmds);
+	// pedal assignment of ExecCommandsA
+	void SelectPedals();
+
 private:
 	TwoStatePatch();
 	TwoStatePatch(const TwoStatePatch &);
@@ -0,0 +1,203 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+// ClockJitterBench
+// ----------------------------------------------------------------------------
+// Runs the MIDI beat clock into a null output that timestamps every tick
+// and reports inter-tick interval histograms, cumulative drift versus the
+// ideal tick times and CPU time used, per tempo.
+//
+// usage: ClockJitterBench [seconds per tempo] [bpm ...]
+//        defaults: 10 seconds at 60 90 120 180 240
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+#include <vector>
+#include "../midi/MidiClockGenerator.h"
+#include "NullMidiOut.h"
+
+
+using Clock = std::chrono::steady_clock;
+
+
+// IMidiOut that only implements the clock; every tick is timestamped
+class TimestampingMidiOut : public NullMidiOut, private IMidiClockSink
+{
+public:
+	TimestampingMidiOut() : mClock(this) { }
+
+	void PrepareRun(size_t maxTicks)
+	{
+		mTicks.clear();
+		mTicks.reserve(maxTicks);
+	}
+
+	const std::vector<Clock::time_point> & GetTicks() const { return mTicks; }
+
+	// IMidiOut
+	virtual void EnableMidiClock(bool enable) override
+	{
+		if (enable)
+			mClock.Start();
+		else
+			mClock.Stop();
+	}
+	virtual bool IsMidiClockEnabled() override { return mClock.IsRunning(); }
+	virtual void SetTempo(int bpm) override { mClock.SetTempo(bpm); }
+	virtual int GetTempo() const override { return mClock.GetTempo(); }
+	virtual MidiClockStats GetMidiClockStats() const override { return mClock.GetStats(); }
+	virtual void CloseMidiOut() override { EnableMidiClock(false); }
+
+private:
+	// IMidiClockSink
+	virtual void SendClockTick() override
+	{
+		if (mTicks.size() < mTicks.capacity())
+			mTicks.push_back(Clock::now());
+	}
+
+	std::vector<Clock::time_point>	mTicks;
+	MidiClockGenerator				mClock;
+};
+
+
+static double
+CpuSeconds()
+{
+	return (double)std::clock() / CLOCKS_PER_SEC;
+}
+
+static void
+RunTempo(TimestampingMidiOut & out,
+		 int bpm,
+		 int seconds)
+{
+	out.PrepareRun((size_t)seconds * 110 + 100);
+	out.SetTempo(bpm);
+	bpm = out.GetTempo();
+
+	const double cpuStart = CpuSeconds();
+	out.EnableMidiClock(true);
+	std::this_thread::sleep_for(std::chrono::seconds(seconds));
+	out.EnableMidiClock(false);
+	const double cpuUsed = CpuSeconds() - cpuStart;
+
+	const std::vector<Clock::time_point> & ticks = out.GetTicks();
+	const double idealUs = 2500000.0 / bpm;
+	std::printf("\n%d bpm: %zu ticks, ideal interval %.1f us, cpu %.2f s (%.1f%% of one core)\n",
+		bpm, ticks.size(), idealUs, cpuUsed, 100.0 * cpuUsed / seconds);
+	if (ticks.size() < 2)
+		return;
+
+	// deviation of each interval from ideal, in microseconds
+	std::vector<double> deviations;
+	deviations.reserve(ticks.size() - 1);
+	for (size_t idx = 1; idx < ticks.size(); ++idx)
+	{
+		const double intervalUs = std::chrono::duration<double, std::micro>(ticks[idx] - ticks[idx - 1]).count();
+		deviations.push_back(intervalUs - idealUs);
+	}
+
+	const double kBuckets[] = { 10, 25, 50, 100, 250, 500, 1000, 2000 };
+	constexpr size_t kBucketCount = sizeof(kBuckets) / sizeof(kBuckets[0]);
+	size_t counts[kBucketCount + 1] = { };
+	double maxAbs = 0, total = 0;
+	std::vector<double> absDeviations;
+	absDeviations.reserve(deviations.size());
+	for (double dev : deviations)
+	{
+		const double absDev = dev < 0 ? -dev : dev;
+		absDeviations.push_back(absDev);
+		total += absDev;
+		if (absDev > maxAbs)
+			maxAbs = absDev;
+
+		size_t bucket = 0;
+		while (bucket < kBucketCount && absDev >= kBuckets[bucket])
+			++bucket;
+		++counts[bucket];
+	}
+
+	std::sort(absDeviations.begin(), absDeviations.end());
+	const auto percentile = [&absDeviations](double pct)
+	{
+		const size_t idx = (size_t)(pct / 100.0 * (absDeviations.size() - 1) + 0.5);
+		return absDeviations[idx];
+	};
+
+	std::printf("  interval jitter: mean %.1f us, p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n",
+		total / absDeviations.size(), percentile(50), percentile(99), percentile(99.9), maxAbs);
+
+	std::printf("  histogram of |interval - ideal|:\n");
+	double lower = 0;
+	for (size_t bucket = 0; bucket <= kBucketCount; ++bucket)
+	{
+		const double pct = 100.0 * counts[bucket] / deviations.size();
+		if (bucket < kBucketCount)
+			std::printf("    %6.0f - %6.0f us: %8zu  %6.2f%%\n", lower, kBuckets[bucket], counts[bucket], pct);
+		else
+			std::printf("    %6.0f us and up : %8zu  %6.2f%%\n", lower, counts[bucket], pct);
+		if (bucket < kBucketCount)
+			lower = kBuckets[bucket];
+	}
+
+	// where the last tick landed relative to where it should have
+	const double elapsedUs = std::chrono::duration<double, std::micro>(ticks.back() - ticks.front()).count();
+	const double driftUs = elapsedUs - idealUs * (ticks.size() - 1);
+	std::printf("  cumulative drift after %.1f s: %+.1f us (%+.3f ppm)\n",
+		elapsedUs / 1000000.0, driftUs, driftUs / elapsedUs * 1000000.0);
+}
+
+int
+main(int argc,
+	 char * argv[])
+{
+	int seconds = 10;
+	std::vector<int> tempos;
+	if (argc > 1)
+		seconds = std::atoi(argv[1]);
+	for (int idx = 2; idx < argc; ++idx)
+		tempos.push_back(std::atoi(argv[idx]));
+
+	if (seconds < 1)
+	{
+		std::fprintf(stderr, "usage: %s [seconds per tempo] [bpm ...]\n", argv[0]);
+		return 1;
+	}
+
+	if (tempos.empty())
+		tempos = { 60, 90, 120, 180, 240 };
+
+	TimestampingMidiOut out;
+	std::printf("MIDI clock jitter: %d seconds per tempo\n", seconds);
+	for (int bpm : tempos)
+		RunTempo(out, bpm, seconds);
+
+	return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "CountingNew.h"
+
+
+static std::atomic<AllocationHook> sHook{nullptr};
+
+void
+SetAllocationHook(AllocationHook hook)
+{
+	sHook.store(hook, std::memory_order_relaxed);
+}
+
+void *
+operator new(std::size_t size)
+{
+	if (AllocationHook hook = sHook.load(std::memory_order_relaxed))
+		hook();
+	if (void * ptr = std::malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void
+operator delete(void * ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void
+operator delete(void * ptr,
+				std::size_t) noexcept
+{
+	std::free(ptr);
+}
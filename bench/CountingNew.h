@@ -0,0 +1,42 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#ifndef CountingNew_h__
+#define CountingNew_h__
+
+
+// CountingNew
+// ----------------------------------------------------------------------------
+// Replaces global operator new and delete (malloc and free underneath) for
+// benches that count heap allocations.  The replacements are in their own
+// source file so that the compiler never sees one of them inlined next to a
+// call to the other (which it reports as mismatched).
+//
+// The hook is called for every allocation, on the allocating thread; it
+// must not allocate.
+//
+using AllocationHook = void (*)();
+void SetAllocationHook(AllocationHook hook);
+
+#endif // CountingNew_h__
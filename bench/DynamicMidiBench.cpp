@@ -0,0 +1,160 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+// DynamicMidiBench
+// ----------------------------------------------------------------------------
+// Executes dynamic note/control/program change commands (dynamic port,
+// channel and random velocity) into a null output and counts heap
+// allocations made by Exec (see CountingNew).  Commands run on two threads
+// at once, as they do with the UI and the patch scheduler.
+// Exits with 1 if any Exec allocated.
+//
+// usage: DynamicMidiBench [execs per thread]
+//        default: 1000000
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "../Engine/DynamicMidiCommand.h"
+#include "../Engine/IMidiOutGenerator.h"
+#include "CountingNew.h"
+#include "NullMidiOut.h"
+
+
+// per thread so that one thread starting another (which allocates the
+// new thread's state) isn't counted against the thread being measured
+static thread_local unsigned long long tAllocations = 0;
+
+static void
+CountAllocation()
+{
+	++tAllocations;
+}
+
+
+// IMidiOut that counts messages and sums velocities
+class CountingMidiOut : public NullMidiOut
+{
+public:
+	// IMidiOut
+	using NullMidiOut::MidiOut;
+	virtual void MidiOut(MidiEvent evt, bool) override
+	{
+		mMessages.fetch_add(1, std::memory_order_relaxed);
+		if (0x90 == evt.GetCommand())
+			mVelocities.fetch_add(evt.GetData2(), std::memory_order_relaxed);
+	}
+
+	std::atomic<unsigned long long>	mMessages{0};
+	std::atomic<unsigned long long>	mVelocities{0};
+};
+
+
+class NullMidiOutGenerator : public IMidiOutGenerator
+{
+public:
+	NullMidiOutGenerator() : mOut(std::make_shared<CountingMidiOut>()) { }
+
+	virtual IMidiOutPtr	CreateMidiOut(unsigned int, int, unsigned int) override { return mOut; }
+	virtual IMidiOutPtr	GetMidiOut(unsigned int) override { return mOut; }
+	virtual unsigned int GetMidiOutDeviceIndex(const std::string &) override { return 0; }
+	virtual void		OpenMidiOuts() override { }
+	virtual void		CloseMidiOuts() override { }
+
+	std::shared_ptr<CountingMidiOut>	mOut;
+};
+
+
+static void
+RunCommands(const PatchCommands & cmds,
+			int execs,
+			unsigned long long & allocations,
+			double & nsPerExec)
+{
+	// first pass sets up this thread's random velocity state
+	for (const auto & cmd : cmds)
+		cmd->Exec();
+
+	const unsigned long long allocStart = tAllocations;
+	const auto start = std::chrono::steady_clock::now();
+	for (int idx = 0; idx < execs; ++idx)
+		cmds[idx % cmds.size()]->Exec();
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+
+	allocations = tAllocations - allocStart;
+	nsPerExec = std::chrono::duration<double, std::nano>(elapsed).count() / execs;
+}
+
+int
+main(int argc,
+	 char * argv[])
+{
+	SetAllocationHook(CountAllocation);
+	int execs = 1000000;
+	if (argc > 1)
+		execs = std::atoi(argv[1]);
+	if (execs < 1)
+	{
+		std::fprintf(stderr, "usage: %s [execs per thread]\n", argv[0]);
+		return 1;
+	}
+
+	NullMidiOutGenerator gen;
+	DynamicMidiCommand::InitDynamicData(&gen, MidiPortToDeviceIdxMap{ { 0, 0 } });
+	SetDynamicChannelCommand(9).Exec();
+	SetDynamicChannelRandomVelocityCommand(40, 127).Exec();
+
+	PatchCommands cmds;
+	cmds.push_back(std::make_shared<DynamicMidiCommand>(nullptr, Bytes{ 0x90, 36, 0 }, true, true));
+	cmds.push_back(std::make_shared<DynamicMidiCommand>(nullptr, Bytes{ 0x80, 36, 0 }, true, false));
+	cmds.push_back(std::make_shared<DynamicMidiCommand>(gen.mOut, Bytes{ 0xb0, 64, 127 }, true));
+	cmds.push_back(std::make_shared<DynamicMidiCommand>(gen.mOut, Bytes{ 0xc0, 5 }, true));
+
+	constexpr int kThreads = 2;
+	unsigned long long allocations[kThreads] = { };
+	double nsPerExec[kThreads] = { };
+	std::thread threads[kThreads];
+	for (int idx = 0; idx < kThreads; ++idx)
+		threads[idx] = std::thread(RunCommands, std::cref(cmds), execs, std::ref(allocations[idx]), std::ref(nsPerExec[idx]));
+	for (auto & thrd : threads)
+		thrd.join();
+
+	unsigned long long totalAllocations = 0;
+	for (int idx = 0; idx < kThreads; ++idx)
+	{
+		std::printf("thread %d: %d execs, %.1f ns per exec, %llu allocations\n", idx, execs, nsPerExec[idx], allocations[idx]);
+		totalAllocations += allocations[idx];
+	}
+
+	const unsigned long long noteOns = gen.mOut->mMessages / cmds.size();
+	std::printf("%llu messages, mean note on velocity %.1f\n", gen.mOut->mMessages.load(), 
+		noteOns ? (double)gen.mOut->mVelocities / noteOns : 0.0);
+
+	DynamicMidiCommand::ReleaseDynamicData();
+	return totalAllocations ? 1 : 0;
+}
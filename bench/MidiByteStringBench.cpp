@@ -0,0 +1,250 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+// MidiByteStringBench
+// ----------------------------------------------------------------------------
+// Sends every midiByteString of a config (and of the patch files it
+// imports) to a null output both ways a send can reach a backend: as Bytes,
+// which the backend splits into messages on every send, and pre-encoded at
+// load time (MidiCommandString).  Reports time and heap allocations per
+// send for each.
+//
+// usage: MidiByteStringBench [--data dir] [--rounds n] [config]
+//        defaults: 1000 rounds of axefx3v2
+//
+// One JSON object per line per path on stdout; a summary on stderr.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "../tinyxml/tinyxml.h"
+#include "../Engine/HexStringUtils.h"
+#include "CountingNew.h"
+#include "NullMidiOut.h"
+
+#ifndef MTROLL_DATA_DIR
+#define MTROLL_DATA_DIR "data"
+#endif
+
+
+using Clock = std::chrono::steady_clock;
+static unsigned long long sAllocations = 0;
+
+static void
+CountAllocation()
+{
+	++sAllocations;
+}
+
+
+// handles Bytes the way WinMidiOut and StreamMidiOut do, and counts what
+// would have been queued
+class EncodingMidiOut : public NullMidiOut
+{
+public:
+	// IMidiOut
+	virtual bool MidiOut(const Bytes & bytes, bool useIndicator) override
+	{
+		EncodedMidi msgs;
+		if (!msgs.Encode(bytes))
+			++mErrors;
+		return MidiOut(msgs, useIndicator);
+	}
+	virtual bool MidiOut(const EncodedMidi & msgs, bool) override
+	{
+		for (const auto & msg : msgs.GetMessages())
+			mWireBytes += msg.IsSysex() ? msg.mSysexLength : 1 + EncodedMidi::GetDataByteCount(msg.mEvent.GetStatus());
+		mMessages += msgs.MessageCount();
+		return true;
+	}
+	using NullMidiOut::MidiOut;
+
+	unsigned long long	mMessages = 0;
+	unsigned long long	mWireBytes = 0;
+	unsigned long long	mErrors = 0;
+};
+
+
+// midiByteStrings in the patches of a config or patches file, and in the
+// patches files it imports (relative to it, as EngineLoader resolves them)
+static bool
+LoadByteStrings(const std::string & file,
+				std::vector<Bytes> & strings)
+{
+	TiXmlDocument doc(file);
+	if (!doc.LoadFile() || !doc.RootElement())
+		return false;
+
+	const TiXmlElement * patches = doc.RootElement()->FirstChildElement("patches");
+	for (const TiXmlElement * elem = patches ? patches->FirstChildElement() : nullptr; elem; elem = elem->NextSiblingElement())
+	{
+		if (elem->ValueStr() == "importPatches")
+		{
+			if (!elem->GetText())
+				continue;
+
+			const std::string importFile((std::filesystem::path(file).parent_path() / elem->GetText()).string());
+			if (!LoadByteStrings(importFile, strings))
+				std::fprintf(stderr, "failed to load imported patches %s\n", importFile.c_str());
+			continue;
+		}
+
+		if (elem->ValueStr() != "patch")
+			continue;
+
+		for (const TiXmlElement * str = elem->FirstChildElement("midiByteString"); str; str = str->NextSiblingElement("midiByteString"))
+		{
+			Bytes bytes;
+			if (str->GetText() && -1 != ::ValidateString(str->GetText(), bytes) && !bytes.empty())
+				strings.push_back(std::move(bytes));
+		}
+	}
+
+	return true;
+}
+
+// name in the data directory, or a path
+static std::string
+ResolveConfig(const std::string & dataDir,
+			  const std::string & config)
+{
+	namespace fs = std::filesystem;
+	if (fs::exists(config))
+		return config;
+	if (fs::exists(dataDir + "/" + config + ".config.xml"))
+		return dataDir + "/" + config + ".config.xml";
+	return std::string();
+}
+
+struct PathResult
+{
+	double				mNsPerSend = 0;
+	double				mAllocationsPerSend = 0;
+};
+
+template<typename Send>
+static PathResult
+TimePath(const std::vector<Bytes> & strings,
+		 int rounds,
+		 Send && send)
+{
+	const size_t sends = strings.size() * rounds;
+	const unsigned long long allocStart = sAllocations;
+	const Clock::time_point start = Clock::now();
+	for (int round = 0; round < rounds; ++round)
+	{
+		for (size_t idx = 0; idx < strings.size(); ++idx)
+			send(idx);
+	}
+	const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+	PathResult result;
+	result.mNsPerSend = ns / sends;
+	result.mAllocationsPerSend = (double)(sAllocations - allocStart) / sends;
+	return result;
+}
+
+int
+main(int argc,
+	 char * argv[])
+{
+	SetAllocationHook(CountAllocation);
+	std::string dataDir(MTROLL_DATA_DIR);
+	std::string config("axefx3v2");
+	int rounds = 1000;
+	for (int idx = 1; idx < argc; ++idx)
+	{
+		if (!std::strcmp(argv[idx], "--data") && idx + 1 < argc)
+			dataDir = argv[++idx];
+		else if (!std::strcmp(argv[idx], "--rounds") && idx + 1 < argc)
+			rounds = std::atoi(argv[++idx]);
+		else if (argv[idx][0] == '-' || rounds < 1)
+		{
+			std::fprintf(stderr, "usage: %s [--data dir] [--rounds n] [config]\n", argv[0]);
+			return 1;
+		}
+		else
+			config = argv[idx];
+	}
+
+	const std::string configFile(ResolveConfig(dataDir, config));
+	std::vector<Bytes> strings;
+	if (configFile.empty() || !LoadByteStrings(configFile, strings))
+	{
+		std::fprintf(stderr, "failed to load config %s\n", config.c_str());
+		return 1;
+	}
+
+	if (strings.empty())
+	{
+		std::fprintf(stderr, "%s has no midiByteStrings\n", config.c_str());
+		return 1;
+	}
+
+	// what MidiCommandString holds, encoded as EngineLoader does at load
+	std::vector<EncodedMidi> encoded(strings.size());
+	for (size_t idx = 0; idx < strings.size(); ++idx)
+		encoded[idx].Encode(strings[idx]);
+
+	EncodingMidiOut out;
+	IMidiOut & midiOut = out;
+	const PathResult bytesPath(TimePath(strings, rounds, [&](size_t idx) { midiOut.MidiOut(strings[idx]); }));
+	const unsigned long long bytesMessages = out.mMessages;
+	const unsigned long long bytesWire = out.mWireBytes;
+
+	out.mMessages = out.mWireBytes = 0;
+	const PathResult encodedPath(TimePath(strings, rounds, [&](size_t idx) { midiOut.MidiOut(encoded[idx]); }));
+	if (out.mMessages != bytesMessages || out.mWireBytes != bytesWire || out.mErrors)
+	{
+		std::fprintf(stderr, "paths disagree: %llu/%llu messages, %llu/%llu bytes, %llu encode errors\n",
+			bytesMessages, out.mMessages, bytesWire, out.mWireBytes, out.mErrors);
+		return 1;
+	}
+
+	const size_t sends = strings.size() * rounds;
+	const double msgsPerSend = (double)bytesMessages / sends;
+	const double bytesPerSend = (double)bytesWire / sends;
+	const PathResult * results[] = { &bytesPath, &encodedPath };
+	const char * names[] = { "bytes", "encoded" };
+	for (int idx = 0; idx < 2; ++idx)
+	{
+		std::printf("{\"bench\":\"MidiByteString\",\"config\":\"%s\",\"path\":\"%s\",\"strings\":%zu,\"rounds\":%d,"
+			"\"messages_per_send\":%.2f,\"bytes_per_send\":%.1f,\"ns_per_send\":%.1f,\"allocations_per_send\":%.2f}\n",
+			config.c_str(), names[idx], strings.size(), rounds, msgsPerSend, bytesPerSend,
+			results[idx]->mNsPerSend, results[idx]->mAllocationsPerSend);
+	}
+
+	std::fprintf(stderr, "%s: %zu midiByteStrings (%.2f messages, %.1f bytes each), %d rounds\n"
+		"  Bytes, split per send: %.1f ns, %.2f allocations per send\n"
+		"  pre-encoded:           %.1f ns, %.2f allocations per send\n",
+		config.c_str(), strings.size(), msgsPerSend, bytesPerSend, rounds,
+		bytesPath.mNsPerSend, bytesPath.mAllocationsPerSend, encodedPath.mNsPerSend, encodedPath.mAllocationsPerSend);
+	return 0;
+}
@@ -0,0 +1,215 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+// MidiInReplayBench
+// ----------------------------------------------------------------------------
+// Replays a MIDI input capture (see the capture attribute of midiDevices)
+// into an AxeFx3Manager and a ControllerInputMonitor, with patches synced
+// to them on switches of a headless display, and reports throughput and
+// timing.
+// Without a capture file, a synthetic one is generated: 10 seconds of two
+// pedal sweeps, MIDI clock and Axe-Fx III status dumps.
+//
+// usage: MidiInReplayBench [capture file | -] [speed ...]
+//        speed 0 is as fast as possible; defaults: 0 1
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+#include <QCoreApplication>
+#include "../Engine/AxeFx3EffectIds.h"
+#include "../Engine/AxeFx3Manager.h"
+#include "../Engine/AxeTogglePatch.h"
+#include "../Engine/ControllerInputMonitor.h"
+#include "../Engine/MidiInCapture.h"
+#include "../midi/MidiInReplay.h"
+#include "../mTrollHeadless/HeadlessDisplay.h"
+
+
+// effect blocks with a sync patch, as in the axefx3v2 config
+static const char * kSyncedEffects[] = { "Compressor 1", "Amp 1", "Cabinet 1", "Drive 1", "Delay 1", "Reverb 1", "Chorus 1", "Phaser 1" };
+constexpr int kStatusDumpEffects = 60;
+
+class Counter : public IMidiInSubscriber
+{
+public:
+	virtual void ReceivedData(byte, byte, byte) override { ++mShortMsgs; }
+	virtual bool ReceivedSysex(const byte *, int) override { ++mSysex; return false; }
+	virtual void Closed(IMidiInPtr) override { }
+
+	unsigned long long	mShortMsgs = 0;
+	unsigned long long	mSysex = 0;
+};
+
+
+static std::string
+GenerateCapture()
+{
+	const std::string filename("MidiInReplayBench.midicap");
+	MidiInCaptureWriter writer;
+	if (!writer.Open(filename))
+		return std::string();
+
+	using Clock = MidiInCaptureWriter::Clock;
+	const Clock::time_point start(Clock::now());
+	std::vector<byte> dump;
+	for (int ms = 0; ms < 10000; ++ms)
+	{
+		const Clock::time_point now(start + std::chrono::milliseconds(ms));
+		// two pedals at 100 updates per second; one is watched
+		if (!(ms % 10))
+		{
+			const int val = (ms / 10) % 128;
+			writer.RecordData(1, now, 0xb0 | (7 << 8) | (val << 16));
+			writer.RecordData(1, now + std::chrono::microseconds(300), 0xb0 | (11 << 8) | ((127 - val) << 16));
+		}
+
+		// 120 bpm clock
+		if (!(ms % 21))
+			writer.RecordData(1, now + std::chrono::microseconds(500), 0xf8);
+
+		// status dump 25 times a second
+		if (!(ms % 40))
+		{
+			dump = { 0xf0, 0x00, 0x01, 0x74, 0x10, 0x13 };
+			for (int effect = 0; effect < kStatusDumpEffects; ++effect)
+			{
+				const int id = FractalAudio::AxeFx3::ID_INPUT1 + effect;
+				dump.push_back((byte)(id & 0x7f));
+				dump.push_back((byte)((id >> 7) & 0x7f));
+				dump.push_back((byte)((ms / 40 + effect) & 0x7f));
+			}
+
+			byte checksum = 0;
+			for (byte cur : dump)
+				checksum ^= cur;
+			dump.push_back(checksum & 0x7f);
+			dump.push_back(0xf7);
+			writer.RecordSysex(1, now + std::chrono::microseconds(800), dump);
+		}
+	}
+
+	writer.Close();
+	return filename;
+}
+
+int
+main(int argc,
+	 char * argv[])
+{
+	QCoreApplication app(argc, argv);
+	std::string filename;
+	if (argc > 1 && std::string(argv[1]) != "-")
+		filename = argv[1];
+	std::vector<double> speeds;
+	for (int idx = 2; idx < argc; ++idx)
+		speeds.push_back(std::atof(argv[idx]));
+	if (speeds.empty())
+		speeds = { 0, 1 };
+
+	if (filename.empty())
+	{
+		filename = GenerateCapture();
+		if (filename.empty())
+		{
+			std::fprintf(stderr, "failed to write synthetic capture\n");
+			return 1;
+		}
+		std::printf("generated synthetic capture %s\n", filename.c_str());
+	}
+
+	MidiInCaptureReader capture;
+	std::string errMsg;
+	if (!capture.Load(filename, errMsg))
+	{
+		std::fprintf(stderr, "%s\n", errMsg.c_str());
+		return 1;
+	}
+
+	std::map<int, size_t> portEvents;
+	for (const auto & evt : capture.GetEvents())
+		++portEvents[evt.mPort];
+
+	const double captureSeconds = capture.GetEvents().empty() ? 0 : capture.GetEvents().back().mTimeUs / 1000000.0;
+	std::printf("%zu events over %.2f s\n", capture.GetEvents().size(), captureSeconds);
+
+	for (double speed : speeds)
+	{
+		HeadlessDisplay display;
+		int patchNumber = 0;
+		int switchNumber = 0;
+
+		auto axeMgr = std::make_shared<AxeFx3Manager>(&display, &display, &display, std::string(), 0, Axe3);
+		for (const char * effect : kSyncedEffects)
+		{
+			PatchCommands cmdsA, cmdsB;
+			auto patch = std::make_shared<AxeTogglePatch>(++patchNumber, effect, nullptr, cmdsA, cmdsB, axeMgr);
+			patch->AssignSwitch(switchNumber++, &display);
+			axeMgr->SetSyncPatch(patch, 0, 0);
+		}
+
+		// the synthetic pedal on controller 7 is watched; the one on 11 isn't
+		auto monitor = std::make_shared<ControllerInputMonitor>(&display, &display);
+		for (int ctrl = 1; ctrl < 64; ctrl += 3)
+		{
+			auto patch = std::make_shared<ControllerTogglePatch>(++patchNumber, "cc " + std::to_string(ctrl), nullptr, 0, ctrl);
+			patch->AssignSwitch(switchNumber++, &display);
+			monitor->AddPatch(patch, 0, ctrl);
+		}
+
+		auto counter = std::make_shared<Counter>();
+		MidiInReplay replay;
+		for (const auto & port : portEvents)
+		{
+			replay.Subscribe(port.first, axeMgr);
+			replay.Subscribe(port.first, monitor);
+			replay.Subscribe(port.first, counter);
+		}
+
+		display.ResetCounts();
+
+		const MidiInReplay::Stats stats(replay.Run(capture, speed));
+		if (speed > 0)
+			std::printf("\nspeed %gx:\n", speed);
+		else
+			std::printf("\nmax speed:\n");
+		std::printf("  %llu events (%llu sysex bytes) in %.1f ms: %.0f events/s\n", stats.mEvents, stats.mSysexBytes, 
+			stats.mElapsedUs / 1000.0, stats.mElapsedUs ? stats.mEvents * 1000000.0 / stats.mElapsedUs : 0.0);
+		std::printf("  routing + subscribers: avg %.0f ns, max %.1f us per event\n", 
+			stats.mEvents ? (double)stats.mTotalRouteNs / stats.mEvents : 0.0, stats.mMaxRouteNs / 1000.0);
+		if (speed > 0)
+			std::printf("  max lateness versus capture timing: %u us\n", stats.mMaxLateUs);
+		const HeadlessDisplay::Counts counts(display.GetCounts());
+		std::printf("  %llu short, %llu sysex; %u LED updates, %u traces (%u errors)\n",
+			counter->mShortMsgs, counter->mSysex, counts.mLedUpdates, counts.mTraces, counts.mErrors);
+
+		axeMgr->Shutdown();
+	}
+
+	return 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#ifndef NullMidiOut_h__
+#define NullMidiOut_h__
+
+#include "../Engine/IMidiOut.h"
+
+
+// NullMidiOut
+// ----------------------------------------------------------------------------
+// IMidiOut for benches that don't need a port: always open, accepts
+// everything and sends nothing.  Benches override what they measure.
+//
+class NullMidiOut : public IMidiOut
+{
+public:
+	// IMidiOut
+	virtual unsigned int GetMidiOutDeviceCount() const override { return 1; }
+	virtual std::string GetMidiOutDeviceName(unsigned int) const override { return "null"; }
+	virtual std::string GetMidiOutDeviceName() const override { return "null"; }
+	virtual void SetActivityIndicator(ISwitchDisplay *, int, unsigned int) override { }
+	virtual void EnableActivityIndicator(bool) override { }
+	virtual bool OpenMidiOut(unsigned int) override { return true; }
+	virtual bool IsMidiOutOpen() const override { return true; }
+	virtual bool MidiOut(const Bytes &, bool = true) override { return true; }
+	virtual bool MidiOut(const EncodedMidi &, bool = true) override { return true; }
+	virtual bool MidiOutBatch(std::span<const EncodedMidi * const>, bool = true) override { return true; }
+	virtual void MidiOut(MidiEvent, bool = true) override { }
+	virtual void ControlChangeLatestValue(byte, byte, byte, bool = true) override { }
+	virtual void ControlChange14LatestValue(byte, byte, byte, byte, bool = true) override { }
+	virtual void EnableRunningStatus(bool) override { }
+	virtual void SetBandwidth(unsigned int) override { }
+	virtual void EnableShadowState(unsigned int, int = -1) override { }
+	virtual void ResetShadowState(int) override { }
+	virtual MidiShadowStats GetShadowStats() const override { return MidiShadowStats(); }
+	virtual void EnableMidiClock(bool) override { }
+	virtual bool IsMidiClockEnabled() override { return false; }
+	virtual void SetTempo(int) override { }
+	virtual int GetTempo() const override { return 120; }
+	virtual MidiClockStats GetMidiClockStats() const override { return MidiClockStats(); }
+	virtual bool SuspendMidiOut() override { return true; }
+	virtual bool ResumeMidiOut() override { return true; }
+	virtual void CloseMidiOut() override { }
+};
+
+#endif // NullMidiOut_h__
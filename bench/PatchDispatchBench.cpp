@@ -0,0 +1,238 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+// PatchDispatchBench
+// ----------------------------------------------------------------------------
+// Times PatchBank press and release dispatch: each bank of a config is
+// loaded into the headless host and then every switch is pressed and
+// released directly on the bank, with no displays, for a number of rounds.
+// The default config is generated: 60 switches per bank, each with three
+// stacked toggle patches that send nothing, an exclusive group on the
+// first eight switches and a secondary function on switches 41-48, so
+// that nearly all of the time is spent in PatchBank and Patch.
+// Other configs (names in the data directory or paths) can be given; their
+// sequence patches are skipped since they block on delays.
+//
+// usage: PatchDispatchBench [--data dir] [--rounds n] [config ...]
+//
+// One JSON object per line per config on stdout; a summary on stderr.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <QCoreApplication>
+#include "../Engine/MidiControlEngine.h"
+#include "../Engine/PatchBank.h"
+#include "../Engine/Patch.h"
+#include "../mTrollHeadless/HeadlessDisplay.h"
+#include "../mTrollHeadless/HeadlessHost.h"
+
+#ifndef MTROLL_DATA_DIR
+#define MTROLL_DATA_DIR "data"
+#endif
+
+
+using Clock = std::chrono::steady_clock;
+constexpr int kDenseSwitches = 60;
+constexpr int kDenseStack = 3;
+constexpr int kDenseBanks = 4;
+
+
+// writes the generated config
+static std::string
+WriteDenseConfig()
+{
+	const std::string configFile((std::filesystem::temp_directory_path() / "mTrollBench.dense.config.xml").string());
+	std::ofstream config(configFile);
+	config << "<?xml version=\"1.0\" ?>\n<MidiControlSettings>\n"
+		"\t<SystemConfig>\n"
+		"\t\t<switches>\n"
+		"\t\t\t<switch command=\"menu\" id=\"62\" />\n"
+		"\t\t\t<switch command=\"decrement\" id=\"63\" />\n"
+		"\t\t\t<switch command=\"increment\" id=\"64\" />\n"
+		"\t\t</switches>\n"
+		"\t\t<midiDevices>\n"
+		"\t\t\t<midiDevice port=\"1\" outIdx=\"0\" />\n"
+		"\t\t</midiDevices>\n"
+		"\t</SystemConfig>\n"
+		"\t<patches>\n";
+	for (int idx = 1; idx <= kDenseSwitches * kDenseStack + 8; ++idx)
+		config << "\t\t<patch name=\"Toggle " << idx << "\" type=\"toggle\" port=\"1\" />\n";
+	config << "\t</patches>\n\t<banks>\n";
+	for (int bnk = 1; bnk <= kDenseBanks; ++bnk)
+	{
+		config << "\t\t<bank name=\"Dense " << bnk << "\">\n"
+			"\t\t\t<ExclusiveSwitchGroup>1 2 3 4 5 6 7 8</ExclusiveSwitchGroup>\n";
+		for (int sw = 1; sw <= kDenseSwitches; ++sw)
+		{
+			for (int stack = 0; stack < kDenseStack; ++stack)
+				config << "\t\t\t<switch number=\"" << sw << "\" patchName=\"Toggle " << (sw - 1) * kDenseStack + stack + 1 << "\" />\n";
+			if (sw > 40 && sw <= 48)
+				config << "\t\t\t<switch number=\"" << sw << "\" patchName=\"Toggle " << kDenseSwitches * kDenseStack + sw - 40 << "\" secondFunction=\"manual\" />\n";
+		}
+		config << "\t\t</bank>\n";
+	}
+	config << "\t</banks>\n</MidiControlSettings>\n";
+	return config ? configFile : std::string();
+}
+
+// name in the data directory, or a path
+static std::string
+ResolveConfig(const std::string & dataDir,
+			  const std::string & config)
+{
+	namespace fs = std::filesystem;
+	if (config == "dense")
+		return WriteDenseConfig();
+	if (fs::exists(config))
+		return config;
+	if (fs::exists(dataDir + "/" + config + ".config.xml"))
+		return dataDir + "/" + config + ".config.xml";
+	if (fs::exists(dataDir + "/" + config + "/" + config + ".config.xml"))
+		return dataDir + "/" + config + "/" + config + ".config.xml";
+	return std::string();
+}
+
+static bool
+IsTimedSwitch(const PatchBankPtr & bank,
+			  int switchNumber)
+{
+	PatchPtr patch = bank->GetSwitchPatch(switchNumber);
+	if (!patch)
+		return false;
+
+	const std::string patchType(patch->GetPatchTypeStr());
+	return patchType != "sequence" && patchType != "patchListSequence";
+}
+
+// ns per press and release pair, one sample per bank per round
+static std::vector<double>
+RunDispatch(HeadlessHost & host,
+			int rounds,
+			unsigned int & pairsPerRound)
+{
+	MidiControlEnginePtr engine = host.GetEngine();
+	const int modeSwitch = engine->GetModeSwitchNumber();
+	std::vector<double> samples;
+	pairsPerRound = 0;
+
+	const MidiControlEngine::Banks banks(engine->GetBanksInNavOrder());
+	for (const PatchBankPtr & bank : banks)
+	{
+		engine->LoadBankByNumber(bank->GetBankNumber());
+		host.ProcessEvents();
+
+		std::vector<int> switches;
+		for (const int sw : bank->GetSwitchNumbers())
+		{
+			if (sw != modeSwitch && IsTimedSwitch(bank, sw))
+				switches.push_back(sw);
+		}
+		if (switches.empty())
+			continue;
+
+		pairsPerRound += (unsigned int)switches.size();
+		for (int round = 0; round < rounds; ++round)
+		{
+			const Clock::time_point start = Clock::now();
+			for (const int sw : switches)
+			{
+				bank->PatchSwitchPressed(sw, nullptr, nullptr);
+				bank->PatchSwitchReleased(sw, nullptr, nullptr, PatchBank::spdShort);
+			}
+			const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+			samples.push_back(ns / switches.size());
+		}
+		host.ProcessEvents();
+	}
+
+	return samples;
+}
+
+int
+main(int argc,
+	 char * argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	std::string dataDir(MTROLL_DATA_DIR);
+	int rounds = 2000;
+	std::vector<std::string> configs;
+	for (int idx = 1; idx < argc; ++idx)
+	{
+		if (!std::strcmp(argv[idx], "--data") && idx + 1 < argc)
+			dataDir = argv[++idx];
+		else if (!std::strcmp(argv[idx], "--rounds") && idx + 1 < argc)
+			rounds = std::atoi(argv[++idx]);
+		else if (argv[idx][0] == '-' || rounds < 1)
+		{
+			std::fprintf(stderr, "usage: %s [--data dir] [--rounds n] [config ...]\n", argv[0]);
+			return 1;
+		}
+		else
+			configs.push_back(argv[idx]);
+	}
+
+	if (configs.empty())
+		configs = { "dense" };
+
+	int failures = 0;
+	for (const std::string & config : configs)
+	{
+		const std::string configFile(ResolveConfig(dataDir, config));
+		HeadlessDisplay display;
+		HeadlessHost host(&display, dataDir);
+		if (configFile.empty() || !host.Load(configFile))
+		{
+			std::fprintf(stderr, "failed to load config %s\n", config.c_str());
+			++failures;
+			continue;
+		}
+
+		unsigned int pairs = 0;
+		std::vector<double> samples(RunDispatch(host, rounds, pairs));
+		host.Unload();
+		if (samples.empty())
+			continue;
+
+		std::sort(samples.begin(), samples.end());
+		const double p50 = samples[samples.size() / 2];
+		const double p99 = samples[(size_t)(0.99 * (samples.size() - 1) + 0.5)];
+		std::printf("{\"bench\":\"PatchDispatch\",\"config\":\"%s\",\"switches\":%u,\"rounds\":%d,"
+			"\"min_ns\":%.1f,\"p50_ns\":%.1f,\"p99_ns\":%.1f}\n",
+			config.c_str(), pairs, rounds, samples.front(), p50, p99);
+		std::fprintf(stderr, "%s: %u switches, %d rounds: press+release min %.1f ns, p50 %.1f ns, p99 %.1f ns\n",
+			config.c_str(), pairs, rounds, samples.front(), p50, p99);
+	}
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,591 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+// SwitchLatencyBench
+// ----------------------------------------------------------------------------
+// Loads configs into the headless host with loopback MIDI outs and, for each
+// switch event, measures the time from the MidiControlEngine call to the
+// last byte written to a loopback port and counts the heap allocations made
+// (on any thread; global operator new is replaced, see CountingNew) in that time.  Those made
+// by the headless display, which only records what a UI would show, are
+// counted separately from those of the engine and MIDI threads.
+// Per config: a load of each bank; presses and releases of each normal,
+// toggle, momentary, sequence and patchListSequence switch in the bank;
+// and long-presses of switches that have a secondary function (released
+// after 350 ms; the release is what is timed).
+// An event is over once nothing has been written for the quiet time (the
+// MIDI clock is ignored), so patches with delays longer than that are cut
+// short.  Events that write nothing are counted but have no latency.
+// Patch files with no banks (edp, microcosm) are wrapped in a generated
+// config that puts their patches on switches 1-16 of as many banks as
+// needed.
+// The config named transitions is generated: banks that share a pool of
+// toggle patches and set them with loadState on bank load (as with banks
+// used as scenes), and that each load an amp setting that is mostly the
+// same as the bank before, to exercise bank transitions.
+// With --shadow, generated configs enable device shadow state on their port
+// and the sends it suppressed are reported.
+//
+// usage: SwitchLatencyBench [--data dir] [--quiet ms] [--presses n] [--shadow] [config ...]
+//        configs are names in the data directory or paths; default:
+//        axefx3v2 edp microcosm testdata transitions
+//
+// One JSON object per line per config and event kind on stdout, for trend
+// tracking; a readable summary on stderr.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include <QCoreApplication>
+#include "../Engine/MidiControlEngine.h"
+#include "../Engine/PatchBank.h"
+#include "../Engine/Patch.h"
+#include "../midi/LoopbackMidi.h"
+#include "../mTrollHeadless/HeadlessDisplay.h"
+#include "../mTrollHeadless/HeadlessHost.h"
+#include "../tinyxml/tinyxml.h"
+#include "CountingNew.h"
+
+#ifndef MTROLL_DATA_DIR
+#define MTROLL_DATA_DIR "data"
+#endif
+
+
+static std::atomic<unsigned long long> sAllocations{0};
+static std::atomic<unsigned long long> sDisplayAllocations{0};
+static thread_local int tInDisplay = 0;	// depth of CountingDisplay calls
+
+static void
+CountAllocation()
+{
+	(tInDisplay ? sDisplayAllocations : sAllocations).fetch_add(1, std::memory_order_relaxed);
+}
+
+
+using Clock = std::chrono::steady_clock;
+constexpr auto kMaxSettle = std::chrono::seconds(2);
+constexpr int kLongPressMs = 350;
+constexpr int kMaxLongPressSwitches = 8;
+constexpr int kWrapperBankSize = 16;
+constexpr int kTransitionBanks = 8;
+constexpr int kTransitionSharedPatches = 12;
+
+
+// attributes the allocations made while recording display updates to the
+// display
+class CountingDisplay : public HeadlessDisplay
+{
+	struct InDisplay
+	{
+		InDisplay() { ++tInDisplay; }
+		~InDisplay() { --tInDisplay; }
+	};
+
+public:
+	virtual void TextOut(const std::string & txt) override { InDisplay in; HeadlessDisplay::TextOut(txt); }
+	virtual void AppendText(const std::string & text) override { InDisplay in; HeadlessDisplay::AppendText(text); }
+	virtual void ClearDisplay() override { InDisplay in; HeadlessDisplay::ClearDisplay(); }
+	virtual void TransientTextOut(const std::string & txt) override { InDisplay in; HeadlessDisplay::TransientTextOut(txt); }
+	virtual void ClearTransientText() override { InDisplay in; HeadlessDisplay::ClearTransientText(); }
+	virtual std::string GetCurrentText() override { InDisplay in; return HeadlessDisplay::GetCurrentText(); }
+	virtual std::string GetQueuedText() override { InDisplay in; return HeadlessDisplay::GetQueuedText(); }
+	virtual void SetSwitchDisplay(int switchNumber, unsigned int color) override { InDisplay in; HeadlessDisplay::SetSwitchDisplay(switchNumber, color); }
+	virtual void TurnOffSwitchDisplay(int switchNumber) override { InDisplay in; HeadlessDisplay::TurnOffSwitchDisplay(switchNumber); }
+	virtual void ForceSwitchDisplay(int switchNumber, unsigned int color) override { InDisplay in; HeadlessDisplay::ForceSwitchDisplay(switchNumber, color); }
+	virtual void DimSwitchDisplay(int switchNumber, unsigned int ledColor) override { InDisplay in; HeadlessDisplay::DimSwitchDisplay(switchNumber, ledColor); }
+	virtual void SetSwitchText(int switchNumber, const std::string & txt) override { InDisplay in; HeadlessDisplay::SetSwitchText(switchNumber, txt); }
+	virtual void ClearSwitchText(int switchNumber) override { InDisplay in; HeadlessDisplay::ClearSwitchText(switchNumber); }
+	virtual void SetIndicatorThreadSafe(bool isOn, PatchPtr patch, int time) override { InDisplay in; HeadlessDisplay::SetIndicatorThreadSafe(isOn, patch, time); }
+	virtual void Trace(const std::string & txt) override { InDisplay in; HeadlessDisplay::Trace(txt); }
+};
+
+
+// timestamps every write to a loopback port
+class WireTimer : public ILoopbackWireTap
+{
+public:
+	virtual void WireBytes(unsigned int, const byte * data, size_t len) override
+	{
+		// clock and active sensing run on their own; they aren't a
+		// response to a switch
+		if (1 == len && (0xF8 == data[0] || 0xFE == data[0]))
+			return;
+
+		mBytes.fetch_add(len, std::memory_order_relaxed);
+		mLastWrite.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+		mWrites.fetch_add(1, std::memory_order_release);
+	}
+
+	unsigned long long GetWrites() const { return mWrites.load(std::memory_order_acquire); }
+	unsigned long long GetBytes() const { return mBytes.load(std::memory_order_relaxed); }
+	Clock::time_point GetLastWrite() const { return Clock::time_point(Clock::duration(mLastWrite.load(std::memory_order_relaxed))); }
+
+private:
+	std::atomic<unsigned long long>	mWrites{0};
+	std::atomic<unsigned long long>	mBytes{0};
+	std::atomic<Clock::rep>			mLastWrite{0};
+};
+
+
+struct EventStats
+{
+	std::vector<double>		mLatencyUs;		// events that wrote something
+	unsigned int			mEvents = 0;
+	unsigned int			mSilent = 0;	// events that wrote nothing
+	unsigned long long		mAllocations = 0;	// engine and MIDI threads
+	unsigned long long		mMaxAllocations = 0;
+	unsigned long long		mDisplayAllocations = 0;
+	unsigned long long		mBytes = 0;
+};
+
+using Results = std::map<std::string, EventStats>;	// event kind is key
+
+
+class LatencyRun
+{
+public:
+	LatencyRun(HeadlessHost & host, 
+			   WireTimer & wire, 
+			   int quietMs) :
+		mHost(host),
+		mWire(wire),
+		mQuiet(std::chrono::milliseconds(quietMs))
+	{
+	}
+
+	const Results & GetResults() const { return mResults; }
+
+	// waits for output from whatever came before to finish
+	void Settle()
+	{
+		unsigned long long writes = mWire.GetWrites();
+		const Clock::time_point start = Clock::now();
+		Clock::time_point quietSince = start;
+		for (;;)
+		{
+			mHost.ProcessEvents();
+			const Clock::time_point now = Clock::now();
+			const unsigned long long curWrites = mWire.GetWrites();
+			if (curWrites != writes)
+			{
+				writes = curWrites;
+				quietSince = now;
+			}
+			else if (now - quietSince >= mQuiet || now - start >= kMaxSettle)
+				break;
+
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		}
+	}
+
+	template<typename TEvent>
+	void Measure(const std::string & kind, 
+				 TEvent event)
+	{
+		EventStats & stats = mResults[kind];
+		if (stats.mLatencyUs.capacity() == stats.mLatencyUs.size())
+			stats.mLatencyUs.reserve(stats.mLatencyUs.size() * 2 + 64);
+
+		const unsigned long long writes = mWire.GetWrites();
+		const unsigned long long bytes = mWire.GetBytes();
+		const unsigned long long allocations = sAllocations.load(std::memory_order_relaxed);
+		const unsigned long long displayAllocations = sDisplayAllocations.load(std::memory_order_relaxed);
+		const Clock::time_point start = Clock::now();
+		event();
+		Settle();
+		const unsigned long long eventAllocations = sAllocations.load(std::memory_order_relaxed) - allocations;
+
+		++stats.mEvents;
+		stats.mAllocations += eventAllocations;
+		stats.mDisplayAllocations += sDisplayAllocations.load(std::memory_order_relaxed) - displayAllocations;
+		stats.mMaxAllocations = std::max(stats.mMaxAllocations, eventAllocations);
+		if (mWire.GetWrites() == writes)
+		{
+			++stats.mSilent;
+			return;
+		}
+
+		stats.mBytes += mWire.GetBytes() - bytes;
+		stats.mLatencyUs.push_back(std::chrono::duration<double, std::micro>(mWire.GetLastWrite() - start).count());
+	}
+
+private:
+	HeadlessHost			& mHost;
+	WireTimer				& mWire;
+	const Clock::duration	mQuiet;
+	Results					mResults;
+};
+
+
+// the kinds of patch that are timed, by GetPatchTypeStr
+static const char *
+PatchKind(const std::string & patchType)
+{
+	if (patchType == "normal" || patchType == "groupNormal")
+		return "normal";
+	if (patchType == "toggle" || patchType == "axeToggle")
+		return "toggle";
+	if (patchType == "momentary" || patchType == "axeMomentary")
+		return "momentary";
+	if (patchType == "sequence")
+		return "sequence";
+	if (patchType == "patchListSequence")
+		return "patchListSequence";
+	return nullptr;
+}
+
+static void
+RunEvents(HeadlessHost & host,
+		  LatencyRun & run,
+		  int presses)
+{
+	MidiControlEnginePtr engine = host.GetEngine();
+	const int modeSwitch = engine->GetModeSwitchNumber();
+	int longPressSwitches = 0;
+	run.Settle();
+
+	// copy; bank loads don't change the list, but be safe
+	const MidiControlEngine::Banks banks(engine->GetBanksInNavOrder());
+	for (const PatchBankPtr & bank : banks)
+	{
+		run.Measure("bankLoad", [&]() { engine->LoadBankByNumber(bank->GetBankNumber()); });
+
+		for (const int sw : bank->GetSwitchNumbers())
+		{
+			if (sw == modeSwitch)
+				continue;
+
+			PatchPtr patch = bank->GetSwitchPatch(sw);
+			const char * kind = patch ? PatchKind(patch->GetPatchTypeStr()) : nullptr;
+			if (kind)
+			{
+				const std::string pressKind(std::string(kind) + ".press");
+				const std::string releaseKind(std::string(kind) + ".release");
+				for (int idx = 0; idx < presses; ++idx)
+				{
+					run.Measure(pressKind, [&]() { engine->SwitchPressed(sw); });
+					run.Measure(releaseKind, [&]() { engine->SwitchReleased(sw); });
+				}
+			}
+
+			if (bank->GetSwitchPatch(sw, PatchBank::ssSecondary) && longPressSwitches < kMaxLongPressSwitches)
+			{
+				// to the secondary function and back
+				++longPressSwitches;
+				for (int idx = 0; idx < 2; ++idx)
+				{
+					engine->SwitchPressed(sw);
+					host.Wait(kLongPressMs);
+					run.Measure("longPress.release", [&]() { engine->SwitchReleased(sw); });
+				}
+			}
+		}
+	}
+}
+
+
+static std::string
+XmlEscape(const std::string & str)
+{
+	std::string escaped;
+	for (const char ch : str)
+	{
+		switch (ch)
+		{
+		case '&':	escaped += "&amp;";		break;
+		case '<':	escaped += "&lt;";		break;
+		case '>':	escaped += "&gt;";		break;
+		case '"':	escaped += "&quot;";	break;
+		default:	escaped += ch;
+		}
+	}
+	return escaped;
+}
+
+static const char *
+MidiDeviceAttributes(bool shadowState)
+{
+	return shadowState ? "port=\"1\" outIdx=\"0\" shadowState=\"1\"" : "port=\"1\" outIdx=\"0\"";
+}
+
+// writes a config that imports patchesFile and maps its patches to switches
+static std::string
+WrapPatchesFile(const std::string & patchesFile, 
+				const std::string & name,
+				bool shadowState)
+{
+	TiXmlDocument doc(patchesFile);
+	if (!doc.LoadFile())
+		return std::string();
+
+	std::vector<std::string> patchNames;
+	std::vector<std::string> devices;
+	TiXmlHandle hDoc(&doc);
+	for (TiXmlElement * patch = hDoc.FirstChildElement("MidiControlSettings").FirstChildElement("patches").FirstChildElement("patch").ToElement();
+		patch;
+		patch = patch->NextSiblingElement("patch"))
+	{
+		if (const char * patchName = patch->Attribute("name"))
+			patchNames.push_back(patchName);
+		const char * device = patch->Attribute("device");
+		if (device && std::find(devices.begin(), devices.end(), device) == devices.end())
+			devices.push_back(device);
+	}
+
+	const std::string configFile((std::filesystem::temp_directory_path() / ("mTrollBench." + name + ".config.xml")).string());
+	std::ofstream config(configFile);
+	config << "<?xml version=\"1.0\" ?>\n<MidiControlSettings>\n\t<DeviceChannelMap>\n";
+	for (size_t idx = 0; idx < devices.size() && idx < 16; ++idx)
+		config << "\t\t<Device channel=\"" << idx + 1 << "\">" << XmlEscape(devices[idx]) << "</Device>\n";
+	config << "\t</DeviceChannelMap>\n"
+		"\t<SystemConfig>\n"
+		"\t\t<switches>\n"
+		"\t\t\t<switch command=\"menu\" id=\"20\" />\n"
+		"\t\t\t<switch command=\"decrement\" id=\"21\" />\n"
+		"\t\t\t<switch command=\"increment\" id=\"22\" />\n"
+		"\t\t</switches>\n"
+		"\t\t<midiDevices>\n"
+		"\t\t\t<midiDevice " << MidiDeviceAttributes(shadowState) << " />\n"
+		"\t\t</midiDevices>\n"
+		"\t</SystemConfig>\n"
+		"\t<patches>\n"
+		"\t\t<importPatches>" << XmlEscape(std::filesystem::absolute(patchesFile).string()) << "</importPatches>\n"
+		"\t</patches>\n"
+		"\t<banks>\n";
+	for (size_t idx = 0; idx < patchNames.size(); ++idx)
+	{
+		if (0 == idx % kWrapperBankSize)
+		{
+			if (idx)
+				config << "\t\t</bank>\n";
+			config << "\t\t<bank name=\"" << name << " " << idx / kWrapperBankSize + 1 << "\">\n";
+		}
+		config << "\t\t\t<switch number=\"" << idx % kWrapperBankSize + 1 << "\" patchName=\"" << XmlEscape(patchNames[idx]) << "\" />\n";
+	}
+	if (!patchNames.empty())
+		config << "\t\t</bank>\n";
+	config << "\t</banks>\n</MidiControlSettings>\n";
+	return config ? configFile : std::string();
+}
+
+// writes the transitions config: each bank sets every patch of a shared
+// pool on or off at load, has one patch of its own that is on only while
+// the bank is loaded, and turns on an amp setting (a toggle, so its control
+// changes are states the shadow can drop) on another channel
+static std::string
+WriteTransitionsConfig(bool shadowState)
+{
+	const std::string configFile((std::filesystem::temp_directory_path() / "mTrollBench.transitions.config.xml").string());
+	std::ofstream config(configFile);
+	config << "<?xml version=\"1.0\" ?>\n<MidiControlSettings>\n"
+		"\t<SystemConfig>\n"
+		"\t\t<switches>\n"
+		"\t\t\t<switch command=\"menu\" id=\"20\" />\n"
+		"\t\t\t<switch command=\"decrement\" id=\"21\" />\n"
+		"\t\t\t<switch command=\"increment\" id=\"22\" />\n"
+		"\t\t</switches>\n"
+		"\t\t<midiDevices>\n"
+		"\t\t\t<midiDevice " << MidiDeviceAttributes(shadowState) << " />\n"
+		"\t\t</midiDevices>\n"
+		"\t</SystemConfig>\n"
+		"\t<patches>\n";
+	char cc[32];
+	for (int idx = 0; idx < kTransitionSharedPatches + kTransitionBanks; ++idx)
+	{
+		std::snprintf(cc, sizeof(cc), "b0 %02x", 20 + idx);
+		config << "\t\t<patch name=\"Fx " << idx + 1 << "\" type=\"toggle\" port=\"1\">\n"
+			"\t\t\t<midiByteString name=\"A\">" << cc << " 7f</midiByteString>\n"
+			"\t\t\t<midiByteString name=\"B\">" << cc << " 00</midiByteString>\n"
+			"\t\t</patch>\n";
+	}
+	for (int bnk = 0; bnk < kTransitionBanks; ++bnk)
+	{
+		// volume changes halfway through; tone stays put
+		std::snprintf(cc, sizeof(cc), "b1 07 %02x", bnk < kTransitionBanks / 2 ? 100 : 90);
+		config << "\t\t<patch name=\"Amp " << bnk + 1 << "\" type=\"toggle\" port=\"1\">\n"
+			"\t\t\t<midiByteString name=\"A\">" << cc << " b1 0e 40 b1 0f 30</midiByteString>\n"
+			"\t\t\t<midiByteString name=\"B\">b1 07 00</midiByteString>\n"
+			"\t\t</patch>\n";
+	}
+	config << "\t</patches>\n\t<banks>\n";
+	for (int bnk = 0; bnk < kTransitionBanks; ++bnk)
+	{
+		config << "\t\t<bank name=\"Scene " << bnk + 1 << "\">\n";
+		for (int sw = 0; sw < kTransitionSharedPatches; ++sw)
+		{
+			// neighbouring banks differ in a few patches
+			const bool on = ((bnk >> (sw % 3)) + sw) % 2 != 0;
+			config << "\t\t\t<switch number=\"" << sw + 1 << "\" patchName=\"Fx " << sw + 1 << "\" loadState=\"" << (on ? "A" : "B") << "\" />\n";
+		}
+		config << "\t\t\t<switch number=\"" << kTransitionSharedPatches + 1 << "\" patchName=\"Fx " << kTransitionSharedPatches + bnk + 1 << "\" loadState=\"A\" unloadState=\"B\" />\n"
+			"\t\t\t<switch number=\"" << kTransitionSharedPatches + 2 << "\" patchName=\"Amp " << bnk + 1 << "\" loadState=\"A\" />\n"
+			"\t\t</bank>\n";
+	}
+	config << "\t</banks>\n</MidiControlSettings>\n";
+	return config ? configFile : std::string();
+}
+
+// name in the data directory, or a path
+static std::string
+ResolveConfig(const std::string & dataDir, 
+			  const std::string & config,
+			  bool shadowState)
+{
+	namespace fs = std::filesystem;
+	const std::string kPatchesExt(".patchesConfig.xml");
+	std::string file;
+	if (config == "transitions")
+		return WriteTransitionsConfig(shadowState);
+	if (fs::exists(config))
+		file = config;
+	else if (fs::exists(dataDir + "/" + config + ".config.xml"))
+		file = dataDir + "/" + config + ".config.xml";
+	else if (fs::exists(dataDir + "/" + config + "/" + config + ".config.xml"))
+		file = dataDir + "/" + config + "/" + config + ".config.xml";
+	else if (fs::exists(dataDir + "/" + config + kPatchesExt))
+		file = dataDir + "/" + config + kPatchesExt;
+	else
+		return std::string();
+
+	if (file.size() > kPatchesExt.size() && 0 == file.compare(file.size() - kPatchesExt.size(), kPatchesExt.size(), kPatchesExt))
+		return WrapPatchesFile(file, fs::path(file).filename().string().substr(0, fs::path(file).filename().string().size() - kPatchesExt.size()), shadowState);
+	return file;
+}
+
+static double
+Percentile(const std::vector<double> & sorted,
+		   double pct)
+{
+	if (sorted.empty())
+		return 0;
+	const size_t idx = (size_t)(pct / 100.0 * (sorted.size() - 1) + 0.5);
+	return sorted[idx];
+}
+
+static void
+Report(const std::string & config,
+	   const Results & results,
+	   const HeadlessDisplay::Counts & counts)
+{
+	std::fprintf(stderr, "\n%s: %u traces (%u errors)\n", config.c_str(), counts.mTraces, counts.mErrors);
+	std::fprintf(stderr, "  %-26s %7s %7s %9s %9s %9s %9s %11s %8s\n", "event", "count", "silent", "p50 us", "p99 us", "max us", "allocs", "disp allocs", "bytes");
+	for (const auto & cur : results)
+	{
+		const EventStats & stats = cur.second;
+		std::vector<double> sorted(stats.mLatencyUs);
+		std::sort(sorted.begin(), sorted.end());
+		const double p50 = Percentile(sorted, 50);
+		const double p99 = Percentile(sorted, 99);
+		const double maxUs = sorted.empty() ? 0 : sorted.back();
+		const double allocsPerEvent = stats.mEvents ? (double)stats.mAllocations / stats.mEvents : 0;
+		const double displayAllocsPerEvent = stats.mEvents ? (double)stats.mDisplayAllocations / stats.mEvents : 0;
+		const double bytesPerEvent = sorted.empty() ? 0 : (double)stats.mBytes / sorted.size();
+
+		std::printf("{\"bench\":\"SwitchLatency\",\"config\":\"%s\",\"event\":\"%s\",\"count\":%u,\"silent\":%u,"
+			"\"p50_us\":%.1f,\"p99_us\":%.1f,\"max_us\":%.1f,\"allocs_per_event\":%.2f,\"max_allocs\":%llu,\"display_allocs_per_event\":%.2f,\"bytes_per_event\":%.1f}\n",
+			config.c_str(), cur.first.c_str(), stats.mEvents, stats.mSilent, p50, p99, maxUs, 
+			allocsPerEvent, stats.mMaxAllocations, displayAllocsPerEvent, bytesPerEvent);
+		std::fprintf(stderr, "  %-26s %7u %7u %9.1f %9.1f %9.1f %9.2f %11.2f %8.1f\n", cur.first.c_str(), stats.mEvents, stats.mSilent, 
+			p50, p99, maxUs, allocsPerEvent, displayAllocsPerEvent, bytesPerEvent);
+	}
+	std::fflush(stdout);
+}
+
+int
+main(int argc,
+	 char * argv[])
+{
+	SetAllocationHook(CountAllocation);
+	QCoreApplication app(argc, argv);
+
+	std::string dataDir(MTROLL_DATA_DIR);
+	int quietMs = 15;
+	int presses = 2;
+	bool shadowState = false;
+	std::vector<std::string> configs;
+	for (int idx = 1; idx < argc; ++idx)
+	{
+		if (!std::strcmp(argv[idx], "--data") && idx + 1 < argc)
+			dataDir = argv[++idx];
+		else if (!std::strcmp(argv[idx], "--quiet") && idx + 1 < argc)
+			quietMs = std::atoi(argv[++idx]);
+		else if (!std::strcmp(argv[idx], "--presses") && idx + 1 < argc)
+			presses = std::atoi(argv[++idx]);
+		else if (!std::strcmp(argv[idx], "--shadow"))
+			shadowState = true;
+		else if (argv[idx][0] == '-')
+		{
+			std::fprintf(stderr, "usage: %s [--data dir] [--quiet ms] [--presses n] [--shadow] [config ...]\n", argv[0]);
+			return 1;
+		}
+		else
+			configs.push_back(argv[idx]);
+	}
+
+	if (configs.empty())
+		configs = { "axefx3v2", "edp", "microcosm", "testdata", "transitions" };
+
+	WireTimer wire;
+	LoopbackMidiOut::SetWireTap(&wire);
+
+	int failures = 0;
+	for (const std::string & config : configs)
+	{
+		const std::string configFile(ResolveConfig(dataDir, config, shadowState));
+		CountingDisplay display;
+		HeadlessHost host(&display, dataDir);
+		if (configFile.empty() || !host.Load(configFile))
+		{
+			std::fprintf(stderr, "failed to load config %s\n", config.c_str());
+			++failures;
+			continue;
+		}
+
+		LatencyRun run(host, wire, quietMs);
+		RunEvents(host, run, presses);
+		const MidiShadowStats shadowStats(host.GetEngine()->GetMidiShadowStats());
+		host.Unload();
+		Report(config, run.GetResults(), display.GetCounts());
+		if (shadowState)
+		{
+			std::printf("{\"bench\":\"SwitchLatency\",\"config\":\"%s\",\"event\":\"shadow\",\"messages_suppressed\":%llu,\"bytes_suppressed\":%llu}\n",
+				config.c_str(), shadowStats.mMessagesSuppressed, shadowStats.mBytesSuppressed);
+			std::fprintf(stderr, "  shadow state: %llu messages (%llu bytes) not sent\n", shadowStats.mMessagesSuppressed, shadowStats.mBytesSuppressed);
+		}
+	}
+
+	LoopbackMidiOut::SetWireTap(nullptr);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include <cstdio>
+#include "HeadlessDisplay.h"
+#include "../Engine/Patch.h"
+
+
+HeadlessDisplay::SwitchState
+HeadlessDisplay::GetSwitchState(int switchNumber)
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	auto it = mSwitches.find(switchNumber);
+	return it == mSwitches.end() ? SwitchState() : it->second;
+}
+
+std::map<int, HeadlessDisplay::SwitchState>
+HeadlessDisplay::GetSwitchStates()
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	return mSwitches;
+}
+
+HeadlessDisplay::Counts
+HeadlessDisplay::GetCounts()
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	return mCounts;
+}
+
+void
+HeadlessDisplay::ResetCounts()
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	mCounts = Counts();
+}
+
+// IMainDisplay
+void
+HeadlessDisplay::TextOut(const std::string & txt)
+{
+	{
+		std::lock_guard<std::mutex> lock(mLock);
+		mMainText = txt;
+		mTransientText.clear();
+		++mCounts.mTextOuts;
+	}
+
+	if (mEchoText)
+		std::printf("%s%s", txt.c_str(), txt.empty() || txt.back() != '\n' ? "\n" : "");
+}
+
+void
+HeadlessDisplay::AppendText(const std::string & text)
+{
+	{
+		std::lock_guard<std::mutex> lock(mLock);
+		mMainText += text;
+		++mCounts.mTextOuts;
+	}
+
+	if (mEchoText)
+		std::printf("%s%s", text.c_str(), text.empty() || text.back() != '\n' ? "\n" : "");
+}
+
+void
+HeadlessDisplay::ClearDisplay()
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	mMainText.clear();
+	mTransientText.clear();
+	++mCounts.mTextOuts;
+}
+
+void
+HeadlessDisplay::TransientTextOut(const std::string & txt)
+{
+	{
+		std::lock_guard<std::mutex> lock(mLock);
+		mTransientText = txt;
+		++mCounts.mTextOuts;
+	}
+
+	if (mEchoText)
+		std::printf("%s%s", txt.c_str(), txt.empty() || txt.back() != '\n' ? "\n" : "");
+}
+
+void
+HeadlessDisplay::ClearTransientText()
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	mTransientText.clear();
+}
+
+std::string
+HeadlessDisplay::GetCurrentText()
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	return mTransientText.empty() ? mMainText : mTransientText;
+}
+
+std::string
+HeadlessDisplay::GetQueuedText()
+{
+	// nothing is queued; text is "painted" as soon as it arrives
+	return std::string();
+}
+
+// ISwitchDisplay
+void
+HeadlessDisplay::SetLed(int switchNumber,
+						unsigned int color,
+						bool dimmed)
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	SwitchState & sw = mSwitches[switchNumber];
+	sw.mColor = color;
+	sw.mDimmed = dimmed;
+	++mCounts.mLedUpdates;
+}
+
+void
+HeadlessDisplay::SetSwitchDisplay(int switchNumber,
+								  unsigned int color)
+{
+	SetLed(switchNumber, color, false);
+}
+
+void
+HeadlessDisplay::TurnOffSwitchDisplay(int switchNumber)
+{
+	SetLed(switchNumber, 0, false);
+}
+
+void
+HeadlessDisplay::ForceSwitchDisplay(int switchNumber,
+									unsigned int color)
+{
+	SetLed(switchNumber, color, false);
+}
+
+void
+HeadlessDisplay::DimSwitchDisplay(int switchNumber,
+								  unsigned int ledColor)
+{
+	SetLed(switchNumber, ledColor, true);
+}
+
+void
+HeadlessDisplay::SetSwitchText(int switchNumber,
+							   const std::string & txt)
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	mSwitches[switchNumber].mText = txt;
+	++mCounts.mSwitchTextUpdates;
+}
+
+void
+HeadlessDisplay::ClearSwitchText(int switchNumber)
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	mSwitches[switchNumber].mText.clear();
+	++mCounts.mSwitchTextUpdates;
+}
+
+void
+HeadlessDisplay::SetIndicatorThreadSafe(bool isOn,
+										PatchPtr patch,
+										int /*time*/)
+{
+	// the UI delays the LED change by time ms; there is nobody to look at
+	// it here, so apply it now
+	{
+		std::lock_guard<std::mutex> lock(mLock);
+		++mCounts.mIndicatorUpdates;
+	}
+
+	if (patch)
+		patch->ActivateSwitchDisplay(this, isOn);
+}
+
+// ITraceDisplay
+void
+HeadlessDisplay::Trace(const std::string & txt)
+{
+	{
+		std::lock_guard<std::mutex> lock(mLock);
+		++mCounts.mTraces;
+		if (0 == txt.compare(0, 5, "Error"))
+			++mCounts.mErrors;
+	}
+
+	if (mEchoTrace)
+		std::fprintf(stderr, "%s", txt.c_str());
+}
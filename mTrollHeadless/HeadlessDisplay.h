@@ -0,0 +1,116 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef HeadlessDisplay_h__
+#define HeadlessDisplay_h__
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include "../Engine/IMainDisplay.h"
+#include "../Engine/ISwitchDisplay.h"
+#include "../Engine/ITraceDisplay.h"
+
+
+// HeadlessDisplay
+// ----------------------------------------------------------------------------
+// IMainDisplay, ISwitchDisplay and ITraceDisplay that record what the
+// engine would have shown instead of painting anything.  Keeps the last
+// state of each switch LED and label, the main display text and counts of
+// each kind of update.  Optionally echoes main text to stdout and trace to
+// stderr.
+// Callable from any thread (the engine updates LEDs from the scheduler and
+// MIDI input threads).
+//
+class HeadlessDisplay : public IMainDisplay,
+						public ISwitchDisplay,
+						public ITraceDisplay
+{
+public:
+	HeadlessDisplay() = default;
+
+	void EchoText(bool echo) { mEchoText = echo; }
+	void EchoTrace(bool echo) { mEchoTrace = echo; }
+
+	struct SwitchState
+	{
+		unsigned int	mColor = 0;		// 0 is off
+		bool			mDimmed = false;
+		std::string		mText;
+	};
+
+	struct Counts
+	{
+		unsigned int	mTextOuts = 0;
+		unsigned int	mLedUpdates = 0;
+		unsigned int	mSwitchTextUpdates = 0;
+		unsigned int	mIndicatorUpdates = 0;
+		unsigned int	mTraces = 0;
+		unsigned int	mErrors = 0;		// traces that start with "Error"
+	};
+
+	SwitchState GetSwitchState(int switchNumber);
+	std::map<int, SwitchState> GetSwitchStates();
+	Counts GetCounts();
+	void ResetCounts();
+
+	// IMainDisplay
+	virtual void TextOut(const std::string & txt) override;
+	virtual void AppendText(const std::string & text) override;
+	virtual void ClearDisplay() override;
+	virtual void TransientTextOut(const std::string & txt) override;
+	virtual void ClearTransientText() override;
+	virtual std::string GetCurrentText() override;
+	virtual std::string GetQueuedText() override;
+
+	// ISwitchDisplay
+	virtual void SetSwitchDisplay(int switchNumber, unsigned int color) override;
+	virtual void TurnOffSwitchDisplay(int switchNumber) override;
+	virtual void ForceSwitchDisplay(int switchNumber, unsigned int color) override;
+	virtual void DimSwitchDisplay(int switchNumber, unsigned int ledColor) override;
+	virtual void SetSwitchText(int switchNumber, const std::string & txt) override;
+	virtual void ClearSwitchText(int switchNumber) override;
+	virtual void SetIndicatorThreadSafe(bool isOn, PatchPtr patch, int time) override;
+	virtual void TestLeds(int) override { }
+	virtual void EnableDisplayUpdate(bool) override { }
+	virtual void UpdatePresetColors(std::array<unsigned int, 32> &) override { }
+
+	// ITraceDisplay
+	virtual void Trace(const std::string & txt) override;
+
+private:
+	void SetLed(int switchNumber, unsigned int color, bool dimmed);
+
+	std::mutex					mLock;
+	std::map<int, SwitchState>	mSwitches;
+	std::string					mMainText;
+	std::string					mTransientText;
+	Counts						mCounts;
+	std::atomic_bool			mEchoText = false;
+	std::atomic_bool			mEchoTrace = false;
+};
+
+#endif // HeadlessDisplay_h__
@@ -0,0 +1,315 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <format>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <QCoreApplication>
+#include "HeadlessHost.h"
+#include "HeadlessDisplay.h"
+#include "../Engine/EngineLoader.h"
+#include "../Engine/PatchCommandScheduler.h"
+#include "../midi/MidiPortGenerator.h"
+#include "../midi/LoopbackMidi.h"
+#ifdef MTROLL_HAVE_ALSA
+#include "../midi/AlsaMidiOut.h"
+#include "../midi/AlsaMidiIn.h"
+#endif
+
+
+// LoopbackPortGenerator
+// ----------------------------------------------------------------------------
+// Loopback outs for configs written for real devices: a device name that
+// isn't a loopback port is given the next loopback port (wrapping around
+// if the config names more devices than there are ports).
+//
+class LoopbackPortGenerator : public MidiPortGenerator<LoopbackMidiOut, LoopbackMidiIn>
+{
+public:
+	LoopbackPortGenerator(ITraceDisplay * trace, ISwitchDisplay * activityDisplay) :
+		MidiPortGenerator(trace, activityDisplay),
+		mTrace(trace)
+	{
+	}
+
+	virtual unsigned int GetMidiOutDeviceIndex(const std::string & deviceName) override
+	{
+		const unsigned int idx = MidiPortGenerator::GetMidiOutDeviceIndex(deviceName);
+		if (UINT_MAX != idx)
+			return idx;
+
+		auto it = mAssignedPorts.find(deviceName);
+		if (it != mAssignedPorts.end())
+			return it->second;
+
+		const unsigned int port = (unsigned int)(mAssignedPorts.size() % kLoopbackMidiPorts);
+		mAssignedPorts[deviceName] = port;
+		if (mTrace)
+			mTrace->Trace(std::format("MIDI out {} is loopback port {}\n", deviceName, port));
+		return port;
+	}
+
+private:
+	ITraceDisplay						* mTrace;
+	std::map<std::string, unsigned int>	mAssignedPorts;
+};
+
+
+HeadlessHost::HeadlessHost(HeadlessDisplay * display, 
+						   const std::string & appDirectory) :
+	mDisplay(display),
+	mAppDirectory(appDirectory)
+{
+	ResetTime();
+}
+
+HeadlessHost::~HeadlessHost()
+{
+	Unload();
+}
+
+bool
+HeadlessHost::Load(const std::string & configFile, 
+				   MidiPorts ports)
+{
+	Unload();
+	mExitRequested = false;
+
+	switch (ports)
+	{
+	case mpLoopback:
+		mMidiOutGenerator = std::make_unique<LoopbackPortGenerator>(mDisplay, mDisplay);
+		break;
+	case mpAlsa:
+#ifdef MTROLL_HAVE_ALSA
+		{
+			auto gen = std::make_unique<MidiPortGenerator<AlsaMidiOut, AlsaMidiIn>>(mDisplay, mDisplay);
+			mMidiInGenerator = gen.get();
+			mMidiOutGenerator = std::move(gen);
+		}
+		break;
+#else
+		mDisplay->Trace("Error: built without ALSA support\n");
+		return false;
+#endif
+	}
+
+	EngineLoader ldr(this, mMidiOutGenerator.get(), mMidiInGenerator, mDisplay, mDisplay, mDisplay);
+	mEngine = ldr.CreateEngine(configFile);
+	ProcessEvents();
+	if (mEngine)
+		return true;
+
+	mDisplay->TextOut("Failed to load MIDI settings.");
+	Unload();
+	return false;
+}
+
+void
+HeadlessHost::Unload()
+{
+	// same order as ControlUi::Unload
+	PatchCommandScheduler::Release();
+	if (mMidiInGenerator)
+		mMidiInGenerator->CloseMidiIns();
+	if (mMidiOutGenerator)
+		mMidiOutGenerator->CloseMidiOuts();
+
+	if (mEngine)
+	{
+		mEngine->Shutdown();
+		mEngine = nullptr;
+	}
+
+	ProcessEvents();
+	mMidiInGenerator = nullptr;
+	mMidiOutGenerator = nullptr;
+}
+
+void
+HeadlessHost::ProcessEvents()
+{
+	QCoreApplication::processEvents();
+}
+
+void
+HeadlessHost::Wait(int ms)
+{
+	const Clock::time_point until = Clock::now() + std::chrono::milliseconds(ms);
+	for (;;)
+	{
+		ProcessEvents();
+		const Clock::time_point now = Clock::now();
+		if (now >= until)
+			break;
+		std::this_thread::sleep_for(std::min<Clock::duration>(until - now, std::chrono::milliseconds(5)));
+	}
+}
+
+bool
+HeadlessHost::RunScript(std::istream & script)
+{
+	std::string line;
+	while (std::getline(script, line))
+	{
+		if (!ExecScriptLine(line))
+			return false;
+		if (mExitRequested)
+			break;
+	}
+
+	return true;
+}
+
+bool
+HeadlessHost::ExecScriptLine(const std::string & line)
+{
+	std::istringstream cmdLine(line.substr(0, line.find('#')));
+	std::string cmd;
+	if (!(cmdLine >> cmd))
+		return true;
+
+	if (cmd == "quit")
+	{
+		mExitRequested = true;
+		return true;
+	}
+
+	if (!mEngine)
+	{
+		mDisplay->Trace("Error: no config loaded\n");
+		return false;
+	}
+
+	int arg1 = -1, arg2 = -1;
+	cmdLine >> arg1 >> arg2;
+	if (cmd == "press" && arg1 > 0)
+		mEngine->SwitchPressed(arg1 - 1);
+	else if (cmd == "release" && arg1 > 0)
+		mEngine->SwitchReleased(arg1 - 1);
+	else if (cmd == "tap" && arg1 > 0)
+	{
+		mEngine->SwitchPressed(arg1 - 1);
+		if (arg2 > 0)
+			Wait(arg2);
+		mEngine->SwitchReleased(arg1 - 1);
+	}
+	else if (cmd == "adc" && arg1 > 0 && arg1 <= ExpressionPedals::PedalCount && arg2 >= 0)
+		mEngine->AdcValueChanged(arg1 - 1, arg2);
+	else if (cmd == "wait" && arg1 >= 0)
+		Wait(arg1);
+	else if (cmd == "leds")
+		PrintLeds();
+	else if (cmd == "text")
+		std::printf("%s\n", mDisplay->GetCurrentText().c_str());
+	else
+	{
+		mDisplay->Trace(std::format("Error: bad script command: {}\n", line));
+		return false;
+	}
+
+	ProcessEvents();
+	return true;
+}
+
+void
+HeadlessHost::PrintLeds()
+{
+	for (const auto & sw : mDisplay->GetSwitchStates())
+	{
+		if (!sw.second.mColor && sw.second.mText.empty())
+			continue;
+
+		std::printf("%3d %c %06x %s\n", sw.first + 1, sw.second.mDimmed ? 'd' : ' ',
+			sw.second.mColor, sw.second.mText.c_str());
+	}
+}
+
+// ITrollApplication
+bool
+HeadlessHost::IsHardwareAdcEnabled(int idx) const
+{
+	return idx >= 0 && idx < ExpressionPedals::PedalCount && mAdcEnabled[idx];
+}
+
+void
+HeadlessHost::EnableHardwareAdc(int idx, 
+								bool enable) const
+{
+	if (idx >= 0 && idx < ExpressionPedals::PedalCount)
+		mAdcEnabled[idx] = enable;
+}
+
+bool
+HeadlessHost::IsAdcOverridden(int adc)
+{
+	return adc >= 0 && adc < ExpressionPedals::PedalCount && mAdcOverridden[adc];
+}
+
+void
+HeadlessHost::ToggleAdcOverride(int adc)
+{
+	if (adc >= 0 && adc < ExpressionPedals::PedalCount)
+		mAdcOverridden[adc] = !mAdcOverridden[adc];
+}
+
+std::string
+HeadlessHost::GetElapsedTimeStr()
+{
+	Clock::time_point now = Clock::now();
+	if (mPauseTime != mStartTime)
+		now = mPauseTime;
+
+	long long secs = std::chrono::duration_cast<std::chrono::seconds>(now - mStartTime).count();
+	const long long hours = secs / 3600;
+	secs -= hours * 3600;
+	return std::format("elapsed: {}:{:02}:{:02}", hours, secs / 60, secs % 60);
+}
+
+void
+HeadlessHost::PauseOrResumeTime()
+{
+	if (mPauseTime == mStartTime)
+	{
+		// pause
+		mPauseTime = Clock::now();
+	}
+	else
+	{
+		// resume; move the start forward by the time spent paused
+		mStartTime += Clock::now() - mPauseTime;
+		mPauseTime = mStartTime;
+	}
+}
+
+void
+HeadlessHost::ResetTime()
+{
+	mStartTime = mPauseTime = Clock::now();
+}
@@ -0,0 +1,121 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef HeadlessHost_h__
+#define HeadlessHost_h__
+
+#include <chrono>
+#include <istream>
+#include <memory>
+#include <string>
+#include "../Engine/ITrollApplication.h"
+#include "../Engine/MidiControlEngine.h"
+#include "../Engine/ExpressionPedals.h"
+
+class HeadlessDisplay;
+class IMidiOutGenerator;
+class IMidiInGenerator;
+
+
+// HeadlessHost
+// ----------------------------------------------------------------------------
+// Loads a config into a MidiControlEngine with no UI, for profiling and
+// benchmarking.  Implements ITrollApplication by recording requests; the
+// displays are supplied by the caller (normally a HeadlessDisplay).
+// By default MIDI outs are in-process loopback ports: device names in the
+// config that aren't loopback port names are assigned loopback ports in
+// the order they are seen, and MIDI ins are not opened (loopback in n is
+// left free for whoever wants to watch what the engine sends on port n).
+// A QCoreApplication must exist; ProcessEvents runs the events the Axe-Fx
+// managers post.
+//
+// Script commands, one per line (switch and adc numbers are 1-based, as
+// in the config; # starts a comment):
+//   press <switch>
+//   release <switch>
+//   tap <switch> [hold ms]
+//   adc <port> <value>
+//   wait <ms>
+//   leds
+//   text
+//   quit
+//
+class HeadlessHost : public ITrollApplication
+{
+public:
+	HeadlessHost(HeadlessDisplay * display, const std::string & appDirectory);
+	virtual ~HeadlessHost();
+
+	enum MidiPorts { mpLoopback, mpAlsa };
+	bool Load(const std::string & configFile, MidiPorts ports = mpLoopback);
+	void Unload();
+
+	MidiControlEnginePtr GetEngine() const { return mEngine; }
+	IMidiOutGenerator * GetMidiOutGenerator() const { return mMidiOutGenerator.get(); }
+	bool IsExitRequested() const { return mExitRequested; }
+	unsigned int GetReconnectCount() const { return mReconnects; }
+
+	// runs events posted to the (Qt) event loop
+	void ProcessEvents();
+	// processes events until ms have elapsed
+	void Wait(int ms);
+
+	// stops at quit or when the engine asks to exit; returns false on error
+	bool RunScript(std::istream & script);
+	bool ExecScriptLine(const std::string & line);
+
+	// ITrollApplication
+	virtual void Reconnect() override { ++mReconnects; }
+	virtual void ToggleTraceWindow() override { }
+	virtual bool IsHardwareAdcEnabled(int idx) const override;
+	virtual void EnableHardwareAdc(int idx, bool enable) const override;
+	virtual bool IsAdcOverridden(int adc) override;
+	virtual void ToggleAdcOverride(int adc) override;
+	virtual bool EnableTimeDisplay(bool) override { return false; }
+	virtual std::string ApplicationDirectory() override { return mAppDirectory; }
+	virtual std::string GetElapsedTimeStr() override;
+	virtual void PauseOrResumeTime() override;
+	virtual void ResetTime() override;
+	virtual void Exit(ExitAction) override { mExitRequested = true; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	void PrintLeds();
+
+	HeadlessDisplay						* mDisplay;
+	std::string							mAppDirectory;
+	std::unique_ptr<IMidiOutGenerator>	mMidiOutGenerator;
+	IMidiInGenerator					* mMidiInGenerator = nullptr;	// same object as the out generator, if any
+	MidiControlEnginePtr				mEngine;
+	unsigned int						mReconnects = 0;
+	bool								mExitRequested = false;
+	mutable bool						mAdcEnabled[ExpressionPedals::PedalCount] = { };
+	bool								mAdcOverridden[ExpressionPedals::PedalCount] = { };
+	Clock::time_point					mStartTime;
+	Clock::time_point					mPauseTime;
+};
+
+#endif // HeadlessHost_h__
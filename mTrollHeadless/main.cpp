@@ -0,0 +1,120 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+// mTrollHeadless
+// ----------------------------------------------------------------------------
+// Runs a config with no UI: loads it, then feeds the engine switch and
+// ADC events from a script (see HeadlessHost.h) read from a file or stdin.
+//
+// usage: mTrollHeadless [-v] [--alsa] [--appdir dir] config.xml [script]
+//   -v        echo main display text to stdout and trace to stderr
+//   --alsa    use ALSA MIDI ports instead of loopback ports
+//   --appdir  directory that has config/default.axeml etc. for the
+//             Axe-Fx managers (default: the executable's directory)
+//
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <QCoreApplication>
+#include "HeadlessDisplay.h"
+#include "HeadlessHost.h"
+
+
+static void
+Usage(const char * exe)
+{
+	std::fprintf(stderr, "usage: %s [-v] [--alsa] [--appdir dir] config.xml [script]\n", exe);
+}
+
+int
+main(int argc, 
+	 char * argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	bool verbose = false;
+	HeadlessHost::MidiPorts ports = HeadlessHost::mpLoopback;
+	std::string appDir(QCoreApplication::applicationDirPath().toStdString());
+	std::string configFile, scriptFile;
+	for (int idx = 1; idx < argc; ++idx)
+	{
+		if (!std::strcmp(argv[idx], "-v"))
+			verbose = true;
+		else if (!std::strcmp(argv[idx], "--alsa"))
+			ports = HeadlessHost::mpAlsa;
+		else if (!std::strcmp(argv[idx], "--appdir") && idx + 1 < argc)
+			appDir = argv[++idx];
+		else if (configFile.empty())
+			configFile = argv[idx];
+		else if (scriptFile.empty())
+			scriptFile = argv[idx];
+		else
+		{
+			Usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (configFile.empty())
+	{
+		Usage(argv[0]);
+		return 1;
+	}
+
+	HeadlessDisplay display;
+	display.EchoText(verbose);
+	display.EchoTrace(verbose);
+
+	HeadlessHost host(&display, appDir);
+	if (!host.Load(configFile, ports))
+	{
+		std::fprintf(stderr, "failed to load %s\n", configFile.c_str());
+		return 1;
+	}
+
+	bool ok;
+	if (scriptFile.empty())
+		ok = host.RunScript(std::cin);
+	else
+	{
+		std::ifstream script(scriptFile);
+		if (!script)
+		{
+			std::fprintf(stderr, "failed to open %s\n", scriptFile.c_str());
+			return 1;
+		}
+		ok = host.RunScript(script);
+	}
+
+	host.Unload();
+
+	const HeadlessDisplay::Counts counts(display.GetCounts());
+	std::fprintf(stderr, "text outs %u, LED updates %u, switch text updates %u, traces %u (errors %u)\n",
+		counts.mTextOuts, counts.mLedUpdates, counts.mSwitchTextUpdates, counts.mTraces, counts.mErrors);
+	return ok ? 0 : 1;
+}
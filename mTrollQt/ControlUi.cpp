@@ -42,9 +42,13 @@
 #include "../Engine/ITrollApplication.h"
 #include "../Engine/EngineLoader.h"
 #include "../Engine/MidiControlEngine.h"
+#include "../Engine/PatchCommandScheduler.h"
 #include "../Engine/UiLoader.h"
 #include "../Engine/HexStringUtils.h"
+#include "../Engine/MidiActivityIndicator.h"
+#include "../Engine/InputLatency.h"
 #include "../Monome40h/IMonome40h.h"
+#include "../midi/MidiPortOpener.h"
 #include "MainTrollWindow.h"
 
 #ifdef _WINDOWS
@@ -61,6 +65,12 @@
 
 	using XMidiOut = MacMidiOut;
 	using XMidiIn = MacMidiIn;
+#elif defined(__linux__)
+	#include "../midi/AlsaMidiOut.h"
+	#include "../midi/AlsaMidiIn.h"
+
+	using XMidiOut = AlsaMidiOut;
+	using XMidiIn = AlsaMidiIn;
 #else
 	#error "include the midiOut header file for this platform"
 	#error "include the midiIn header file for this platform"
@@ -145,6 +155,24 @@ ControlUi::Unload()
 		mHardwareUi->Unsubscribe(this);
 	}
 
+	delete mActivityTimer;
+	mActivityTimer = nullptr;
+
+	if (mSwitchDisplayEvents)
+	{
+		Trace(std::format("LED update events posted: {} (midi activity LED changes: {})\n",
+			mSwitchDisplayEvents.load(), MidiActivityIndicator::GetUpdateCount()));
+	}
+
+	if (InputLatency::GetCount(InputLatency::stDispatch))
+	{
+		Trace(InputLatency::Report());
+		InputLatency::Reset();
+	}
+	mLedPaintsPending.clear();
+
+	// drop pending patch timelines before their ports close
+	PatchCommandScheduler::Release();
 	CloseMidiIns();
 	CloseMidiOuts();
 
@@ -180,6 +208,8 @@ ControlUi::Unload()
 
 	mMidiOuts.clear();
 	mMidiIns.clear();
+	mMidiOutDeviceNames.Clear();
+	mMidiInDeviceNames.Clear();
 
 	for_each(mLeds.begin(), mLeds.end(), DeleteSwitchLed());
 	mLeds.clear();
@@ -252,29 +282,18 @@ ControlUi::LoadUi(const std::string & uiSettingsFile)
 	if (mGrid)
 		setLayout(mGrid);
 
+	// the config load resolves device names against this scan
+	ScanMidiDevices();
+
 	Trace("Midi Output Devices:\n");
-	IMidiOutPtr midiOut = CreateMidiOut(0, -1, 0);
-	if (midiOut)
-	{
-		const int kMidiOutCnt = midiOut->GetMidiOutDeviceCount();
-		for (int idx = 0; idx < kMidiOutCnt; ++idx)
-			Trace(std::format("  {}: {}\n", idx, midiOut->GetMidiOutDeviceName(idx)));
-		Trace("\n");
-		midiOut->CloseMidiOut();
-		mMidiOuts.erase(0);
-	}
+	for (unsigned int idx = 0; idx < mMidiOutDeviceNames.GetCount(); ++idx)
+		Trace(std::format("  {}: {}\n", idx, mMidiOutDeviceNames.GetName(idx)));
+	Trace("\n");
 
-	IMidiInPtr midiIn = CreateMidiIn(0);
-	if (midiIn)
-	{
-		Trace("Midi Input Devices:\n");
-		const int kMidiInCnt = midiIn->GetMidiInDeviceCount();
-		for (int idx = 0; idx < kMidiInCnt; ++idx)
-			Trace(std::format("  {}: {}\n", idx, midiIn->GetMidiInDeviceName(idx)));
-		Trace("\n");
-		midiIn->CloseMidiIn();
-		mMidiIns.erase(0);
-	}
+	Trace("Midi Input Devices:\n");
+	for (unsigned int idx = 0; idx < mMidiInDeviceNames.GetCount(); ++idx)
+		Trace(std::format("  {}: {}\n", idx, mMidiInDeviceNames.GetName(idx)));
+	Trace("\n");
 
 	if (mSwitches[0])
 		mSwitches[0]->setFocus();
@@ -282,6 +301,11 @@ ControlUi::LoadUi(const std::string & uiSettingsFile)
 	mMainDisplayTimer = new QTimer(this);
 	connect(mMainDisplayTimer, &QTimer::timeout, this, &ControlUi::UpdateMainDisplayTextTimerFired);
 	mMainDisplayTimer->setSingleShot(true);
+
+	// activity LEDs are sampled rather than updated per message
+	mActivityTimer = new QTimer(this);
+	connect(mActivityTimer, &QTimer::timeout, this, &ControlUi::ActivityTimerFired);
+	mActivityTimer->start(1000 / MidiActivityIndicator::kTicksPerSecond);
 }
 
 void
@@ -680,16 +704,22 @@ class UpdateSwitchDisplayEvent : public ControlUiEvent
 	ControlUi::SwitchLed * mLed;
 	DWORD mColor;
 	DWORD mFrameHighlightColor;
+	ControlUi::LedPaintsPending & mPaintsPending;
+	InputLatency::Clock::time_point mArrival;	// MIDI input that caused the update, if any
 
 public:
-	UpdateSwitchDisplayEvent(ControlUi::SwitchLed * led, DWORD color, DWORD frameHighlightColor, int offset) : 
+	UpdateSwitchDisplayEvent(ControlUi::SwitchLed * led, DWORD color, DWORD frameHighlightColor, int offset, ControlUi::LedPaintsPending & paintsPending) : 
 		ControlUiEvent(User),
 		mLed(led),
 		mColor(color),
-		mFrameHighlightColor(frameHighlightColor)
+		mFrameHighlightColor(frameHighlightColor),
+		mPaintsPending(paintsPending),
+		mArrival(InputLatency::CurrentArrival())
 	{
 		if (mColor && offset)
 			ScaleLedColorForSwitchDisplay(offset);
+
+		InputLatency::RecordSince(InputLatency::stDisplayPosted, mArrival);
 	}
 
 	virtual void exec() override
@@ -699,6 +729,11 @@ public:
 		pal.setColor(QPalette::Light, mColor);
 		pal.setColor(QPalette::Dark, mFrameHighlightColor);
 		mLed->setPalette(pal);
+
+		// timed at the next paint of the LED; if it changes again before 
+		// that, the earlier input is the one measured
+		if (mArrival != InputLatency::Clock::time_point())
+			mPaintsPending.emplace(mLed, mArrival);
 	}
 
 	// the hardware LED values are super bright on the hardware but too dim in 
@@ -788,11 +823,13 @@ ControlUi::ForceSwitchDisplay(int switchNumber,
 		color = mLedConfig.mPresetColors[color];
 	}
 
+	++mSwitchDisplayEvents;
 	QCoreApplication::postEvent(this, 
 		new UpdateSwitchDisplayEvent(mLeds[switchNumber], 
 			color ? color : mLedConfig.mOffColor,
 			mFrameHighlightColor, 
-			color ? mLedConfig.mLedColorOffset : 0));
+			color ? mLedConfig.mLedColorOffset : 0,
+			mLedPaintsPending));
 }
 
 void
@@ -829,11 +866,13 @@ ControlUi::DimSwitchDisplay(int switchNumber,
 		ledColor = mLedConfig.mPresetColors[ledColor];
 	}
 
+	++mSwitchDisplayEvents;
 	QCoreApplication::postEvent(this, 
 		new UpdateSwitchDisplayEvent(mLeds[switchNumber], 
 			ledColor, 
 			mFrameHighlightColor, 
-			ledColor ? mLedConfig.mLedColorOffset : 0));
+			ledColor ? mLedConfig.mLedColorOffset : 0,
+			mLedPaintsPending));
 }
 
 class LabelTextOutEvent : public ControlUiEvent
@@ -1016,6 +1055,9 @@ ControlUi::CreateSwitchLed(int id)
 	pal.setColor(QPalette::Dark, mFrameHighlightColor);
 	curSwitchLed->setPalette(pal);
 
+	// paint events are watched for input latency
+	curSwitchLed->installEventFilter(this);
+
 	_ASSERTE(id < kMaxButtons);
 	_ASSERTE(!mLeds[id]);
 	mLeds[id] = curSwitchLed;
@@ -1583,20 +1625,21 @@ ControlUi::CreateMidiOut(unsigned int deviceIdx,
 
 unsigned int
 ControlUi::GetMidiOutDeviceIndex(const std::string &deviceName)
+{
+	if (!mMidiOutDeviceNames.IsScanned())
+		ScanMidiDevices();
+
+	return mMidiOutDeviceNames.Find(deviceName);
+}
+
+void
+ControlUi::ScanMidiDevices()
 {
 	XMidiOut midiOut(nullptr);
-	std::string devNameLower(deviceName);
-	std::transform(devNameLower.begin(), devNameLower.end(), devNameLower.begin(), ::tolower);
-	const unsigned int kCnt = midiOut.GetMidiOutDeviceCount();
-	for (unsigned int idx = 0; idx < kCnt; ++idx)
-	{
-		std::string curName(midiOut.GetMidiOutDeviceName(idx));
-		std::transform(curName.begin(), curName.end(), curName.begin(), ::tolower);
-		if (-1 != curName.find(devNameLower))
-			return idx;
-	}
+	mMidiOutDeviceNames.Scan(midiOut.GetMidiOutDeviceCount(), [&midiOut](unsigned int idx) { return midiOut.GetMidiOutDeviceName(idx); });
 
-	return UINT_MAX;
+	XMidiIn midiIn(nullptr);
+	mMidiInDeviceNames.Scan(midiIn.GetMidiInDeviceCount(), [&midiIn](unsigned int idx) { return midiIn.GetMidiInDeviceName(idx); });
 }
 
 
@@ -1609,16 +1652,28 @@ ControlUi::GetMidiOut(unsigned int deviceIdx)
 void
 ControlUi::OpenMidiOuts()
 {
+	std::vector<std::pair<unsigned int, IMidiOutPtr>> toOpen;
 	for (auto & mMidiOut : mMidiOuts)
 	{
 		IMidiOutPtr curOut = mMidiOut.second;
-		if (!curOut || curOut->IsMidiOutOpen())
-			continue;
+		if (curOut && !curOut->IsMidiOutOpen())
+			toOpen.emplace_back(mMidiOut.first, curOut);
+	}
+
+	if (!mMidiOutDeviceNames.IsScanned())
+		ScanMidiDevices();
+
+	const unsigned int kCnt = mMidiOutDeviceNames.GetCount();
+	const std::vector<bool> opened(::OpenMidiPorts(toOpen, [kCnt](IMidiOutPtr curOut, unsigned int deviceIdx)
+	{
+		return deviceIdx < kCnt && curOut->OpenMidiOut(deviceIdx);
+	}));
 
-		const unsigned int kDeviceIdx = mMidiOut.first;
-		const unsigned int kCnt = curOut->GetMidiOutDeviceCount();
-		if (kDeviceIdx < kCnt && curOut->OpenMidiOut(kDeviceIdx))
-			Trace(std::format("Opened MIDI out {} {}\n", kDeviceIdx, curOut->GetMidiOutDeviceName(kDeviceIdx)));
+	for (size_t idx = 0; idx < toOpen.size(); ++idx)
+	{
+		const unsigned int kDeviceIdx = toOpen[idx].first;
+		if (opened[idx])
+			Trace(std::format("Opened MIDI out {} {}\n", kDeviceIdx, mMidiOutDeviceNames.GetName(kDeviceIdx)));
 		else
 			Trace(std::format("Failed to open MIDI out {}\n", kDeviceIdx));
 	}
@@ -1879,6 +1934,10 @@ ControlUi::ToggleTraceWindow()
 	if (!mTraceDisplay)
 		return;
 
+	// showing the window is a convenient time to see where input is spending its time
+	if (InputLatency::GetCount(InputLatency::stDispatch))
+		Trace(InputLatency::Report());
+
 	// ToggleTraceWindowEvent
 	// --------------------------------------------------------------------
 	// class used to toggle trace wnd on UI thread (via postEvent)
@@ -1978,6 +2037,23 @@ ControlUi::event(QEvent* event)
 	return QWidget::event(event);
 }
 
+bool
+ControlUi::eventFilter(QObject * watched, 
+					   QEvent * event)
+{
+	if (QEvent::Paint == event->type() && !mLedPaintsPending.empty())
+	{
+		auto it = mLedPaintsPending.find(watched);
+		if (it != mLedPaintsPending.end())
+		{
+			InputLatency::RecordSince(InputLatency::stDisplayPainted, it->second);
+			mLedPaintsPending.erase(it);
+		}
+	}
+
+	return QWidget::eventFilter(watched, event);
+}
+
 void
 ControlUi::UpdateAdcs(const bool adcOverrides[ExpressionPedals::PedalCount])
 {
@@ -2248,6 +2324,12 @@ ControlUi::DisplayTime()
 	}
 }
 
+void
+ControlUi::ActivityTimerFired()
+{
+	MidiActivityIndicator::TickAll();
+}
+
 void
 ControlUi::UpdateMainDisplayTextTimerFired()
 {
@@ -2299,16 +2381,28 @@ ControlUi::CloseMidiIns()
 void
 ControlUi::OpenMidiIns()
 {
+	std::vector<std::pair<unsigned int, IMidiInPtr>> toOpen;
 	for (auto & mMidiIn : mMidiIns)
 	{
 		IMidiInPtr curIn = mMidiIn.second;
-		if (!curIn || curIn->IsMidiInOpen())
-			continue;
+		if (curIn && !curIn->IsMidiInOpen())
+			toOpen.emplace_back(mMidiIn.first, curIn);
+	}
+
+	if (!mMidiInDeviceNames.IsScanned())
+		ScanMidiDevices();
+
+	const unsigned int kCnt = mMidiInDeviceNames.GetCount();
+	const std::vector<bool> opened(::OpenMidiPorts(toOpen, [kCnt](IMidiInPtr curIn, unsigned int deviceIdx)
+	{
+		return deviceIdx < kCnt && curIn->OpenMidiIn(deviceIdx);
+	}));
 
-		const unsigned int kDeviceIdx = mMidiIn.first;
-		const unsigned int kCnt = curIn->GetMidiInDeviceCount();
-		if (kDeviceIdx < kCnt && curIn->OpenMidiIn(kDeviceIdx))
-			Trace(std::format("Opened MIDI in {} {}\n", kDeviceIdx, curIn->GetMidiInDeviceName(kDeviceIdx)));
+	for (size_t idx = 0; idx < toOpen.size(); ++idx)
+	{
+		const unsigned int kDeviceIdx = toOpen[idx].first;
+		if (opened[idx])
+			Trace(std::format("Opened MIDI in {} {}\n", kDeviceIdx, mMidiInDeviceNames.GetName(kDeviceIdx)));
 		else
 			Trace(std::format("Failed to open MIDI in {}\n", kDeviceIdx));
 	}
@@ -2326,19 +2420,10 @@ ControlUi::CreateMidiIn(unsigned int deviceIdx)
 unsigned int
 ControlUi::GetMidiInDeviceIndex(const std::string &deviceName)
 {
-	XMidiIn midiIn(nullptr);
-	std::string devNameLower(deviceName);
-	std::transform(devNameLower.begin(), devNameLower.end(), devNameLower.begin(), ::tolower);
-	const unsigned int kCnt = midiIn.GetMidiInDeviceCount();
-	for (unsigned int idx = 0; idx < kCnt; ++idx)
-	{
-		std::string curName(midiIn.GetMidiInDeviceName(idx));
-		std::transform(curName.begin(), curName.end(), curName.begin(), ::tolower);
-		if (-1 != curName.find(devNameLower))
-			return idx;
-	}
+	if (!mMidiInDeviceNames.IsScanned())
+		ScanMidiDevices();
 
-	return UINT_MAX;
+	return mMidiInDeviceNames.Find(deviceName);
 }
 
 
@@ -2363,14 +2448,14 @@ ControlUi::SuspendMidi()
 bool
 ControlUi::ResumeMidi()
 {
-	bool allResumed = true;
-	for (auto & curOut : mMidiOuts)
-		if (!curOut.second->ResumeMidiOut())
-			allResumed = false;
+	const std::vector<std::pair<unsigned int, IMidiOutPtr>> outs(mMidiOuts.begin(), mMidiOuts.end());
+	const std::vector<bool> outsResumed(::OpenMidiPorts(outs, [](IMidiOutPtr curOut, unsigned int) { return curOut->ResumeMidiOut(); }));
 
-	for (auto & curIn : mMidiIns)
-		if (!curIn.second->ResumeMidiIn())
-			allResumed = false;
+	const std::vector<std::pair<unsigned int, IMidiInPtr>> ins(mMidiIns.begin(), mMidiIns.end());
+	const std::vector<bool> insResumed(::OpenMidiPorts(ins, [](IMidiInPtr curIn, unsigned int) { return curIn->ResumeMidiIn(); }));
+
+	const bool allResumed = std::find(outsResumed.begin(), outsResumed.end(), false) == outsResumed.end() &&
+		std::find(insResumed.begin(), insResumed.end(), false) == insResumed.end();
 
 	if (allResumed)
 		Trace("Resumed MIDI connections\n");
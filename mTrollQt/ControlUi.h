@@ -26,6 +26,7 @@
 #define ControlUi_h__
 
 #include <time.h>
+#include <atomic>
 #include <map>
 #include <QWidget>
 #include <QFont>
@@ -37,6 +38,8 @@
 #include "../Engine/IMidiControlUi.h"
 #include "../Engine/IMidiOutGenerator.h"
 #include "../Engine/IMidiInGenerator.h"
+#include "../Engine/InputLatency.h"
+#include "../midi/MidiDeviceNames.h"
 #include "../Monome40h/IMonome40hInputSubscriber.h"
 
 #ifdef _WINDOWS
@@ -78,6 +81,7 @@ public:
 	using SwitchLed = QFrame;
 	using SwitchTextDisplay = QLabel;
 	using Switch = QPushButton;
+	using LedPaintsPending = std::map<QObject *, InputLatency::Clock::time_point>;
 
 			void Load(const std::string & uiSettingsFile, const std::string & configSettingsFile, const bool adcOverrides[ExpressionPedals::PedalCount]);
 			void Unload();
@@ -164,6 +168,7 @@ public slots:
 private slots:
 	void DisplayTime();
 	void UpdateMainDisplayTextTimerFired();
+	void ActivityTimerFired();
 
 	// sigh... the one time that I would use a macro but the Qt MOC doesn't support it (or the use of tokenization)!!
 	void UiButtonPressed_0() { ButtonPressed(0); }
@@ -300,9 +305,11 @@ private slots:
 
 private:
 	virtual bool		event(QEvent *) override;
+	virtual bool		eventFilter(QObject * watched, QEvent * event) override;
 	void LoadUi(const std::string & uiSettingsFile);
 	void LoadMonome(bool displayStartSequence);
 	void LoadMidiSettings(const std::string & file, const bool adcOverrides[ExpressionPedals::PedalCount]);
+	void ScanMidiDevices();
 	void StopTimer();
 	void CreateTimeDisplayTimer();
 	void ToggleTraceWindowCallback();
@@ -364,6 +371,8 @@ private:
 	MidiOuts					mMidiOuts;
 	using MidiIns = std::map<unsigned int, IMidiInPtr>;
 	MidiIns						mMidiIns;
+	MidiDeviceNames				mMidiOutDeviceNames;	// scanned once per load
+	MidiDeviceNames				mMidiInDeviceNames;
 	int							mLedIntensity;
 	KeepDisplayOn				* mSystemPowerOverride;
 	QRect						mMainDisplayRc;
@@ -371,6 +380,9 @@ private:
 	bool						mUserAdcSettings[ExpressionPedals::PedalCount];
 	bool						mDisplayTime;
 	QTimer						* mTimeDisplayTimer = nullptr, * mMainDisplayTimer = nullptr;
+	QTimer						* mActivityTimer = nullptr;
+	std::atomic<unsigned int>	mSwitchDisplayEvents = 0;	// UpdateSwitchDisplayEvents posted
+	LedPaintsPending			mLedPaintsPending;	// LEDs changed by MIDI input, waiting for paint (UI thread only)
 	DWORD						mBackgroundColor;
 	DWORD						mFrameHighlightColor;
 	QString						mMainText, mPendingMainText;
@@ -0,0 +1,167 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include <cerrno>
+#include <format>
+#include <vector>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "AlsaMidiIn.h"
+#include "../Engine/CrossPlatform.h"
+
+
+unsigned int
+AlsaMidiIn::GetMidiInDeviceCount() const
+{
+	return (unsigned int)GetAlsaRawMidiPorts(SND_RAWMIDI_STREAM_INPUT).size();
+}
+
+std::string
+AlsaMidiIn::GetMidiInDeviceName(unsigned int deviceIdx) const
+{
+	const std::vector<AlsaRawMidiPort> ports(GetAlsaRawMidiPorts(SND_RAWMIDI_STREAM_INPUT));
+	if (deviceIdx < ports.size())
+		return ports[deviceIdx].mName;
+
+	return std::format("Error getting name of in device {}: no such device", deviceIdx);
+}
+
+bool
+AlsaMidiIn::OpenDevice(unsigned int deviceIdx)
+{
+	_ASSERTE(!mMidiIn && !mReaderThread.joinable());
+	const std::vector<AlsaRawMidiPort> ports(GetAlsaRawMidiPorts(SND_RAWMIDI_STREAM_INPUT));
+	if (deviceIdx >= ports.size())
+	{
+		ReportError(std::format("Error: no MIDI in device {}\n", deviceIdx));
+		return false;
+	}
+
+	int res = snd_rawmidi_open(&mMidiIn, nullptr, ports[deviceIdx].mDevice.c_str(), SND_RAWMIDI_NONBLOCK);
+	if (res < 0)
+	{
+		mMidiIn = nullptr;
+		ReportError(std::format("Error opening MIDI in {}: {}\n", ports[deviceIdx].mDevice, snd_strerror(res)));
+		return false;
+	}
+
+	mStopEvent = ::eventfd(0, EFD_CLOEXEC);
+	if (-1 == mStopEvent)
+	{
+		ReportError(std::format("Error creating MIDI in stop event: {}\n", snd_strerror(-errno)));
+		snd_rawmidi_close(mMidiIn);
+		mMidiIn = nullptr;
+		return false;
+	}
+
+	mReaderThread = std::thread(&AlsaMidiIn::ReaderThread, this);
+	return true;
+}
+
+void
+AlsaMidiIn::CloseDevice()
+{
+	if (mReaderThread.joinable())
+	{
+		const eventfd_t stop = 1;
+		::eventfd_write(mStopEvent, stop);
+		mReaderThread.join();
+	}
+
+	if (-1 != mStopEvent)
+	{
+		::close(mStopEvent);
+		mStopEvent = -1;
+	}
+
+	if (mMidiIn)
+	{
+		snd_rawmidi_close(mMidiIn);
+		mMidiIn = nullptr;
+	}
+}
+
+void
+AlsaMidiIn::ReaderThread()
+{
+	// the port's descriptors, then the stop event
+	const int portFds = snd_rawmidi_poll_descriptors_count(mMidiIn);
+	std::vector<pollfd> fds((size_t)portFds + 1);
+	snd_rawmidi_poll_descriptors(mMidiIn, fds.data(), (unsigned int)portFds);
+	fds[portFds].fd = mStopEvent;
+	fds[portFds].events = POLLIN;
+
+	// reads are no larger than a queue sysex slot
+	byte buf[MidiInQueue::kMaxSysexLen];
+	for (;;)
+	{
+		for (auto & fd : fds)
+			fd.revents = 0;
+
+		if (::poll(fds.data(), fds.size(), -1) < 0)
+		{
+			if (EINTR == errno)
+				continue;
+
+			ReportError(std::format("Error waiting for MIDI in: {}\n", snd_strerror(-errno)));
+			return;
+		}
+
+		if (fds[portFds].revents)
+			return;
+
+		unsigned short revents = 0;
+		snd_rawmidi_poll_descriptors_revents(mMidiIn, fds.data(), (unsigned int)portFds, &revents);
+		if (revents & (POLLERR | POLLHUP))
+		{
+			// unplugged
+			ReportError("Error: MIDI in device was disconnected\n");
+			return;
+		}
+
+		if (!(revents & POLLIN))
+			continue;
+
+		for (;;)
+		{
+			const ssize_t res = snd_rawmidi_read(mMidiIn, buf, sizeof(buf));
+			if (res > 0)
+			{
+				ReceiveBytes(buf, (size_t)res);
+				continue;
+			}
+
+			if (-EAGAIN == res || 0 == res)
+				break;
+
+			if (-EINTR == res)
+				continue;
+
+			ReportError(std::format("Error reading MIDI in: {}\n", snd_strerror((int)res)));
+			return;
+		}
+	}
+}
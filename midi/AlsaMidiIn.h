@@ -0,0 +1,62 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef AlsaMidiIn_h__
+#define AlsaMidiIn_h__
+
+#include <thread>
+#include "StreamMidiIn.h"
+#include "AlsaRawMidi.h"
+
+
+// AlsaMidiIn
+// ----------------------------------------------------------------------------
+// IMidiIn on an ALSA rawmidi port.  A reader thread waits in poll() on the
+// port and an eventfd (signalled to stop), and hands everything read to the
+// input queue.
+//
+class AlsaMidiIn : public StreamMidiIn
+{
+public:
+	AlsaMidiIn(ITraceDisplay * trace) : StreamMidiIn(trace) { }
+	virtual ~AlsaMidiIn() { CloseMidiIn(); }
+
+	// IMidiIn
+	virtual unsigned int GetMidiInDeviceCount() const override;
+	virtual std::string GetMidiInDeviceName(unsigned int deviceIdx) const override;
+
+private:
+	// StreamMidiIn
+	virtual bool OpenDevice(unsigned int deviceIdx) override;
+	virtual void CloseDevice() override;
+
+	void ReaderThread();
+
+	snd_rawmidi_t				* mMidiIn = nullptr;
+	int							mStopEvent = -1;
+	std::thread					mReaderThread;
+};
+
+#endif // AlsaMidiIn_h__
@@ -0,0 +1,103 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include <cerrno>
+#include <format>
+#include "AlsaMidiOut.h"
+#include "../Engine/CrossPlatform.h"
+
+
+unsigned int
+AlsaMidiOut::GetMidiOutDeviceCount() const
+{
+	return (unsigned int)GetAlsaRawMidiPorts(SND_RAWMIDI_STREAM_OUTPUT).size();
+}
+
+std::string
+AlsaMidiOut::GetMidiOutDeviceName(unsigned int deviceIdx) const
+{
+	const std::vector<AlsaRawMidiPort> ports(GetAlsaRawMidiPorts(SND_RAWMIDI_STREAM_OUTPUT));
+	if (deviceIdx < ports.size())
+		return ports[deviceIdx].mName;
+
+	return std::format("Error getting name of out device {}: no such device", deviceIdx);
+}
+
+bool
+AlsaMidiOut::OpenDevice(unsigned int deviceIdx)
+{
+	_ASSERTE(!mMidiOut);
+	const std::vector<AlsaRawMidiPort> ports(GetAlsaRawMidiPorts(SND_RAWMIDI_STREAM_OUTPUT));
+	if (deviceIdx >= ports.size())
+	{
+		ReportError(std::format("Error: no MIDI out device {}\n", deviceIdx));
+		return false;
+	}
+
+	// blocking writes; the sender thread writes, and the clock thread
+	// writes single realtime bytes
+	const int res = snd_rawmidi_open(nullptr, &mMidiOut, ports[deviceIdx].mDevice.c_str(), 0);
+	if (res < 0)
+	{
+		mMidiOut = nullptr;
+		ReportError(std::format("Error opening MIDI out {}: {}\n", ports[deviceIdx].mDevice, snd_strerror(res)));
+		return false;
+	}
+
+	return true;
+}
+
+void
+AlsaMidiOut::CloseDevice()
+{
+	if (!mMidiOut)
+		return;
+
+	snd_rawmidi_drain(mMidiOut);
+	snd_rawmidi_close(mMidiOut);
+	mMidiOut = nullptr;
+}
+
+// sender thread, or clock thread
+void
+AlsaMidiOut::WriteBytes(const byte * data, 
+						size_t len)
+{
+	while (len && mMidiOut)
+	{
+		const ssize_t res = snd_rawmidi_write(mMidiOut, data, len);
+		if (res < 0)
+		{
+			if (-EINTR == res || -EAGAIN == res)
+				continue;
+
+			ReportError(std::format("Error writing MIDI out: {}\n", snd_strerror((int)res)));
+			return;
+		}
+
+		data += res;
+		len -= (size_t)res;
+	}
+}
@@ -0,0 +1,58 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef AlsaMidiOut_h__
+#define AlsaMidiOut_h__
+
+#include "StreamMidiOut.h"
+#include "AlsaRawMidi.h"
+
+
+// AlsaMidiOut
+// ----------------------------------------------------------------------------
+// IMidiOut on an ALSA rawmidi port.  Writes block on the queue's sender
+// thread (or the clock thread), so a slow port only holds up its own queue.
+//
+class AlsaMidiOut : public StreamMidiOut
+{
+public:
+	AlsaMidiOut(ITraceDisplay * trace) : StreamMidiOut(trace) { }
+	virtual ~AlsaMidiOut() { CloseMidiOut(); }
+
+	// IMidiOut
+	using StreamMidiOut::GetMidiOutDeviceName;
+	virtual unsigned int GetMidiOutDeviceCount() const override;
+	virtual std::string GetMidiOutDeviceName(unsigned int deviceIdx) const override;
+
+private:
+	// StreamMidiOut
+	virtual bool OpenDevice(unsigned int deviceIdx) override;
+	virtual void CloseDevice() override;
+	virtual void WriteBytes(const byte * data, size_t len) override;
+
+	snd_rawmidi_t				* mMidiOut = nullptr;
+};
+
+#endif // AlsaMidiOut_h__
@@ -0,0 +1,74 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include <format>
+#include "AlsaRawMidi.h"
+
+
+std::vector<AlsaRawMidiPort>
+GetAlsaRawMidiPorts(snd_rawmidi_stream_t stream)
+{
+	std::vector<AlsaRawMidiPort> ports;
+	snd_rawmidi_info_t * info;
+	snd_rawmidi_info_alloca(&info);
+
+	int card = -1;
+	while (snd_card_next(&card) >= 0 && card >= 0)
+	{
+		snd_ctl_t * ctl = nullptr;
+		if (snd_ctl_open(&ctl, std::format("hw:{}", card).c_str(), 0) < 0)
+			continue;
+
+		int device = -1;
+		while (snd_ctl_rawmidi_next_device(ctl, &device) >= 0 && device >= 0)
+		{
+			snd_rawmidi_info_set_device(info, device);
+			snd_rawmidi_info_set_stream(info, stream);
+			snd_rawmidi_info_set_subdevice(info, 0);
+			// fails if the device has nothing in this direction
+			if (snd_ctl_rawmidi_info(ctl, info) < 0)
+				continue;
+
+			const int subCount = (int)snd_rawmidi_info_get_subdevices_count(info);
+			for (int sub = 0; sub < subCount; ++sub)
+			{
+				snd_rawmidi_info_set_subdevice(info, sub);
+				if (snd_ctl_rawmidi_info(ctl, info) < 0)
+					continue;
+
+				// subdevice names are only interesting when there is more than one
+				const char * subName = snd_rawmidi_info_get_subdevice_name(info);
+				AlsaRawMidiPort port;
+				port.mDevice = std::format("hw:{},{},{}", card, device, sub);
+				port.mName = (subCount > 1 && subName && *subName) ? subName : snd_rawmidi_info_get_name(info);
+				ports.push_back(port);
+			}
+		}
+
+		snd_ctl_close(ctl);
+	}
+
+	return ports;
+}
@@ -0,0 +1,48 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef AlsaRawMidi_h__
+#define AlsaRawMidi_h__
+
+#include <string>
+#include <vector>
+#include <alsa/asoundlib.h>
+
+
+// AlsaRawMidiPort
+// ----------------------------------------------------------------------------
+// A rawmidi subdevice in one direction.  Device indices used by AlsaMidiOut
+// and AlsaMidiIn are positions in the list returned by GetAlsaRawMidiPorts,
+// in card/device/subdevice order.
+//
+struct AlsaRawMidiPort
+{
+	std::string		mDevice;	// "hw:card,device,subdevice" for snd_rawmidi_open
+	std::string		mName;
+};
+
+std::vector<AlsaRawMidiPort> GetAlsaRawMidiPorts(snd_rawmidi_stream_t stream);
+
+#endif // AlsaRawMidi_h__
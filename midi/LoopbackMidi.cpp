@@ -0,0 +1,128 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include <atomic>
+#include <format>
+#include <mutex>
+#include "LoopbackMidi.h"
+#include "../Engine/CrossPlatform.h"
+
+
+// the in that has each port open; the lock also serializes the outs
+// sending to a port, since the input side takes one producer at a time
+struct LoopbackPort
+{
+	std::mutex			mLock;
+	LoopbackMidiIn		* mIn = nullptr;
+};
+
+static LoopbackPort sPorts[kLoopbackMidiPorts];
+static std::atomic<ILoopbackWireTap *> sWireTap{nullptr};
+
+
+static std::string
+LoopbackPortName(unsigned int deviceIdx)
+{
+	return std::format("mTroll Loopback {}", deviceIdx + 1);
+}
+
+
+std::string
+LoopbackMidiOut::GetMidiOutDeviceName(unsigned int deviceIdx) const
+{
+	return LoopbackPortName(deviceIdx);
+}
+
+bool
+LoopbackMidiOut::OpenDevice(unsigned int deviceIdx)
+{
+	if (deviceIdx >= kLoopbackMidiPorts)
+	{
+		ReportError(std::format("Error: no loopback MIDI out {}\n", deviceIdx));
+		return false;
+	}
+
+	mPort = deviceIdx;
+	return true;
+}
+
+// sender thread, or clock thread
+void
+LoopbackMidiOut::WriteBytes(const byte * data, 
+							size_t len)
+{
+	LoopbackPort & port = sPorts[mPort];
+	std::lock_guard<std::mutex> lock(port.mLock);
+	// nobody listening is the same as an unplugged cable
+	if (port.mIn)
+		port.mIn->ReceiveBytes(data, len);
+
+	if (ILoopbackWireTap * tap = sWireTap.load(std::memory_order_acquire))
+		tap->WireBytes(mPort, data, len);
+}
+
+void
+LoopbackMidiOut::SetWireTap(ILoopbackWireTap * tap)
+{
+	sWireTap.store(tap, std::memory_order_release);
+}
+
+
+std::string
+LoopbackMidiIn::GetMidiInDeviceName(unsigned int deviceIdx) const
+{
+	return LoopbackPortName(deviceIdx);
+}
+
+bool
+LoopbackMidiIn::OpenDevice(unsigned int deviceIdx)
+{
+	if (deviceIdx >= kLoopbackMidiPorts)
+	{
+		ReportError(std::format("Error: no loopback MIDI in {}\n", deviceIdx));
+		return false;
+	}
+
+	LoopbackPort & port = sPorts[deviceIdx];
+	std::lock_guard<std::mutex> lock(port.mLock);
+	if (port.mIn)
+	{
+		ReportError(std::format("Error: loopback MIDI in {} is already open\n", deviceIdx));
+		return false;
+	}
+
+	mPort = deviceIdx;
+	port.mIn = this;
+	return true;
+}
+
+void
+LoopbackMidiIn::CloseDevice()
+{
+	LoopbackPort & port = sPorts[mPort];
+	std::lock_guard<std::mutex> lock(port.mLock);
+	_ASSERTE(port.mIn == this);
+	port.mIn = nullptr;
+}
@@ -0,0 +1,105 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef LoopbackMidi_h__
+#define LoopbackMidi_h__
+
+#include "StreamMidiOut.h"
+#include "StreamMidiIn.h"
+
+
+// LoopbackMidiOut / LoopbackMidiIn
+// ----------------------------------------------------------------------------
+// In-process MIDI ports: whatever is sent to loopback out n is received on
+// loopback in n, after going through the same queueing, pacing, running
+// status, clock and input dispatch as a hardware port.  For exercising
+// (and benchmarking) the whole output and input path on a machine with no
+// MIDI hardware.
+// Any number of outs can send to a port; one in can have it open.
+//
+enum { kLoopbackMidiPorts = 4 };
+
+
+// ILoopbackWireTap
+// ----------------------------------------------------------------------------
+// sees every write to a loopback port, after it has been delivered, on the
+// sender thread of the out that wrote it (the clock thread for clock
+// ticks).  For timing what the engine puts on the "wire".
+//
+class ILoopbackWireTap
+{
+public:
+	virtual ~ILoopbackWireTap() = default;
+
+	virtual void WireBytes(unsigned int port, const byte * data, size_t len) = 0;
+};
+
+
+class LoopbackMidiOut : public StreamMidiOut
+{
+public:
+	LoopbackMidiOut(ITraceDisplay * trace) : StreamMidiOut(trace) { }
+	virtual ~LoopbackMidiOut() { CloseMidiOut(); }
+
+	// one tap for all ports; pass nullptr to remove.  The tap must outlive
+	// any write in progress when it is removed.
+	static void SetWireTap(ILoopbackWireTap * tap);
+
+	// IMidiOut
+	using StreamMidiOut::GetMidiOutDeviceName;
+	virtual unsigned int GetMidiOutDeviceCount() const override { return kLoopbackMidiPorts; }
+	virtual std::string GetMidiOutDeviceName(unsigned int deviceIdx) const override;
+
+private:
+	// StreamMidiOut
+	virtual bool OpenDevice(unsigned int deviceIdx) override;
+	virtual void CloseDevice() override { }
+	virtual void WriteBytes(const byte * data, size_t len) override;
+
+	unsigned int				mPort = 0;
+};
+
+
+class LoopbackMidiIn : public StreamMidiIn
+{
+	friend class LoopbackMidiOut;
+
+public:
+	LoopbackMidiIn(ITraceDisplay * trace) : StreamMidiIn(trace) { }
+	virtual ~LoopbackMidiIn() { CloseMidiIn(); }
+
+	// IMidiIn
+	virtual unsigned int GetMidiInDeviceCount() const override { return kLoopbackMidiPorts; }
+	virtual std::string GetMidiInDeviceName(unsigned int deviceIdx) const override;
+
+private:
+	// StreamMidiIn
+	virtual bool OpenDevice(unsigned int deviceIdx) override;
+	virtual void CloseDevice() override;
+
+	unsigned int				mPort = 0;
+};
+
+#endif // LoopbackMidi_h__
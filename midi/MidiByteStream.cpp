@@ -0,0 +1,71 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include "MidiByteStream.h"
+#include "../Engine/CrossPlatform.h"
+
+
+size_t
+MidiByteStreamWriter::Encode(unsigned int wireMsg, 
+							 byte (&out)[3])
+{
+	const byte status = (byte)(wireMsg & 0xFF);
+	size_t len;
+	if (status < 0x80)
+	{
+		// running status: data bytes only
+		_ASSERTE(mRunningStatus);
+		if (!mRunningStatus)
+			return 0;
+
+		len = (size_t)EncodedMidi::GetDataByteCount(mRunningStatus);
+	}
+	else
+	{
+		const int dataBytes = EncodedMidi::GetDataByteCount(status);
+		_ASSERTE(dataBytes >= 0);
+		if (dataBytes < 0)
+			return 0;
+
+		len = 1 + (size_t)dataBytes;
+		if (status < 0xF0)
+			mRunningStatus = status;
+		else if (status < 0xF8)
+			mRunningStatus = 0;
+	}
+
+	for (size_t idx = 0; idx < len; ++idx)
+		out[idx] = (byte)((wireMsg >> (8 * idx)) & 0xFF);
+	return len;
+}
+
+void
+MidiByteStreamParser::Reset()
+{
+	mStatus = 0;
+	mDataCount = 0;
+	mDataExpected = 0;
+	mInSysex = false;
+}
@@ -0,0 +1,192 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef MidiByteStream_h__
+#define MidiByteStream_h__
+
+#include <cstddef>
+#include "../Engine/EncodedMidi.h"
+
+
+// MidiByteStreamWriter
+// ----------------------------------------------------------------------------
+// Turns what an IMidiOutQueueSink is handed into wire bytes for backends
+// that write a raw byte stream (ALSA rawmidi, loopback).  A short message
+// that had its status dropped for running status (see 
+// RunningStatusEncoder) is sized from the last channel status written.
+// Must see every message in wire order.
+//
+class MidiByteStreamWriter
+{
+public:
+	MidiByteStreamWriter() = default;
+
+	void Reset() { mRunningStatus = 0; }
+
+	// returns the number of bytes put in out
+	size_t Encode(unsigned int wireMsg, byte (&out)[3]);
+	void SysexSent() { mRunningStatus = 0; }
+
+private:
+	byte				mRunningStatus = 0;
+};
+
+
+// MidiByteStreamParser
+// ----------------------------------------------------------------------------
+// Splits a received byte stream (delivered in arbitrary pieces) into short
+// messages packed status | data1 << 8 | data2 << 16 and pieces of sysex
+// for MidiInQueue::PushSysex.
+// Running status is expanded.  Realtime bytes are passed on as short
+// messages where they occur, splitting any sysex around them.  A sysex
+// piece never spans input pieces and is at most maxSysexPiece long; a
+// status byte that cuts off sysex is left on the end of the piece so that
+// the reassembler sees the message was truncated.
+//
+class MidiByteStreamParser
+{
+public:
+	MidiByteStreamParser(size_t maxSysexPiece) : mMaxSysexPiece(maxSysexPiece) { }
+
+	// drop any partial message (port closed)
+	void Reset();
+
+	// calls shortMsg(unsigned int) and sysex(const byte *, size_t) in
+	// stream order
+	template<typename ShortMsg, typename Sysex>
+	void Parse(const byte * data, size_t len, ShortMsg && shortMsg, Sysex && sysex);
+
+private:
+	const size_t		mMaxSysexPiece;
+	byte				mStatus = 0;		// of the message being received; 0 if none
+	byte				mData[2] = { };
+	int					mDataCount = 0;
+	int					mDataExpected = 0;
+	bool				mInSysex = false;
+};
+
+
+template<typename ShortMsg, typename Sysex>
+void
+MidiByteStreamParser::Parse(const byte * data, 
+							size_t len, 
+							ShortMsg && shortMsg, 
+							Sysex && sysex)
+{
+	size_t sysexStart = 0;
+	for (size_t pos = 0; pos < len; ++pos)
+	{
+		const byte cur = data[pos];
+		if (mInSysex)
+		{
+			if (cur < 0x80)
+			{
+				if (pos + 1 - sysexStart == mMaxSysexPiece)
+				{
+					sysex(&data[sysexStart], pos + 1 - sysexStart);
+					sysexStart = pos + 1;
+				}
+				continue;
+			}
+
+			if (cur >= 0xF8)
+			{
+				if (pos > sysexStart)
+					sysex(&data[sysexStart], pos - sysexStart);
+				shortMsg((unsigned int)cur);
+				sysexStart = pos + 1;
+				continue;
+			}
+
+			// EOX ends the message; anything else cuts it off and is also
+			// the start of the next message.  a following F0 is enough on
+			// its own for the reassembler to see the cut.
+			if (0xF0 != cur)
+				sysex(&data[sysexStart], pos + 1 - sysexStart);
+			else if (pos > sysexStart)
+				sysex(&data[sysexStart], pos - sysexStart);
+			mInSysex = false;
+			if (0xF7 == cur)
+				continue;
+		}
+
+		if (cur < 0x80)
+		{
+			// stray data bytes without a status are ignored
+			if (!mStatus)
+				continue;
+
+			mData[mDataCount++] = cur;
+			if (mDataCount < mDataExpected)
+				continue;
+
+			shortMsg(mStatus | (mData[0] << 8) | (mDataExpected > 1 ? (mData[1] << 16) : 0));
+			mDataCount = 0;
+			// only channel messages have running status
+			if (mStatus >= 0xF0)
+				mStatus = 0;
+			continue;
+		}
+
+		if (cur >= 0xF8)
+		{
+			shortMsg((unsigned int)cur);
+			continue;
+		}
+
+		mDataCount = 0;
+		if (0xF0 == cur)
+		{
+			mStatus = 0;
+			mInSysex = true;
+			sysexStart = pos;
+			continue;
+		}
+
+		if (0xF7 == cur)
+		{
+			// EOX without a message
+			mStatus = 0;
+			continue;
+		}
+
+		mDataExpected = EncodedMidi::GetDataByteCount(cur);
+		if (mDataExpected > 0)
+		{
+			mStatus = cur;
+			continue;
+		}
+
+		// tune request and undefined system common have no data
+		mStatus = 0;
+		shortMsg((unsigned int)cur);
+	}
+
+	// the rest of the message comes in the next piece
+	if (mInSysex && len > sysexStart)
+		sysex(&data[sysexStart], len - sysexStart);
+}
+
+#endif // MidiByteStream_h__
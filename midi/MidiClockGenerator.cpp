@@ -0,0 +1,225 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#include "MidiClockGenerator.h"
+#include "../Engine/CrossPlatform.h"
+#ifdef _WINDOWS
+#include <windows.h>
+#include "SleepShort.h"
+#elif defined(__linux__)
+#include <cerrno>
+#include <time.h>
+#endif
+
+// the OS sleep is asked to wake this much before the deadline; the rest
+// is spent spinning.  SleepShort is only good to about a millisecond.
+#ifdef _WINDOWS
+constexpr auto kSpinMargin = std::chrono::microseconds(1500);
+#else
+constexpr auto kSpinMargin = std::chrono::microseconds(200);
+#endif
+
+
+MidiClockGenerator::MidiClockGenerator(IMidiClockSink * sink) :
+	mSink(sink)
+{
+	for (auto & bucket : mJitterHistogram)
+		bucket.store(0, std::memory_order_relaxed);
+}
+
+MidiClockGenerator::~MidiClockGenerator()
+{
+	Stop();
+}
+
+void
+MidiClockGenerator::Start()
+{
+	if (mThread.joinable())
+		Stop();
+
+	ResetStats();
+	mRunning = true;
+	mThread = std::thread(&MidiClockGenerator::ClockThread, this);
+}
+
+void
+MidiClockGenerator::Stop()
+{
+	mRunning = false;
+	if (mThread.joinable())
+		mThread.join();
+}
+
+void
+MidiClockGenerator::SetTempo(int bpm)
+{
+	// The Fractal Audio Axe-FX III tempo range is 24-250, which seems reasonable to enforce
+	if (bpm < 24)
+		mTempo = 24;
+	else if (bpm > 250)
+		mTempo = 250;
+	else
+		mTempo = bpm;
+}
+
+// 24 ticks per quarter note: 60s / bpm / 24 = 2.5s / bpm per tick.
+// computed from the tick count each time so that rounding never accumulates.
+MidiClockGenerator::Clock::duration
+MidiClockGenerator::TickOffset(long long tick,
+							   int bpm)
+{
+	return std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(tick * 2500000000LL / bpm));
+}
+
+void
+MidiClockGenerator::ClockThread()
+{
+#ifdef _WINDOWS
+	::SetThreadPriority(::GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+#endif
+
+	int tempo = mTempo;
+	Clock::time_point anchor = Clock::now();
+	Clock::time_point deadline = anchor;
+	Clock::time_point prevSent;
+	long long tick = 0;
+
+	while (mRunning)
+	{
+		const int curTempo = mTempo;
+		if (curTempo != tempo)
+		{
+			// next tick is one new interval after the last one
+			tempo = curTempo;
+			anchor = deadline;
+			tick = 1;
+		}
+
+		deadline = anchor + TickOffset(tick, tempo);
+		if (Clock::now() - deadline > TickOffset(24, tempo))
+		{
+			// more than a beat behind (debugger, suspend); don't burst to catch up
+			anchor = deadline = Clock::now();
+			tick = 0;
+			prevSent = Clock::time_point();
+		}
+
+		WaitUntil(deadline);
+		if (!mRunning)
+			break;
+
+		mSink->SendClockTick();
+
+		const Clock::time_point sent = Clock::now();
+		if (prevSent != Clock::time_point())
+			RecordInterval(sent - prevSent, TickOffset(1, tempo));
+		prevSent = sent;
+		++tick;
+	}
+}
+
+void
+MidiClockGenerator::WaitUntil(Clock::time_point deadline)
+{
+	const Clock::time_point wake = deadline - kSpinMargin;
+#ifdef _WINDOWS
+	const auto sleepTime = std::chrono::duration<float, std::milli>(wake - Clock::now());
+	if (sleepTime.count() > 0)
+		::SleepShort(sleepTime.count());
+#elif defined(__linux__)
+	// steady_clock is CLOCK_MONOTONIC
+	const auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(wake.time_since_epoch()).count();
+	timespec ts;
+	ts.tv_sec = (time_t)(sinceEpoch / 1000000000LL);
+	ts.tv_nsec = (long)(sinceEpoch % 1000000000LL);
+	while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+		;
+#else
+	std::this_thread::sleep_until(wake);
+#endif
+
+	while (Clock::now() < deadline)
+		;
+}
+
+void
+MidiClockGenerator::RecordInterval(Clock::duration actual,
+								   Clock::duration ideal)
+{
+	const long long actualUs = std::chrono::duration_cast<std::chrono::microseconds>(actual).count();
+	const long long idealUs = std::chrono::duration_cast<std::chrono::microseconds>(ideal).count();
+	const unsigned int jitterUs = (unsigned int)(actualUs > idealUs ? actualUs - idealUs : idealUs - actualUs);
+
+	mTotalIntervalUs.fetch_add(actualUs, std::memory_order_relaxed);
+	mTotalJitterUs.fetch_add(jitterUs, std::memory_order_relaxed);
+	if (jitterUs > mMaxJitterUs.load(std::memory_order_relaxed))
+		mMaxJitterUs.store(jitterUs, std::memory_order_relaxed);
+	mJitterHistogram[jitterUs < kHistogramBuckets ? jitterUs : kHistogramBuckets - 1].fetch_add(1, std::memory_order_relaxed);
+	mTicks.fetch_add(1, std::memory_order_release);
+}
+
+MidiClockStats
+MidiClockGenerator::GetStats() const
+{
+	// values are read individually while the clock runs; close enough for display
+	MidiClockStats stats;
+	stats.mTicks = mTicks.load(std::memory_order_acquire);
+	if (!stats.mTicks)
+		return stats;
+
+	stats.mMeanIntervalUs = (unsigned int)(mTotalIntervalUs / stats.mTicks);
+	stats.mMeanJitterUs = (unsigned int)(mTotalJitterUs / stats.mTicks);
+	stats.mMaxJitterUs = mMaxJitterUs;
+
+	unsigned long long histogramTotal = 0;
+	for (const auto & bucket : mJitterHistogram)
+		histogramTotal += bucket.load(std::memory_order_relaxed);
+
+	const unsigned long long p99Count = (histogramTotal * 99 + 99) / 100;
+	unsigned long long count = 0;
+	for (unsigned int idx = 0; idx < kHistogramBuckets; ++idx)
+	{
+		count += mJitterHistogram[idx].load(std::memory_order_relaxed);
+		if (count >= p99Count)
+		{
+			stats.mP99JitterUs = idx;
+			break;
+		}
+	}
+
+	return stats;
+}
+
+void
+MidiClockGenerator::ResetStats()
+{
+	_ASSERTE(!mRunning);
+	mTicks = 0;
+	mTotalIntervalUs = 0;
+	mTotalJitterUs = 0;
+	mMaxJitterUs = 0;
+	for (auto & bucket : mJitterHistogram)
+		bucket.store(0, std::memory_order_relaxed);
+}
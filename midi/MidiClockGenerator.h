@@ -0,0 +1,95 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#ifndef MidiClockGenerator_h__
+#define MidiClockGenerator_h__
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "../Engine/IMidiOut.h"
+
+
+// IMidiClockSink
+// ----------------------------------------------------------------------------
+// implemented by a midi out backend to put a clock byte (0xF8) on the wire.
+// only ever called on the MidiClockGenerator thread.
+//
+class IMidiClockSink
+{
+public:
+	virtual ~IMidiClockSink() = default;
+
+	virtual void SendClockTick() = 0;
+};
+
+
+// MidiClockGenerator
+// ----------------------------------------------------------------------------
+// Backend independent MIDI beat clock (24 ppqn).
+// Tick n is due at anchor + n * interval, so timing error in one tick is
+// not carried into the next.  The thread sleeps until shortly before the
+// deadline (clock_nanosleep TIMER_ABSTIME on Linux, SleepShort on Windows)
+// and spins for the remainder.
+// Tempo changes re-anchor at the last tick sent.
+//
+class MidiClockGenerator
+{
+public:
+	MidiClockGenerator(IMidiClockSink * sink);
+	~MidiClockGenerator();
+
+	void Start();
+	void Stop();
+	bool IsRunning() const { return mRunning; }
+
+	void SetTempo(int bpm);
+	int GetTempo() const { return mTempo; }
+
+	MidiClockStats GetStats() const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	void ResetStats();
+	void ClockThread();
+	static void WaitUntil(Clock::time_point deadline);
+	static Clock::duration TickOffset(long long tick, int bpm);
+	void RecordInterval(Clock::duration actual, Clock::duration ideal);
+
+	enum { kHistogramBuckets = 4096 };	// 1us per bucket; last bucket collects the rest
+
+	IMidiClockSink				* mSink;
+	std::thread					mThread;
+	std::atomic_bool			mRunning = false;
+	std::atomic<int>			mTempo = 120;
+
+	std::atomic<unsigned int>	mTicks{0};
+	std::atomic<unsigned long long>	mTotalIntervalUs{0};
+	std::atomic<unsigned long long>	mTotalJitterUs{0};
+	std::atomic<unsigned int>	mMaxJitterUs{0};
+	std::atomic<unsigned int>	mJitterHistogram[kHistogramBuckets];
+};
+
+#endif // MidiClockGenerator_h__
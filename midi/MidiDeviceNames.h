@@ -0,0 +1,102 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef MidiDeviceNames_h__
+#define MidiDeviceNames_h__
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <string>
+#include <vector>
+
+
+// MidiDeviceNames
+// ----------------------------------------------------------------------------
+// Device names enumerated once per scan, so that resolving each port named
+// in a config doesn't create a port object and query the driver for every
+// device.  Lookup is a case insensitive substring match.
+// Call Clear when devices may have changed (e.g. before a config load).
+//
+class MidiDeviceNames
+{
+public:
+	bool IsScanned() const { return mScanned; }
+
+	template<typename TGetName>
+	void Scan(unsigned int count, 
+			  TGetName getName)
+	{
+		Clear();
+		mNames.reserve(count);
+		mLowerNames.reserve(count);
+		for (unsigned int idx = 0; idx < count; ++idx)
+		{
+			mNames.push_back(getName(idx));
+			mLowerNames.push_back(ToLower(mNames.back()));
+		}
+		mScanned = true;
+	}
+
+	void Clear()
+	{
+		mNames.clear();
+		mLowerNames.clear();
+		mScanned = false;
+	}
+
+	unsigned int GetCount() const { return (unsigned int)mNames.size(); }
+
+	std::string GetName(unsigned int deviceIdx) const
+	{
+		return deviceIdx < mNames.size() ? mNames[deviceIdx] : std::string();
+	}
+
+	// UINT_MAX if no device name contains name
+	unsigned int Find(const std::string & name) const
+	{
+		const std::string lowerName(ToLower(name));
+		for (unsigned int idx = 0; idx < mLowerNames.size(); ++idx)
+		{
+			if (std::string::npos != mLowerNames[idx].find(lowerName))
+				return idx;
+		}
+
+		return UINT_MAX;
+	}
+
+private:
+	static std::string ToLower(std::string str)
+	{
+		std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+		return str;
+	}
+
+	std::vector<std::string>	mNames;
+	std::vector<std::string>	mLowerNames;
+	bool						mScanned = false;
+};
+
+#endif // MidiDeviceNames_h__
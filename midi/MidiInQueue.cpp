@@ -0,0 +1,256 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include <cstring>
+#include <format>
+#include "MidiInQueue.h"
+#include "../Engine/ITraceDisplay.h"
+#include "../Engine/MidiInCapture.h"
+#include "../Engine/InputLatency.h"
+#include "../Engine/CrossPlatform.h"
+
+
+MidiInQueue::MidiInQueue(IMidiInQueueSink * sink) :
+	mSink(sink)
+{
+}
+
+MidiInQueue::~MidiInQueue()
+{
+	Stop();
+}
+
+void
+MidiInQueue::Start()
+{
+	if (mRunning)
+		return;
+
+	_ASSERTE(!mDispatchThread.joinable());
+	mRunning = true;
+	mDispatchThread = std::thread(&MidiInQueue::DispatchThread, this);
+}
+
+void
+MidiInQueue::Stop()
+{
+	if (!mDispatchThread.joinable())
+		return;
+
+	// dispatch thread delivers whatever was already received before exiting
+	mRunning = false;
+	mWakeCount.fetch_add(1, std::memory_order_release);
+	mWakeCount.notify_one();
+	mDispatchThread.join();
+
+	// an unfinished message won't be completed by the next session
+	mSysexAssembler.Reset();
+	mSysexGap = false;
+}
+
+bool
+MidiInQueue::PushData(unsigned int shortMsg,
+					  Clock::time_point driverTime)
+{
+	return Push(shortMsg, nullptr, -1, driverTime);
+}
+
+bool
+MidiInQueue::PushSysex(const byte * bytes,
+					   size_t len,
+					   Clock::time_point driverTime)
+{
+	if (len > kMaxSysexLen)
+	{
+		_ASSERTE(!"sysex larger than input buffer");
+		++mOverruns;
+		mSysexGap = true;
+		return false;
+	}
+
+	return Push(0, bytes, (int)len, driverTime);
+}
+
+bool
+MidiInQueue::Push(unsigned int shortMsg,
+				  const byte * bytes,
+				  int len,
+				  Clock::time_point driverTime)
+{
+	const Clock::time_point received(Clock::now());
+	const size_t writePos = mWritePos.load(std::memory_order_relaxed);
+	const size_t depth = writePos - mReadPos.load(std::memory_order_acquire);
+	if (depth >= kRingSize)
+	{
+		++mOverruns;
+		if (bytes)
+			mSysexGap = true;
+		return false;
+	}
+
+	if (bytes)
+	{
+		if (mSysexWritePos - mSysexReadPos.load(std::memory_order_acquire) >= kSysexSlots)
+		{
+			++mOverruns;
+			mSysexGap = true;
+			return false;
+		}
+
+		std::memcpy(mSysex[mSysexWritePos & (kSysexSlots - 1)], bytes, len);
+		++mSysexWritePos;
+	}
+
+	Event & evt = mEvents[writePos & (kRingSize - 1)];
+	evt.mShortMsg = shortMsg;
+	evt.mSysexLen = len;
+	evt.mSysexGap = bytes && mSysexGap;
+	if (bytes)
+		mSysexGap = false;
+	evt.mReceived = received;
+	evt.mDriverTime = driverTime;
+	mWritePos.store(writePos + 1, std::memory_order_release);
+
+	if (depth + 1 > mMaxDepth.load(std::memory_order_relaxed))
+		mMaxDepth.store((unsigned int)depth + 1, std::memory_order_relaxed);
+
+	mWakeCount.fetch_add(1, std::memory_order_release);
+	mWakeCount.notify_one();
+	return true;
+}
+
+void
+MidiInQueue::DispatchThread()
+{
+	for (;;)
+	{
+		// read wake count before checking for data so that a push that
+		// lands after the check still ends the wait
+		const unsigned int wake = mWakeCount.load(std::memory_order_acquire);
+		while (DispatchNext())
+			;
+
+		if (!mRunning)
+			break;
+
+		mWakeCount.wait(wake, std::memory_order_acquire);
+	}
+}
+
+bool
+MidiInQueue::DispatchNext()
+{
+	const size_t readPos = mReadPos.load(std::memory_order_relaxed);
+	if (readPos == mWritePos.load(std::memory_order_acquire))
+		return false;
+
+	const Event & evt = mEvents[readPos & (kRingSize - 1)];
+	const Clock::duration latency(Clock::now() - evt.mReceived);
+	const unsigned int latencyUs = (unsigned int)std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+	if (evt.mDriverTime != Clock::time_point())
+		InputLatency::Record(InputLatency::stCallback, evt.mReceived - evt.mDriverTime);
+	InputLatency::Record(InputLatency::stDispatch, latency);
+
+	// subscribers measure their own stages from the callback
+	InputLatency::ScopedArrival arrival(evt.mReceived);
+
+	if (evt.mSysexLen < 0)
+	{
+		if (mCapture)
+			mCapture->RecordData(mCapturePort, evt.mReceived, evt.mShortMsg);
+		mSink->DispatchData((byte)(evt.mShortMsg & 0xff), (byte)((evt.mShortMsg >> 8) & 0xff), (byte)((evt.mShortMsg >> 16) & 0xff));
+	}
+	else
+	{
+		// don't splice what follows a lost piece onto the message it was part of
+		if (evt.mSysexGap)
+			mSysexAssembler.Truncate();
+
+		const size_t sysexPos = mSysexReadPos.load(std::memory_order_relaxed);
+		mSysexAssembler.Append(mSysex[sysexPos & (kSysexSlots - 1)], evt.mSysexLen, [this, &evt](std::span<const byte> msg)
+		{
+			if (mCapture)
+				mCapture->RecordSysex(mCapturePort, evt.mReceived, msg);
+			mSink->DispatchSysex(msg.data(), (int)msg.size());
+		});
+		mSysexReadPos.store(sysexPos + 1, std::memory_order_release);
+	}
+
+	mReadPos.store(readPos + 1, std::memory_order_release);
+
+	mEventsDispatched.fetch_add(1, std::memory_order_relaxed);
+	mTotalLatencyUs.fetch_add(latencyUs, std::memory_order_relaxed);
+	if (latencyUs > mMaxLatencyUs.load(std::memory_order_relaxed))
+		mMaxLatencyUs.store(latencyUs, std::memory_order_relaxed);
+	return true;
+}
+
+void
+MidiInQueue::SetCapture(MidiInCaptureWriterPtr capture, 
+						int port)
+{
+	_ASSERTE(!mRunning);
+	mCapture = capture;
+	mCapturePort = port;
+}
+
+MidiInStats
+MidiInQueue::GetStats() const
+{
+	MidiInStats stats;
+	stats.mEventsDispatched = mEventsDispatched;
+	stats.mTotalLatencyUs = mTotalLatencyUs;
+	stats.mMaxLatencyUs = mMaxLatencyUs;
+	stats.mOverruns = mOverruns;
+	stats.mMaxDepth = mMaxDepth;
+	stats.mSysexDropped = mSysexAssembler.GetDroppedCount();
+	stats.mSysexTruncated = mSysexAssembler.GetTruncatedCount();
+	return stats;
+}
+
+void
+MidiInQueue::ResetStats()
+{
+	mEventsDispatched = 0;
+	mTotalLatencyUs = 0;
+	mMaxLatencyUs = 0;
+	mOverruns = 0;
+	mMaxDepth = 0;
+	mSysexAssembler.ResetStats();
+}
+
+void
+MidiInQueue::ReportStats(ITraceDisplay * trace, 
+						 unsigned int deviceIdx)
+{
+	const MidiInStats stats(GetStats());
+	if ((stats.mEventsDispatched || stats.mOverruns) && trace)
+	{
+		trace->Trace(std::format("MIDI in {}: {} events, callback-to-dispatch latency avg {} us, max {} us, {} overruns, max queue depth {}, {} sysex dropped, {} sysex truncated\n",
+			deviceIdx, stats.mEventsDispatched, stats.mEventsDispatched ? stats.mTotalLatencyUs / stats.mEventsDispatched : 0, 
+			stats.mMaxLatencyUs, stats.mOverruns, stats.mMaxDepth, stats.mSysexDropped, stats.mSysexTruncated));
+	}
+	ResetStats();
+}
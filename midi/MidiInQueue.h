@@ -0,0 +1,139 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef MidiInQueue_h__
+#define MidiInQueue_h__
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "../Engine/IMidiIn.h"
+#include "SysexAssembler.h"
+
+class ITraceDisplay;
+
+
+// IMidiInQueueSink
+// ----------------------------------------------------------------------------
+// implemented by a midi in backend to fan received events out to its
+// subscribers.  only ever called on the MidiInQueue dispatch thread.
+// DispatchSysex always gets a whole message (F0 ... F7).
+//
+class IMidiInQueueSink
+{
+public:
+	virtual ~IMidiInQueueSink() = default;
+
+	virtual void DispatchData(byte b1, byte b2, byte b3) = 0;
+	virtual void DispatchSysex(const byte * bytes, int len) = 0;
+};
+
+
+// MidiInQueue
+// ----------------------------------------------------------------------------
+// Per-port input stage.  The driver callback copies each event into
+// preallocated storage and returns; a dedicated dispatch thread hands the
+// events to the sink in arrival order, so a slow subscriber can't hold up
+// the driver or starve it of sysex buffers.
+// Sysex can be pushed in pieces as the driver delivers it; the dispatch
+// thread reassembles whole messages before handing them on.
+// Single-producer/single-consumer: the Push methods must only be called
+// from one thread at a time (the driver serializes its callbacks).
+// Events that don't fit are dropped and counted as overruns.  A message
+// that loses a piece of sysex that way is not delivered.
+//
+class MidiInQueue
+{
+public:
+	MidiInQueue(IMidiInQueueSink * sink);
+	~MidiInQueue();
+
+	using Clock = std::chrono::steady_clock;
+
+	void Start();
+	void Stop();
+	bool IsRunning() const { return mRunning; }
+
+	// largest piece of sysex that can be pushed at once
+	enum { kMaxSysexLen = 512 };
+
+	// driver callback; never blocks or allocates.
+	// driverTime is the driver's timestamp for the event, if it has one.
+	bool PushData(unsigned int shortMsg, Clock::time_point driverTime = Clock::time_point());
+	bool PushSysex(const byte * bytes, size_t len, Clock::time_point driverTime = Clock::time_point());
+
+	MidiInStats GetStats() const;
+	void ResetStats();
+	// traces the stats, if anything was received, then resets them
+	void ReportStats(ITraceDisplay * trace, unsigned int deviceIdx);
+
+	// events are recorded as they are dispatched; only while stopped
+	void SetCapture(MidiInCaptureWriterPtr capture, int port);
+
+private:
+	struct Event
+	{
+		unsigned int		mShortMsg = 0;
+		int					mSysexLen = -1;		// -1 for short messages
+		bool				mSysexGap = false;	// sysex pieces were dropped before this one
+		Clock::time_point	mReceived;			// driver callback
+		Clock::time_point	mDriverTime;
+	};
+
+	enum { kRingSize = 1024, kSysexSlots = 256 };	// must be powers of 2
+	static_assert((kRingSize & (kRingSize - 1)) == 0, "ring size must be power of 2");
+	static_assert((kSysexSlots & (kSysexSlots - 1)) == 0, "sysex slot count must be power of 2");
+
+	bool Push(unsigned int shortMsg, const byte * bytes, int len, Clock::time_point driverTime);
+	void DispatchThread();
+	bool DispatchNext();
+
+	IMidiInQueueSink			* mSink;
+	Event						mEvents[kRingSize];
+	byte						mSysex[kSysexSlots][kMaxSysexLen];	// used in order with sysex events
+
+	// producer side
+	alignas(64) std::atomic<size_t>	mWritePos{0};
+	size_t						mSysexWritePos = 0;
+	bool						mSysexGap = false;	// a sysex piece has been dropped since the last one queued
+	// consumer side
+	alignas(64) std::atomic<size_t>	mReadPos{0};
+	std::atomic<size_t>			mSysexReadPos{0};
+
+	std::atomic<unsigned int>	mWakeCount{0};
+	std::atomic_bool			mRunning{false};
+	std::thread					mDispatchThread;
+	SysexAssembler				mSysexAssembler;	// dispatch thread only
+	MidiInCaptureWriterPtr		mCapture;
+	int							mCapturePort = 0;
+
+	std::atomic<unsigned long long>	mEventsDispatched{0};
+	std::atomic<unsigned long long>	mTotalLatencyUs{0};
+	std::atomic<unsigned int>		mMaxLatencyUs{0};
+	std::atomic<unsigned int>		mOverruns{0};
+	std::atomic<unsigned int>		mMaxDepth{0};
+};
+
+#endif // MidiInQueue_h__
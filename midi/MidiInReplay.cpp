@@ -0,0 +1,87 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include "MidiInReplay.h"
+#include "../Engine/MidiInCapture.h"
+
+
+MidiInReplay::Stats
+MidiInReplay::Run(const MidiInCaptureReader & capture, 
+				  double speed)
+{
+	using Clock = std::chrono::steady_clock;
+
+	std::map<int, std::unique_ptr<MidiInRouter>> routers;
+	for (const auto & port : mPorts)
+		routers[port.first] = std::make_unique<MidiInRouter>(port.second);
+
+	Stats stats;
+	const Clock::time_point start(Clock::now());
+	for (const MidiInCaptureReader::Event & evt : capture.GetEvents())
+	{
+		const auto router = routers.find(evt.mPort);
+		if (router == routers.end())
+		{
+			++stats.mSkipped;
+			continue;
+		}
+
+		if (speed > 0)
+		{
+			const Clock::time_point due(start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::micro>(evt.mTimeUs / speed)));
+			const Clock::time_point now(Clock::now());
+			if (now < due)
+				std::this_thread::sleep_until(due);
+			else
+			{
+				const unsigned int lateUs = (unsigned int)std::chrono::duration_cast<std::chrono::microseconds>(now - due).count();
+				if (lateUs > stats.mMaxLateUs)
+					stats.mMaxLateUs = lateUs;
+			}
+		}
+
+		const Clock::time_point routeStart(Clock::now());
+		if (evt.IsSysex())
+		{
+			const auto msg = capture.GetSysex(evt);
+			router->second->RouteSysex(msg.data(), (int)msg.size());
+			stats.mSysexBytes += msg.size();
+		}
+		else
+			router->second->RouteData((byte)(evt.mShortMsg & 0xff), (byte)((evt.mShortMsg >> 8) & 0xff), (byte)((evt.mShortMsg >> 16) & 0xff));
+
+		const unsigned long long routeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - routeStart).count();
+		stats.mTotalRouteNs += routeNs;
+		if (routeNs > stats.mMaxRouteNs)
+			stats.mMaxRouteNs = routeNs;
+		++stats.mEvents;
+	}
+
+	stats.mElapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+	return stats;
+}
@@ -0,0 +1,65 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef MidiInReplay_h__
+#define MidiInReplay_h__
+
+#include <map>
+#include "MidiInRouter.h"
+
+class MidiInCaptureReader;
+
+
+// MidiInReplay
+// ----------------------------------------------------------------------------
+// Plays a MIDI input capture into subscribers, through the same routing as
+// live input, on the calling thread.  Useful for load testing subscribers
+// against real traffic without any MIDI hardware.
+//
+class MidiInReplay
+{
+public:
+	void Subscribe(int port, IMidiInSubscriberPtr sub) { mPorts[port].push_back(sub); }
+
+	struct Stats
+	{
+		unsigned long long	mEvents = 0;			// events delivered to at least the router
+		unsigned long long	mSkipped = 0;			// events for ports without subscribers
+		unsigned long long	mSysexBytes = 0;
+		unsigned long long	mElapsedUs = 0;
+		unsigned long long	mTotalRouteNs = 0;		// time spent routing and in subscribers
+		unsigned long long	mMaxRouteNs = 0;
+		unsigned int		mMaxLateUs = 0;			// behind the capture timing (timed replay only)
+	};
+
+	// speed is relative to the capture (2.0 is twice as fast); 0 replays
+	// as fast as the subscribers can take it
+	Stats Run(const MidiInCaptureReader & capture, double speed);
+
+private:
+	std::map<int, MidiInRouter::Subscribers>	mPorts;
+};
+
+#endif // MidiInReplay_h__
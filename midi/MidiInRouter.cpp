@@ -0,0 +1,279 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include <algorithm>
+#include "MidiInRouter.h"
+#include "../Engine/CrossPlatform.h"
+
+
+MidiInRouter::MidiInRouter(const Subscribers & subs) :
+	mChannelMsgs(kChannelMsgEntries, 0),
+	mSysexTrie(1)
+{
+	for (const auto & sub : subs)
+	{
+		if (!sub)
+			continue;
+
+		if (mSubscribers.size() == kMaxSubscribers)
+		{
+			_ASSERTE(!"too many midi in subscribers on one port");
+			break;
+		}
+
+		const SubscriberMask bit = 1u << mSubscribers.size();
+		mSubscribers.push_back(sub);
+
+		const MidiInInterest interest(sub->GetMidiInInterest());
+		for (const auto & msg : interest.mShortMsgs)
+			AddShortMsg(msg, bit);
+		for (const auto & prefix : interest.mSysexPrefixes)
+			AddSysexPrefix(prefix, bit);
+	}
+}
+
+size_t
+MidiInRouter::ChannelMsgIndex(int status, 
+							  int channel, 
+							  int data1)
+{
+	return ((((status >> 4) - 0x8) * 16) + channel) * 128 + data1;
+}
+
+void
+MidiInRouter::AddShortMsg(const MidiInInterest::ShortMsg & msg, 
+						  SubscriberMask sub)
+{
+	if (msg.mStatus > 0xF0 && msg.mStatus <= 0xFF)
+	{
+		mSystemMsgs[msg.mStatus & 0x0F] |= sub;
+		return;
+	}
+
+	if (msg.mStatus < 0x80 || msg.mStatus >= 0xF0 || (msg.mStatus & 0x0F))
+	{
+		_ASSERTE(!"invalid status in MidiInInterest");
+		return;
+	}
+
+	const int firstCh = msg.mChannel == MidiInInterest::kAny ? 0 : msg.mChannel;
+	const int lastCh = msg.mChannel == MidiInInterest::kAny ? 15 : msg.mChannel;
+	const int firstData = msg.mData1 == MidiInInterest::kAny ? 0 : msg.mData1;
+	const int lastData = msg.mData1 == MidiInInterest::kAny ? 127 : msg.mData1;
+	if (firstCh < 0 || lastCh > 15 || firstData < 0 || lastData > 127)
+	{
+		_ASSERTE(!"invalid channel or data in MidiInInterest");
+		return;
+	}
+
+	for (int ch = firstCh; ch <= lastCh; ++ch)
+	{
+		for (int data = firstData; data <= lastData; ++data)
+			mChannelMsgs[ChannelMsgIndex(msg.mStatus, ch, data)] |= sub;
+	}
+}
+
+void
+MidiInRouter::AddSysexPrefix(const std::vector<byte> & prefix, 
+							 SubscriberMask sub)
+{
+	size_t node = 0;
+	for (byte cur : prefix)
+	{
+		size_t next = 0;
+		for (const auto & child : mSysexTrie[node].mChildren)
+		{
+			if (child.first == cur)
+			{
+				next = child.second;
+				break;
+			}
+		}
+
+		if (!next)
+		{
+			next = mSysexTrie.size();
+			mSysexTrie[node].mChildren.emplace_back(cur, next);
+			mSysexTrie.emplace_back();
+		}
+
+		node = next;
+	}
+
+	mSysexTrie[node].mMatch |= sub;
+}
+
+void
+MidiInRouter::RouteData(byte b1, 
+						byte b2, 
+						byte b3) const
+{
+	SubscriberMask subs;
+	if (b1 >= 0xF0)
+		subs = mSystemMsgs[b1 & 0x0F];
+	else if (b1 >= 0x80)
+		subs = mChannelMsgs[ChannelMsgIndex(b1 & 0xF0, b1 & 0x0F, b2 & 0x7F)];
+	else
+		return;
+
+	for (size_t idx = 0; subs; ++idx, subs >>= 1)
+	{
+		if (subs & 1)
+			mSubscribers[idx]->ReceivedData(b1, b2, b3);
+	}
+}
+
+void
+MidiInRouter::RouteSysex(const byte * bytes, 
+						 int len) const
+{
+	// every prefix on the path matches
+	SubscriberMask subs = mSysexTrie[0].mMatch;
+	size_t node = 0;
+	for (int pos = 0; pos < len; ++pos)
+	{
+		size_t next = 0;
+		for (const auto & child : mSysexTrie[node].mChildren)
+		{
+			if (child.first == bytes[pos])
+			{
+				next = child.second;
+				break;
+			}
+		}
+
+		if (!next)
+			break;
+
+		node = next;
+		subs |= mSysexTrie[node].mMatch;
+	}
+
+	for (size_t idx = 0; subs; ++idx, subs >>= 1)
+	{
+		if (subs & 1)
+			mSubscribers[idx]->ReceivedSysex(bytes, len);
+	}
+}
+
+
+MidiInSubscriberSet::~MidiInSubscriberSet()
+{
+	delete mPublished.exchange(nullptr);
+}
+
+bool
+MidiInSubscriberSet::Subscribe(IMidiInSubscriberPtr sub)
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	for (const auto & cur : mSubscribers)
+	{
+		if (cur == sub)
+			return false;
+	}
+
+	mSubscribers.push_back(sub);
+	Publish();
+	return true;
+}
+
+void
+MidiInSubscriberSet::Unsubscribe(IMidiInSubscriberPtr sub)
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	const auto it = std::find(mSubscribers.begin(), mSubscribers.end(), sub);
+	if (it == mSubscribers.end())
+		return;
+
+	mSubscribers.erase(it);
+	Publish();
+}
+
+void
+MidiInSubscriberSet::Rebuild()
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	Publish();
+}
+
+MidiInSubscriberSet::Subscribers
+MidiInSubscriberSet::Clear()
+{
+	std::lock_guard<std::mutex> lock(mLock);
+	Subscribers subs;
+	subs.swap(mSubscribers);
+	Publish();
+	return subs;
+}
+
+void
+MidiInSubscriberSet::CloseAll(IMidiInPtr midiIn)
+{
+	// Closed() typically calls Unsubscribe, so work from a copy
+	for (auto & curItem : Clear())
+	{
+		try
+		{
+			if (midiIn)
+				curItem->Closed(midiIn);
+		}
+		catch (const std::exception &)
+		{
+		}
+	}
+}
+
+// mLock held
+void
+MidiInSubscriberSet::Publish()
+{
+	// a router that was published but never picked up can go right away
+	delete mPublished.exchange(new MidiInRouter(mSubscribers), std::memory_order_acq_rel);
+}
+
+const MidiInRouter *
+MidiInSubscriberSet::CurrentRouter()
+{
+	if (MidiInRouter * next = mPublished.exchange(nullptr, std::memory_order_acq_rel))
+		mRouter.reset(next);
+	return mRouter.get();
+}
+
+void
+MidiInSubscriberSet::RouteData(byte b1, 
+							   byte b2, 
+							   byte b3)
+{
+	if (const MidiInRouter * router = CurrentRouter())
+		router->RouteData(b1, b2, b3);
+}
+
+void
+MidiInSubscriberSet::RouteSysex(const byte * bytes, 
+								int len)
+{
+	if (const MidiInRouter * router = CurrentRouter())
+		router->RouteSysex(bytes, len);
+}
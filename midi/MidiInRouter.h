@@ -0,0 +1,126 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef MidiInRouter_h__
+#define MidiInRouter_h__
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../Engine/IMidiInSubscriber.h"
+
+
+// MidiInRouter
+// ----------------------------------------------------------------------------
+// Dispatch table for a port's subscribers, built from their MidiInInterest.
+// Short messages are looked up by status/channel/data1 in a flat table;
+// sysex walks a trie of the registered prefixes.  Each message is only
+// delivered to the subscribers that asked for it, in subscription order.
+// Immutable once built.
+//
+class MidiInRouter
+{
+public:
+	using Subscribers = std::vector<IMidiInSubscriberPtr>;
+
+	MidiInRouter(const Subscribers & subs);
+
+	enum { kMaxSubscribers = 32 };
+
+	void RouteData(byte b1, byte b2, byte b3) const;
+	void RouteSysex(const byte * bytes, int len) const;
+
+private:
+	using SubscriberMask = unsigned int;
+
+	struct SysexNode
+	{
+		SubscriberMask							mMatch = 0;		// subscribers whose prefix ends here
+		std::vector<std::pair<byte, size_t>>	mChildren;
+	};
+
+	void AddShortMsg(const MidiInInterest::ShortMsg & msg, SubscriberMask sub);
+	void AddSysexPrefix(const std::vector<byte> & prefix, SubscriberMask sub);
+	static size_t ChannelMsgIndex(int status, int channel, int data1);
+
+	// status nibble 0x8-0xE, channel, data1
+	enum { kChannelMsgEntries = 7 * 16 * 128 };
+
+	Subscribers					mSubscribers;
+	std::vector<SubscriberMask>	mChannelMsgs;
+	SubscriberMask				mSystemMsgs[16] = { };
+	std::vector<SysexNode>		mSysexTrie;		// [0] is the root
+};
+
+
+// MidiInSubscriberSet
+// ----------------------------------------------------------------------------
+// A port's subscribers, changeable while input is running.
+// Writers (any thread) change the list under a lock and publish a new
+// immutable MidiInRouter.  The reader (the port's dispatch thread) picks
+// up the latest router with a single atomic exchange before routing an
+// event and never takes the lock; it is also the only thread that frees a
+// router it has been using, so no router is freed while in use.
+// A subscriber can receive events that were already being dispatched when
+// it unsubscribed.
+//
+class MidiInSubscriberSet
+{
+public:
+	using Subscribers = MidiInRouter::Subscribers;
+
+	MidiInSubscriberSet() = default;
+	~MidiInSubscriberSet();
+
+	bool Subscribe(IMidiInSubscriberPtr sub);
+	void Unsubscribe(IMidiInSubscriberPtr sub);
+	// re-reads the subscribers' MidiInInterest
+	void Rebuild();
+	// empties the set and returns what was in it
+	Subscribers Clear();
+	// empties the set and tells what was in it that the port has closed
+	void CloseAll(IMidiInPtr midiIn);
+
+	// dispatch thread only
+	void RouteData(byte b1, byte b2, byte b3);
+	void RouteSysex(const byte * bytes, int len);
+	// once the dispatch thread has exited; releases the subscribers it held
+	void DispatchStopped() { mRouter.reset(); }
+
+private:
+	MidiInSubscriberSet(const MidiInSubscriberSet &) = delete;
+	MidiInSubscriberSet & operator=(const MidiInSubscriberSet &) = delete;
+
+	void Publish();
+	const MidiInRouter * CurrentRouter();
+
+	std::mutex						mLock;
+	Subscribers						mSubscribers;		// guarded by mLock
+	std::atomic<MidiInRouter *>		mPublished{nullptr};
+	std::unique_ptr<MidiInRouter>	mRouter;			// dispatch thread only
+};
+
+#endif // MidiInRouter_h__
@@ -0,0 +1,709 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#include <format>
+#include "MidiOutQueue.h"
+#include "../Engine/ITraceDisplay.h"
+#include "../Engine/CrossPlatform.h"
+
+
+MidiOutQueue::MidiOutQueue(IMidiOutQueueSink * sink) :
+	mSink(sink)
+{
+	for (size_t idx = 0; idx < kRingSize; ++idx)
+		mCells[idx].mSequence.store(idx, std::memory_order_relaxed);
+
+	for (auto & cc : mPendingCcs)
+		cc.store(0, std::memory_order_relaxed);
+
+	mSliceBuffer.reserve(kMaxSliceLen);
+}
+
+MidiOutQueue::~MidiOutQueue()
+{
+	Stop();
+}
+
+void
+MidiOutQueue::Start()
+{
+	if (mRunning)
+		return;
+
+	_ASSERTE(!mSenderThread.joinable());
+	// device may have been reopened; never assume it remembers our status
+	// or anything else that was sent to it
+	mRunningStatus.Reset();
+	mShadow.Reset(-1);
+	mRunning = true;
+	mSenderThread = std::thread(&MidiOutQueue::SenderThread, this);
+}
+
+void
+MidiOutQueue::Stop()
+{
+	if (!mSenderThread.joinable())
+		return;
+
+	// sender thread drains whatever is already queued before exiting
+	mRunning = false;
+	mWakeCount.fetch_add(1, std::memory_order_release);
+	mWakeCount.notify_one();
+	mSenderThread.join();
+}
+
+void
+MidiOutQueue::Enqueue(unsigned int shortMsg)
+{
+	size_t pos;
+	Cell * cell = AcquireCell(pos);
+	if (!cell)
+		return;
+
+	cell->mType = CellType::ShortMsg;
+	cell->mShortMsg = shortMsg;
+	cell->mStateful = false;
+	SupersedeLatestValue(shortMsg);
+	Publish(cell, pos, mNextBatch.fetch_add(1, std::memory_order_relaxed));
+	WakeSender();
+}
+
+void
+MidiOutQueue::EnqueueLatestValue(byte statusByte, 
+								 byte controller, 
+								 byte value)
+{
+	_ASSERTE((statusByte & 0xF0) == 0xB0);
+	const unsigned int slot = ((statusByte & 0x0F) << 7) | (controller & 0x7F);
+	EnqueueLatestSlot(slot, value & 0x7F);
+}
+
+void
+MidiOutQueue::EnqueueLatestValue14(byte statusByte, 
+								   byte controller, 
+								   byte msb, 
+								   byte lsb)
+{
+	_ASSERTE((statusByte & 0xF0) == 0xB0 && controller < 32);
+	// one slot, keyed by the MSB controller, for both halves
+	const unsigned int slot = ((statusByte & 0x0F) << 7) | (controller & 0x1F);
+	EnqueueLatestSlot(slot, kCc14Bit | ((lsb & 0x7F) << 7) | (msb & 0x7F));
+}
+
+void
+MidiOutQueue::EnqueueLatestSlot(unsigned int slot, 
+								unsigned int slotValue)
+{
+	unsigned int prev = mPendingCcs[slot].load(std::memory_order_acquire);
+	unsigned int next;
+	do
+	{
+		next = (prev & kCcGenerationMask) | slotValue | kCcPending;
+	} while (!mPendingCcs[slot].compare_exchange_weak(prev, next, std::memory_order_acq_rel));
+
+	if (prev & kCcPending)
+	{
+		// a cell for this slot has not been sent yet; it will pick up the new value
+		++mCcCollapsed;
+		return;
+	}
+
+	const unsigned int generation = next & kCcGenerationMask;
+	size_t pos;
+	Cell * cell = AcquireCell(pos);
+	if (!cell)
+	{
+		// nothing will send it; let the next value queue a cell
+		mPendingCcs[slot].compare_exchange_strong(next, generation, std::memory_order_acq_rel);
+		return;
+	}
+
+	cell->mType = CellType::LatestValueCc;
+	cell->mShortMsg = slot;
+	cell->mSlotGeneration = generation;
+	Publish(cell, pos, mNextBatch.fetch_add(1, std::memory_order_relaxed));
+	WakeSender();
+}
+
+// A plain control change is queued after any pending latest value for its
+// controller (or for the MSB of a 14-bit pair it is the LSB of), which
+// would otherwise go out ahead of it with whatever value arrives later.
+// The pending value is older than the plain CC, so it isn't sent at all.
+void
+MidiOutQueue::SupersedeLatestValue(unsigned int shortMsg)
+{
+	if ((shortMsg & 0xF0) != 0xB0)
+		return;
+
+	const unsigned int channel = shortMsg & 0x0F;
+	const unsigned int controller = (shortMsg >> 8) & 0x7F;
+	SupersedeLatestSlot((channel << 7) | controller, false);
+	if (controller >= 32 && controller < 64)
+		SupersedeLatestSlot((channel << 7) | (controller - 32), true);
+}
+
+void
+MidiOutQueue::SupersedeLatestSlot(unsigned int slot, 
+								  bool only14Bit)
+{
+	unsigned int cur = mPendingCcs[slot].load(std::memory_order_acquire);
+	for (;;)
+	{
+		if (!(cur & kCcPending) || (only14Bit && !(cur & kCc14Bit)))
+			return;
+
+		const unsigned int nextGeneration = (cur + (1 << kCcGenerationShift)) & kCcGenerationMask;
+		if (mPendingCcs[slot].compare_exchange_weak(cur, nextGeneration, std::memory_order_acq_rel))
+			return;
+	}
+}
+
+void
+MidiOutQueue::Enqueue(const EncodedMidi & msgs)
+{
+	EnqueueMsgs(msgs, mNextBatch.fetch_add(1, std::memory_order_relaxed));
+	WakeSender();
+}
+
+void
+MidiOutQueue::Enqueue(std::span<const EncodedMidi * const> batch)
+{
+	// sender is woken once for the whole batch
+	const unsigned int batchId = mNextBatch.fetch_add(1, std::memory_order_relaxed);
+	for (const EncodedMidi * msgs : batch)
+		EnqueueMsgs(*msgs, batchId);
+	WakeSender();
+}
+
+void
+MidiOutQueue::EnqueueMsgs(const EncodedMidi & msgs, 
+						  unsigned int batch)
+{
+	// one cell per message so that latency is tracked per message and
+	// messages from other producers can only interleave at legal boundaries
+	for (const auto & msg : msgs.GetMessages())
+	{
+		size_t pos;
+		Cell * cell = AcquireCell(pos);
+		if (!cell)
+			return;
+
+		if (!msg.IsSysex())
+		{
+			cell->mType = CellType::ShortMsg;
+			cell->mShortMsg = msg.mEvent.GetShortMsg();
+			cell->mStateful = msgs.IsStateful();
+			SupersedeLatestValue(cell->mShortMsg);
+		}
+		else
+		{
+			cell->mType = CellType::Sysex;
+			const byte * data = msgs.GetSysexData(msg);
+			cell->mSysex.assign(data, data + msg.mSysexLength);
+		}
+		Publish(cell, pos, batch);
+	}
+}
+
+// returns nullptr if the ring is full and the sender has been stopped
+MidiOutQueue::Cell *
+MidiOutQueue::AcquireCell(size_t & pos)
+{
+	bool blocked = false;
+	pos = mEnqueuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		Cell * cell = &mCells[pos & (kRingSize - 1)];
+		const size_t seq = cell->mSequence.load(std::memory_order_acquire);
+		const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+		if (!diff)
+		{
+			if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				return cell;
+		}
+		else if (diff < 0)
+		{
+			// ring is full; only happens if the device has stalled
+			// with a thousand messages outstanding.  wait for the sender,
+			// unless there is none to wait for.
+			if (!blocked)
+			{
+				blocked = true;
+				++mOverruns;
+			}
+
+			if (!mRunning)
+				return nullptr;
+
+			WakeSender();
+			std::this_thread::yield();
+			pos = mEnqueuePos.load(std::memory_order_relaxed);
+		}
+		else
+			pos = mEnqueuePos.load(std::memory_order_relaxed);
+	}
+}
+
+void
+MidiOutQueue::Publish(Cell * cell,
+					  size_t pos, 
+					  unsigned int batch)
+{
+	cell->mBatch = batch;
+	cell->mEnqueueTime = Clock::now();
+	cell->mSequence.store(pos + 1, std::memory_order_release);
+}
+
+void
+MidiOutQueue::WakeSender()
+{
+	mWakeCount.fetch_add(1, std::memory_order_release);
+	mWakeCount.notify_one();
+}
+
+void
+MidiOutQueue::SenderThread()
+{
+	for (;;)
+	{
+		// read wake count before checking for data so that an enqueue
+		// that lands after the check still ends the wait
+		const unsigned int wake = mWakeCount.load(std::memory_order_acquire);
+		while (StageNext())
+			;
+
+		Clock::time_point waitUntil;
+		if (SendStaged(waitUntil))
+		{
+			// held back by pacing; new arrivals may outrank what is waiting
+			// so poll the wake count rather than sleeping the whole interval
+			while (Clock::now() < waitUntil && mWakeCount.load(std::memory_order_acquire) == wake)
+			{
+				const auto nextPoll = Clock::now() + std::chrono::milliseconds(1);
+				std::this_thread::sleep_until(nextPoll < waitUntil ? nextPoll : waitUntil);
+			}
+			continue;
+		}
+
+		bool staged = false;
+		for (const auto & queue : mStaged)
+		{
+			if (!queue.Empty())
+			{
+				staged = true;
+				break;
+			}
+		}
+
+		if (staged)
+			continue;
+
+		mPacingHeld = false;
+
+		// queued data has been drained before exit
+		if (!mRunning)
+			break;
+
+		mWakeCount.wait(wake, std::memory_order_acquire);
+	}
+}
+
+bool
+MidiOutQueue::StageNext()
+{
+	Cell * cell = &mCells[mDequeuePos & (kRingSize - 1)];
+	const size_t seq = cell->mSequence.load(std::memory_order_acquire);
+	if (seq != mDequeuePos + 1)
+		return false;
+
+	Priority pri;
+	if (CellType::Sysex == cell->mType)
+		pri = priBulk;
+	else if (CellType::LatestValueCc == cell->mType)
+		pri = priControlChange;
+	else
+	{
+		const unsigned int status = cell->mShortMsg & 0xFF;
+		if (status >= 0xF8)
+			pri = priRealtime;
+		else if ((status & 0xF0) == 0xB0)
+			pri = priControlChange;
+		else
+			pri = priChannel;
+	}
+
+	// leave it in the ring until there is room for it (and let it be
+	// checked against the shadow only once)
+	if (mStaged[pri].Full())
+		return false;
+
+	if (ShadowSuppresses(*cell))
+	{
+		cell->mSequence.store(mDequeuePos + kRingSize, std::memory_order_release);
+		++mDequeuePos;
+		return true;
+	}
+
+	Staged & msg = mStaged[pri].PushBack();
+	msg.mType = cell->mType;
+	msg.mShortMsg = cell->mShortMsg;
+	msg.mEnqueueTime = cell->mEnqueueTime;
+	msg.mOrder = mNextOrder++;
+	msg.mBatch = cell->mBatch;
+	msg.mSlotGeneration = cell->mSlotGeneration;
+	msg.mSysexSent = 0;
+	if (CellType::Sysex == cell->mType)
+	{
+		// trade buffers so that neither side allocates once warmed up
+		msg.mSysex.clear();
+		msg.mSysex.swap(cell->mSysex);
+	}
+
+	// release cell for reuse by producers
+	cell->mSequence.store(mDequeuePos + kRingSize, std::memory_order_release);
+	++mDequeuePos;
+	return true;
+}
+
+// Messages are checked against the shadow in the order they were queued
+// rather than the order they go out in.  Messages are only reordered across
+// channels, and in that case the shadow ends up knowing less than the
+// device rather than something different.
+bool
+MidiOutQueue::ShadowSuppresses(const Cell & cell)
+{
+	if (!mShadow.IsEnabled())
+		return false;
+
+	switch (cell.mType)
+	{
+	case CellType::ShortMsg:
+		return mShadow.Suppress(cell.mShortMsg, cell.mStateful);
+	case CellType::Sysex:
+		return mShadow.Suppress(cell.mSysex.data(), cell.mSysex.size());
+	case CellType::LatestValueCc:
+		// value (and whether it has an LSB) is taken when it is sent
+		mShadow.Forget(cell.mShortMsg >> 7, cell.mShortMsg & 0x7F);
+		if ((cell.mShortMsg & 0x7F) < 32)
+			mShadow.Forget(cell.mShortMsg >> 7, (cell.mShortMsg & 0x7F) + 32);
+		break;
+	}
+
+	return false;
+}
+
+MidiOutQueue::StagedRing *
+MidiOutQueue::SelectQueue()
+{
+	if (!mStaged[priRealtime].Empty())
+		return &mStaged[priRealtime];
+
+	// everything else goes in the order it was queued
+	StagedRing * oldest = nullptr;
+	for (int pri = priControlChange; pri < priCount; ++pri)
+	{
+		if (!mStaged[pri].Empty() && (!oldest || mStaged[pri].Front().mOrder < oldest->Front().mOrder))
+			oldest = &mStaged[pri];
+	}
+
+	// unless the link is the bottleneck, in which case control changes
+	// (pedals) need not wait for everything ahead of them
+	if (mPacingHeld && oldest && oldest != &mStaged[priControlChange] && 
+		!mStaged[priControlChange].Empty() && CanOvertake(mStaged[priControlChange].Front()))
+		return &mStaged[priControlChange];
+
+	return oldest;
+}
+
+bool
+MidiOutQueue::CanOvertake(const Staged & cc) const
+{
+	// nothing may be interleaved in a sysex message, and a CC might be 
+	// meant to follow any sysex ahead of it
+	const StagedRing & bulk = mStaged[priBulk];
+	if (!bulk.Empty() && bulk.Front().mOrder < cc.mOrder)
+		return false;
+
+	// don't let a CC overtake part of its own batch or an older message for
+	// the same channel (e.g. a program change that the CC is meant to follow)
+	const unsigned int ccChannel = (CellType::LatestValueCc == cc.mType) ? (cc.mShortMsg >> 7) : (cc.mShortMsg & 0x0F);
+	const StagedRing & channel = mStaged[priChannel];
+	for (size_t idx = 0; idx < channel.Size(); ++idx)
+	{
+		const Staged & msg = channel.At(idx);
+		if (msg.mOrder > cc.mOrder)
+			break;
+
+		if (msg.mBatch == cc.mBatch)
+			return false;
+
+		if ((msg.mShortMsg & 0xF0) < 0xF0 && (msg.mShortMsg & 0x0F) == ccChannel)
+			return false;
+	}
+
+	return true;
+}
+
+bool
+MidiOutQueue::SendStaged(Clock::time_point & waitUntil)
+{
+	StagedRing * queue = SelectQueue();
+	if (!queue)
+		return false;
+
+	Staged & msg = queue->Front();
+	const unsigned int bytesPerSecond = mBytesPerSecond;
+	const Clock::time_point now = Clock::now();
+	if (bytesPerSecond && now < mWireFreeAt && queue != &mStaged[priRealtime])
+	{
+		// realtime goes out immediately; everything else waits for the link
+		waitUntil = mWireFreeAt;
+		mPacingHeld = true;
+		return true;
+	}
+
+	unsigned int wireBytes = 0;
+	bool done = true;
+	bool sent = true;
+	switch (msg.mType)
+	{
+	case CellType::ShortMsg:
+		wireBytes = SendShortMsg(msg.mShortMsg);
+		break;
+	case CellType::Sysex:
+		{
+			// about 10ms of link time per slice so that clock ticks are
+			// never held up for long
+			size_t sliceLen = bytesPerSecond ? bytesPerSecond / 100 : kMaxSliceLen;
+			if (sliceLen < 16)
+				sliceLen = 16;
+			else if (sliceLen > kMaxSliceLen)
+				sliceLen = kMaxSliceLen;
+
+			const size_t remaining = msg.mSysex.size() - msg.mSysexSent;
+			if (!msg.mSysexSent && remaining < sliceLen && queue->Size() > 1)
+			{
+				// short messages that follow go out in the same buffer
+				wireBytes = (unsigned int)CoalesceSysex(sliceLen);
+				if (wireBytes)
+				{
+					mRunningStatus.SysexSent();
+					++mSysexSlices;
+					break;
+				}
+			}
+
+			if (sliceLen > remaining)
+				sliceLen = remaining;
+
+			mSink->SendSysex(msg.mSysex.data() + msg.mSysexSent, sliceLen);
+			msg.mSysexSent += sliceLen;
+			mRunningStatus.SysexSent();
+			++mSysexSlices;
+			wireBytes = (unsigned int)sliceLen;
+			done = msg.mSysexSent == msg.mSysex.size();
+		}
+		break;
+	case CellType::LatestValueCc:
+		wireBytes = SendLatestValue(msg.mShortMsg, msg.mSlotGeneration);
+		sent = 0 != wireBytes;
+		break;
+	}
+
+	mBytesSent += wireBytes;
+	if (bytesPerSecond)
+	{
+		const Clock::time_point start = mWireFreeAt < now ? now : mWireFreeAt;
+		mWireFreeAt = start + std::chrono::microseconds(wireBytes * 1000000ull / bytesPerSecond);
+	}
+
+	if (done)
+	{
+		// front may have changed if sysex was coalesced
+		if (sent)
+			MessageDone(queue->Front());
+		queue->PopFront();
+	}
+
+	return false;
+}
+
+// Sends as many whole, unstarted sysex messages from the front of the bulk
+// queue as fit in one slice as a single buffer.  All but the last are
+// retired here; the caller retires the last.  Returns 0 if only the first
+// message fits.
+size_t
+MidiOutQueue::CoalesceSysex(size_t sliceLen)
+{
+	StagedRing & bulk = mStaged[priBulk];
+	size_t count = 0;
+	size_t len = 0;
+	for (; count < bulk.Size(); ++count)
+	{
+		// only messages queued one after the other
+		const Staged & msg = bulk.At(count);
+		if (len + msg.mSysex.size() > sliceLen || msg.mOrder != bulk.Front().mOrder + count)
+			break;
+
+		len += msg.mSysex.size();
+	}
+
+	if (count < 2)
+		return 0;
+
+	mSliceBuffer.clear();
+	for (size_t idx = 0; idx < count; ++idx)
+	{
+		const Bytes & sysex = bulk.At(idx).mSysex;
+		mSliceBuffer.insert(mSliceBuffer.end(), sysex.begin(), sysex.end());
+	}
+
+	mSink->SendSysex(mSliceBuffer.data(), mSliceBuffer.size());
+	mSysexCoalesced += count - 1;
+
+	for (size_t idx = 0; idx + 1 < count; ++idx)
+	{
+		MessageDone(bulk.Front());
+		bulk.PopFront();
+	}
+
+	Staged & last = bulk.Front();
+	last.mSysexSent = last.mSysex.size();
+	return len;
+}
+
+void
+MidiOutQueue::MessageDone(const Staged & msg)
+{
+	const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - msg.mEnqueueTime);
+	const unsigned int latencyUs = (unsigned int)latency.count();
+	++mMessagesSent;
+	mTotalLatencyUs += latencyUs;
+	if (latencyUs > mMaxLatencyUs.load(std::memory_order_relaxed))
+		mMaxLatencyUs.store(latencyUs, std::memory_order_relaxed);
+
+	for (const auto & queue : mStaged)
+	{
+		if (!queue.Empty() && queue.Front().mOrder < msg.mOrder)
+		{
+			++mOvertakes;
+			break;
+		}
+	}
+}
+
+unsigned int
+MidiOutQueue::SendShortMsg(unsigned int shortMsg)
+{
+	const unsigned int bytes = 1 + EncodedMidi::GetDataByteCount(shortMsg & 0xFF);
+	if (!mUseRunningStatus)
+	{
+		mRunningStatus.Reset();
+		mSink->SendShortMsg(shortMsg);
+		return bytes;
+	}
+
+	const unsigned int wireMsg = mRunningStatus.Encode(shortMsg);
+	mSink->SendShortMsg(wireMsg);
+	if (wireMsg == shortMsg)
+		return bytes;
+
+	++mStatusBytesDropped;
+	return bytes - 1;
+}
+
+unsigned int
+MidiOutQueue::SendLatestValue(unsigned int slot, 
+							  unsigned int generation)
+{
+	// claim whatever value is current; later values queue a new cell
+	unsigned int slotValue = mPendingCcs[slot].load(std::memory_order_acquire);
+	do
+	{
+		// superseded by a plain CC queued after this message
+		if (!(slotValue & kCcPending) || (slotValue & kCcGenerationMask) != generation)
+			return 0;
+	} while (!mPendingCcs[slot].compare_exchange_weak(slotValue, generation, std::memory_order_acq_rel));
+
+	const unsigned int status = 0xB0 | (slot >> 7);
+	const unsigned int controller = slot & 0x7F;
+	unsigned int wireBytes = SendShortMsg(status | (controller << 8) | ((slotValue & 0x7F) << 16));
+	if (slotValue & kCc14Bit)
+		wireBytes += SendShortMsg(status | ((controller + 32) << 8) | (((slotValue >> 7) & 0x7F) << 16));
+	return wireBytes;
+}
+
+MidiOutQueue::Stats
+MidiOutQueue::GetStats() const
+{
+	Stats stats;
+	stats.mMessagesSent = mMessagesSent;
+	stats.mTotalLatencyUs = mTotalLatencyUs;
+	stats.mMaxLatencyUs = mMaxLatencyUs;
+	stats.mOverruns = mOverruns;
+	stats.mCcCollapsed = mCcCollapsed;
+	stats.mStatusBytesDropped = mStatusBytesDropped;
+	stats.mBytesSent = mBytesSent;
+	stats.mSysexSlices = mSysexSlices;
+	stats.mOvertakes = mOvertakes;
+	stats.mSysexCoalesced = mSysexCoalesced;
+	return stats;
+}
+
+void
+MidiOutQueue::ResetStats()
+{
+	mMessagesSent = 0;
+	mTotalLatencyUs = 0;
+	mMaxLatencyUs = 0;
+	mOverruns = 0;
+	mCcCollapsed = 0;
+	mStatusBytesDropped = 0;
+	mBytesSent = 0;
+	mSysexSlices = 0;
+	mOvertakes = 0;
+	mSysexCoalesced = 0;
+	mShadow.ResetStats();
+}
+
+void
+MidiOutQueue::ReportStats(ITraceDisplay * trace, 
+						  const std::string & portName)
+{
+	const Stats stats(GetStats());
+	if (stats.mMessagesSent && trace)
+	{
+		trace->Trace(std::format("MIDI out {}: {} messages ({} bytes, {} sysex slices), enqueue-to-wire latency avg {} us, max {} us, {} overruns, {} CCs collapsed, {} status bytes saved, {} prioritized, {} sysex coalesced\n",
+			portName, stats.mMessagesSent, stats.mBytesSent, stats.mSysexSlices, stats.mTotalLatencyUs / stats.mMessagesSent, stats.mMaxLatencyUs, 
+			stats.mOverruns, stats.mCcCollapsed, stats.mStatusBytesDropped, stats.mOvertakes, stats.mSysexCoalesced));
+	}
+
+	const MidiShadowStats shadowStats(GetShadowStats());
+	if (shadowStats.mMessagesSuppressed && trace)
+	{
+		trace->Trace(std::format("MIDI out {}: {} messages ({} bytes) not sent, device already in that state\n",
+			portName, shadowStats.mMessagesSuppressed, shadowStats.mBytesSuppressed));
+	}
+	ResetStats();
+}
@@ -0,0 +1,246 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#ifndef MidiOutQueue_h__
+#define MidiOutQueue_h__
+
+#include <atomic>
+#include <chrono>
+#include <span>
+#include <thread>
+#include "../Engine/IMidiOut.h"
+#include "MidiOutShadow.h"
+#include "RunningStatusEncoder.h"
+
+class ITraceDisplay;
+
+
+// IMidiOutQueueSink
+// ----------------------------------------------------------------------------
+// implemented by a midi out backend to put queued data on the wire.
+// only ever called on the MidiOutQueue sender thread.
+// SendSysex receives consecutive slices of a message (the first begins with
+// F0, the last ends with F7); pacing is done by the queue, not the sink.
+// data is only valid for the duration of the call.
+//
+class IMidiOutQueueSink
+{
+public:
+	virtual ~IMidiOutQueueSink() = default;
+
+	virtual void SendShortMsg(unsigned int shortMsg) = 0;
+	virtual void SendSysex(const byte * data, size_t len) = 0;
+};
+
+
+// MidiOutQueue
+// ----------------------------------------------------------------------------
+// Per-port output stage.  Any thread can enqueue without taking a lock or
+// waiting on the device; a dedicated sender thread drains the ring into the
+// sink so that driver stalls (MIDIERR_NOTREADY, sysex pacing) never block
+// the thread that pressed the switch.
+// Bounded multi-producer/single-consumer ring (per-cell sequence numbers).
+//
+// The sender thread moves everything in the ring into per-priority staging
+// rings of the same size (once one is full, the rest waits in the ring):
+//   realtime (0xF8-0xFF) > control change > other channel/system > sysex
+// (MIDI clock ticks don't go through the queue; backends send them
+// directly so that they never wait on the sender thread.)
+// Realtime goes out as soon as it arrives; everything else goes out in the
+// order it was queued.  Output is paced to the configured link bandwidth,
+// if any (USB and virtual ports are not paced by default).  While pacing
+// holds output back, a control change may overtake older messages, but
+// never one queued by the same Enqueue call, one for the same channel, or
+// any sysex (which device a sysex message is for is not known).
+// Sysex is sent in slices; only realtime bytes are interleaved between the
+// slices of a message (the only legal interleave).
+// With shadow state enabled, messages that would not change the state of
+// the device are dropped as they are moved out of the ring (see
+// MidiOutShadow).
+//
+class MidiOutQueue
+{
+public:
+	MidiOutQueue(IMidiOutQueueSink * sink);
+	~MidiOutQueue();
+
+	void Start();
+	// sends what is queued, then stops.  while stopped, a message that
+	// finds the ring full is dropped rather than waiting.
+	void Stop();
+	bool IsRunning() const { return mRunning; }
+	void EnableRunningStatus(bool enable) { mUseRunningStatus = enable; }
+	// 0 (the default) for no pacing
+	void SetBandwidth(unsigned int bytesPerSecond) { mBytesPerSecond = bytesPerSecond; }
+	void EnableShadowState(unsigned int channelMask, int axeFxChannel) { mShadow.Enable(channelMask, axeFxChannel); }
+	void ResetShadowState(int channel) { mShadow.Reset(channel); }
+	MidiShadowStats GetShadowStats() const { return mShadow.GetStats(); }
+
+	void Enqueue(unsigned int shortMsg);
+	void Enqueue(const EncodedMidi & msgs);
+	void Enqueue(std::span<const EncodedMidi * const> batch);
+	// control change where only the most recent value matters (pedals).
+	// if a CC for the same channel/controller is still waiting in the ring,
+	// its value is replaced rather than queueing another message.  a plain
+	// control change queued for the controller after it supersedes it, so
+	// that a newer pedal value never goes out ahead of an older CC.
+	void EnqueueLatestValue(byte statusByte, byte controller, byte value);
+	// 14-bit control change: controller (0-31) then its LSB (controller + 32),
+	// coalesced as a pair so that an MSB never goes out with a stale LSB
+	void EnqueueLatestValue14(byte statusByte, byte controller, byte msb, byte lsb);
+
+	struct Stats
+	{
+		unsigned long long	mMessagesSent = 0;
+		unsigned long long	mTotalLatencyUs = 0;	// enqueue to return from sink
+		unsigned int		mMaxLatencyUs = 0;
+		unsigned int		mOverruns = 0;			// enqueues that found the ring full
+		unsigned long long	mCcCollapsed = 0;		// latest value CCs that replaced a pending value
+		unsigned long long	mStatusBytesDropped = 0;	// saved by running status
+		unsigned long long	mBytesSent = 0;
+		unsigned long long	mSysexSlices = 0;
+		unsigned long long	mOvertakes = 0;			// messages sent ahead of older pending messages
+		unsigned long long	mSysexCoalesced = 0;	// sysex messages sent in the same buffer as the one before
+	};
+
+	Stats GetStats() const;
+	void ResetStats();
+	// traces the queue and shadow state stats, if anything was sent or
+	// suppressed, then resets them
+	void ReportStats(ITraceDisplay * trace, const std::string & portName);
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	enum class CellType { ShortMsg, Sysex, LatestValueCc };
+	enum Priority { priRealtime, priControlChange, priChannel, priBulk, priCount };
+	enum { kRingSize = 1024 };	// must be power of 2
+	static_assert((kRingSize & (kRingSize - 1)) == 0, "ring size must be power of 2");
+	enum { kMaxSliceLen = 256 };	// bytes of sysex sent at once
+
+	struct Cell
+	{
+		std::atomic<size_t>	mSequence{0};
+		CellType			mType = CellType::ShortMsg;
+		unsigned int		mShortMsg = 0;		// for LatestValueCc, channel << 7 | controller (index into mPendingCcs)
+		unsigned int		mBatch = 0;			// messages of one Enqueue call share a batch
+		unsigned int		mSlotGeneration = 0;	// for LatestValueCc, see mPendingCcs
+		bool				mStateful = false;	// see EncodedMidi::IsStateful
+		Bytes				mSysex;		// capacity is retained across reuse of the cell
+		Clock::time_point	mEnqueueTime;
+	};
+
+	// a message moved out of the ring, waiting for its turn on the wire
+	struct Staged
+	{
+		CellType			mType = CellType::ShortMsg;
+		unsigned int		mShortMsg = 0;
+		Bytes				mSysex;		// traded with the buffer of the cell it came from
+		size_t				mSysexSent = 0;
+		Clock::time_point	mEnqueueTime;
+		unsigned long long	mOrder = 0;
+		unsigned int		mBatch = 0;
+		unsigned int		mSlotGeneration = 0;
+	};
+
+	// fixed-capacity FIFO of staged messages.  slots are reused so that
+	// staging never allocates.
+	class StagedRing
+	{
+	public:
+		bool Empty() const { return mHead == mTail; }
+		bool Full() const { return mTail - mHead == kRingSize; }
+		size_t Size() const { return mTail - mHead; }
+		Staged & Front() { return At(0); }
+		const Staged & Front() const { return At(0); }
+		Staged & At(size_t idx) { return mSlots[(mHead + idx) & (kRingSize - 1)]; }
+		const Staged & At(size_t idx) const { return mSlots[(mHead + idx) & (kRingSize - 1)]; }
+		// the slot keeps whatever the message that last used it left in it
+		Staged & PushBack() { return mSlots[mTail++ & (kRingSize - 1)]; }
+		void PopFront() { ++mHead; }
+
+	private:
+		Staged	mSlots[kRingSize];
+		size_t	mHead = 0;
+		size_t	mTail = 0;
+	};
+
+	Cell * AcquireCell(size_t & pos);
+	void Publish(Cell * cell, size_t pos, unsigned int batch);
+	void EnqueueMsgs(const EncodedMidi & msgs, unsigned int batch);
+	void EnqueueLatestSlot(unsigned int slot, unsigned int slotValue);
+	void SupersedeLatestValue(unsigned int shortMsg);
+	void SupersedeLatestSlot(unsigned int slot, bool only14Bit);
+	void WakeSender();
+	void SenderThread();
+	bool StageNext();
+	bool ShadowSuppresses(const Cell & cell);
+	bool SendStaged(Clock::time_point & waitUntil);
+	StagedRing * SelectQueue();
+	bool CanOvertake(const Staged & cc) const;
+	unsigned int SendShortMsg(unsigned int shortMsg);
+	unsigned int SendLatestValue(unsigned int slot, unsigned int generation);
+	void MessageDone(const Staged & msg);
+	size_t CoalesceSysex(size_t sliceLen);
+
+	IMidiOutQueueSink			* mSink;
+	Cell						mCells[kRingSize];
+	alignas(64) std::atomic<size_t>	mEnqueuePos{0};
+	alignas(64) size_t			mDequeuePos = 0;
+	std::atomic<unsigned int>	mWakeCount{0};
+	std::atomic<unsigned int>	mNextBatch{0};
+
+	// latest value per channel/controller: value | LSB << 7 for 14-bit;
+	// kCcPending set while a message referring to the slot is unsent.
+	// the generation changes when a plain CC supersedes the pending value;
+	// a message for an older generation is not sent.
+	enum { kCcPending = 0x80000000, kCc14Bit = 0x40000000, kCcGenerationShift = 14, kCcGenerationMask = 0x3FFFC000 };
+	std::atomic<unsigned int>	mPendingCcs[16 * 128];
+	std::atomic_bool			mRunning{false};
+	std::atomic_bool			mUseRunningStatus{false};
+	std::atomic<unsigned int>	mBytesPerSecond{0};
+	std::thread					mSenderThread;
+	MidiOutShadow				mShadow;		// model changed on the sender thread only
+
+	// sender thread only
+	RunningStatusEncoder		mRunningStatus;
+	StagedRing					mStaged[priCount];
+	unsigned long long			mNextOrder = 0;
+	Clock::time_point			mWireFreeAt;	// when the link model has sent everything so far
+	bool						mPacingHeld = false;	// pacing has held back what is staged
+	Bytes						mSliceBuffer;	// consecutive short sysex messages sent as one buffer
+
+	std::atomic<unsigned long long>	mMessagesSent{0};
+	std::atomic<unsigned long long>	mTotalLatencyUs{0};
+	std::atomic<unsigned int>		mMaxLatencyUs{0};
+	std::atomic<unsigned int>		mOverruns{0};
+	std::atomic<unsigned long long>	mCcCollapsed{0};
+	std::atomic<unsigned long long>	mStatusBytesDropped{0};
+	std::atomic<unsigned long long>	mBytesSent{0};
+	std::atomic<unsigned long long>	mSysexSlices{0};
+	std::atomic<unsigned long long>	mOvertakes{0};
+	std::atomic<unsigned long long>	mSysexCoalesced{0};
+};
+
+#endif // MidiOutQueue_h__
@@ -0,0 +1,259 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#include <cstring>
+#include "MidiOutShadow.h"
+#include "../Engine/AxeFxModel.h"
+#include "../Engine/CrossPlatform.h"
+
+
+// Axe-Fx III set messages (see AxeFx3MessageIds); a value out of range is
+// a query
+//   F0 00 01 74 10 0A idLs idMs bypass cs F7
+//   F0 00 01 74 10 0B idLs idMs channel cs F7
+//   F0 00 01 74 10 0C scene cs F7
+constexpr byte kAxeFx3Header[] = { 0xf0, 0x00, 0x01, 0x74, Axe3 };
+constexpr byte kAxeFxEffectBypass = 0x0a;
+constexpr byte kAxeFxEffectChannel = 0x0b;
+constexpr byte kAxeFxScene = 0x0c;
+constexpr byte kAxeFxBlockChannels = 4;
+constexpr byte kAxeFxScenes = 8;
+
+
+MidiOutShadow::MidiOutShadow()
+{
+	for (unsigned int channel = 0; channel < 16; ++channel)
+		ForgetChannel(channel);
+	ForgetAxeFx();
+}
+
+void
+MidiOutShadow::Enable(unsigned int channelMask, 
+					  int axeFxChannel)
+{
+	// nothing that was sent while disabled was recorded
+	mAxeFxChannel.store(axeFxChannel, std::memory_order_relaxed);
+	mChannelMask.store(channelMask & kAllChannels, std::memory_order_relaxed);
+	Reset(-1);
+}
+
+void
+MidiOutShadow::Reset(int channel)
+{
+	_ASSERTE(channel >= -1 && channel < 16);
+	const unsigned int channels = -1 == channel ? kAllChannels : 1u << (channel & 0x0F);
+	mPendingResets.fetch_or(channels, std::memory_order_release);
+}
+
+MidiShadowStats
+MidiOutShadow::GetStats() const
+{
+	MidiShadowStats stats;
+	stats.mMessagesSuppressed = mMessagesSuppressed;
+	stats.mBytesSuppressed = mBytesSuppressed;
+	return stats;
+}
+
+void
+MidiOutShadow::ResetStats()
+{
+	mMessagesSuppressed = 0;
+	mBytesSuppressed = 0;
+}
+
+bool
+MidiOutShadow::Suppress(unsigned int shortMsg, 
+						bool stateful)
+{
+	const unsigned int status = shortMsg & 0xFF;
+	if (0xFF == status)
+	{
+		// system reset
+		Reset(-1);
+		return false;
+	}
+
+	const unsigned int channel = status & 0x0F;
+	if (status >= 0xF0 || !(mChannelMask.load(std::memory_order_relaxed) & (1u << channel)))
+		return false;
+
+	ApplyResets();
+	const byte data1 = (shortMsg >> 8) & 0x7F;
+	const byte data2 = (shortMsg >> 16) & 0x7F;
+	switch (status & 0xF0)
+	{
+	case 0xB0:
+		if (data1 >= 120)
+		{
+			// channel mode messages; reset all controllers is the only one
+			// with state we track
+			if (121 == data1)
+				ForgetChannel(channel);
+			return false;
+		}
+
+		if (stateful && mControllers[channel][data1] == data2)
+		{
+			Suppressed(3);
+			return true;
+		}
+
+		mControllers[channel][data1] = data2;
+		ChannelChanged(channel);
+		return false;
+	case 0xC0:
+		if (mPrograms[channel] == data1)
+		{
+			Suppressed(2);
+			return true;
+		}
+
+		// preset load; everything else on the channel is unknown
+		ForgetChannel(channel);
+		mPrograms[channel] = data1;
+		return false;
+	}
+
+	return false;
+}
+
+bool
+MidiOutShadow::Suppress(const byte * sysex, 
+						size_t len)
+{
+	const int axeFxChannel = mAxeFxChannel.load(std::memory_order_relaxed);
+	if (-1 == axeFxChannel || 
+		!(mChannelMask.load(std::memory_order_relaxed) & (1u << axeFxChannel)) ||
+		len < 9 ||
+		::memcmp(sysex, kAxeFx3Header, sizeof(kAxeFx3Header)))
+	{
+		return false;
+	}
+
+	ApplyResets();
+	switch (sysex[5])
+	{
+	case kAxeFxEffectBypass:
+	case kAxeFxEffectChannel:
+		{
+			const unsigned int block = sysex[6] | (sysex[7] << 7);
+			const byte value = sysex[8];
+			const bool isBypass = kAxeFxEffectBypass == sysex[5];
+			if (11 != len || block >= kAxeFxBlocks || value >= (isBypass ? 2 : kAxeFxBlockChannels))
+				return false;
+
+			byte & state = isBypass ? mAxeFxBypass[block] : mAxeFxBlockChannels[block];
+			if (state == value)
+			{
+				Suppressed(len);
+				return true;
+			}
+
+			// reselecting the scene or preset would now revert this
+			state = value;
+			mAxeFxScene = kUnknown;
+			mPrograms[axeFxChannel] = kUnknown;
+		}
+		return false;
+	case kAxeFxScene:
+		if (9 != len || sysex[6] >= kAxeFxScenes)
+			return false;
+
+		if (mAxeFxScene == sysex[6])
+		{
+			Suppressed(len);
+			return true;
+		}
+
+		// the scene sets bypass and channel of every block
+		ForgetAxeFx();
+		mAxeFxScene = sysex[6];
+		mPrograms[axeFxChannel] = kUnknown;
+		return false;
+	}
+
+	return false;
+}
+
+void
+MidiOutShadow::Forget(unsigned int channel, 
+					  unsigned int controller)
+{
+	_ASSERTE(channel < 16 && controller < 128);
+	if (!(mChannelMask.load(std::memory_order_relaxed) & (1u << channel)))
+		return;
+
+	ApplyResets();
+	mControllers[channel][controller] = kUnknown;
+	ChannelChanged(channel);
+}
+
+void
+MidiOutShadow::ApplyResets()
+{
+	if (!mPendingResets.load(std::memory_order_relaxed))
+		return;
+
+	const unsigned int channels = mPendingResets.exchange(0, std::memory_order_acquire);
+	for (unsigned int channel = 0; channel < 16; ++channel)
+	{
+		if (channels & (1u << channel))
+			ForgetChannel(channel);
+	}
+}
+
+void
+MidiOutShadow::ForgetChannel(unsigned int channel)
+{
+	std::memset(mControllers[channel], kUnknown, sizeof(mControllers[channel]));
+	mPrograms[channel] = kUnknown;
+	if ((int)channel == mAxeFxChannel.load(std::memory_order_relaxed))
+		ForgetAxeFx();
+}
+
+void
+MidiOutShadow::ForgetAxeFx()
+{
+	std::memset(mAxeFxBypass, kUnknown, sizeof(mAxeFxBypass));
+	std::memset(mAxeFxBlockChannels, kUnknown, sizeof(mAxeFxBlockChannels));
+	mAxeFxScene = kUnknown;
+}
+
+void
+MidiOutShadow::ChannelChanged(unsigned int channel)
+{
+	// resending the program would now revert the change
+	mPrograms[channel] = kUnknown;
+
+	// the Axe-Fx can map controllers to bypass, channel and scene
+	if ((int)channel == mAxeFxChannel.load(std::memory_order_relaxed))
+		ForgetAxeFx();
+}
+
+void
+MidiOutShadow::Suppressed(size_t bytes)
+{
+	mMessagesSuppressed.fetch_add(1, std::memory_order_relaxed);
+	mBytesSuppressed.fetch_add(bytes, std::memory_order_relaxed);
+}
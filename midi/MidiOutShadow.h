@@ -0,0 +1,100 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#ifndef MidiOutShadow_h__
+#define MidiOutShadow_h__
+
+#include <atomic>
+#include "../Engine/IMidiOut.h"
+
+
+// MidiOutShadow
+// ----------------------------------------------------------------------------
+// Model of the state of the devices on one port, built from what has been
+// sent to them, so that sends that would not change anything can be
+// dropped.  Per channel: the last value of each controller and the last
+// program; for an Axe-Fx III on one of the channels: block bypass, block
+// channel and scene.
+// A program change is only redundant if nothing that changes state has
+// been sent on the channel since it (resending a program reloads the
+// preset), and likewise for an Axe-Fx scene and the block state sent since.
+// Only control changes that set a state (see EncodedMidi::IsStateful) are
+// dropped; others (tap tempo, looper commands) act every time they are
+// sent, but their values are still recorded.
+// A program change makes the controllers of its channel unknown; an
+// Axe-Fx scene makes its block state unknown; a control change on the
+// Axe-Fx channel makes all of its state unknown.
+// Sysex other than the Axe-Fx III set messages, and other channel messages,
+// are neither shadowed nor affect the model; devices that change state on
+// their own (front panel, sysex from elsewhere) should not be shadowed, or
+// should call Reset when they report a change.
+// Only Suppress and Forget change the model, on one thread, in the order
+// that messages are sent.
+//
+class MidiOutShadow
+{
+public:
+	MidiOutShadow();
+
+	// any thread
+	void Enable(unsigned int channelMask, int axeFxChannel);
+	bool IsEnabled() const { return mChannelMask.load(std::memory_order_relaxed) != 0; }
+	// applied before the next message that is shadowed (-1 for all channels)
+	void Reset(int channel);
+	MidiShadowStats GetStats() const;
+	void ResetStats();
+
+	// true if the message would leave the device as it is; the message is
+	// counted as suppressed and should be dropped.  otherwise the model is
+	// updated for the message.
+	bool Suppress(unsigned int shortMsg, bool stateful);
+	bool Suppress(const byte * sysex, size_t len);
+	// control change whose value isn't known until it is sent (pedals)
+	void Forget(unsigned int channel, unsigned int controller);
+
+private:
+	void ApplyResets();
+	void ForgetChannel(unsigned int channel);
+	void ForgetAxeFx();
+	void ChannelChanged(unsigned int channel);
+	void Suppressed(size_t bytes);
+
+	enum { kUnknown = 0xFF, kAxeFxBlocks = 256 };
+	static constexpr unsigned int kAllChannels = 0xFFFF;	// channel bits
+
+	std::atomic<unsigned int>	mChannelMask{0};
+	std::atomic<int>			mAxeFxChannel{-1};
+	std::atomic<unsigned int>	mPendingResets{0};	// channel bits
+	std::atomic<unsigned long long>	mMessagesSuppressed{0};
+	std::atomic<unsigned long long>	mBytesSuppressed{0};
+
+	// Suppress/Forget thread only
+	byte						mControllers[16][128];
+	byte						mPrograms[16];
+	byte						mAxeFxBypass[kAxeFxBlocks];
+	byte						mAxeFxBlockChannels[kAxeFxBlocks];
+	byte						mAxeFxScene;
+};
+
+#endif // MidiOutShadow_h__
@@ -0,0 +1,222 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef MidiPortGenerator_h__
+#define MidiPortGenerator_h__
+
+#include <format>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Engine/IMidiOut.h"
+#include "../Engine/IMidiIn.h"
+#include "../Engine/IMidiOutGenerator.h"
+#include "../Engine/IMidiInGenerator.h"
+#include "../Engine/ITraceDisplay.h"
+#include "MidiDeviceNames.h"
+#include "MidiPortOpener.h"
+
+class ISwitchDisplay;
+
+
+// MidiPortGenerator
+// ----------------------------------------------------------------------------
+// IMidiOutGenerator and IMidiInGenerator for one backend, for hosts other
+// than the Qt UI (which generates ports itself), e.g.
+//   MidiPortGenerator<AlsaMidiOut, AlsaMidiIn>
+//   MidiPortGenerator<LoopbackMidiOut, LoopbackMidiIn>
+// One port object per device index.  Device names are matched as a case
+// insensitive substring, as in the UI, against a scan made on first use;
+// create a new generator to pick up device changes.  Ports are opened
+// concurrently.
+//
+template<typename TMidiOut, typename TMidiIn>
+class MidiPortGenerator : public IMidiOutGenerator, public IMidiInGenerator
+{
+public:
+	MidiPortGenerator(ITraceDisplay * trace, ISwitchDisplay * activityDisplay = nullptr) :
+		mTrace(trace),
+		mActivityDisplay(activityDisplay)
+	{
+	}
+
+	virtual ~MidiPortGenerator()
+	{
+		CloseMidiIns();
+		CloseMidiOuts();
+	}
+
+	// IMidiOutGenerator
+	virtual IMidiOutPtr CreateMidiOut(unsigned int deviceIdx, int activityIndicatorIdx, unsigned int ledColor) override
+	{
+		IMidiOutPtr & midiOut = mMidiOuts[deviceIdx];
+		if (!midiOut)
+			midiOut = std::make_shared<TMidiOut>(mTrace);
+
+		if (activityIndicatorIdx > 0 && mActivityDisplay)
+			midiOut->SetActivityIndicator(mActivityDisplay, activityIndicatorIdx, ledColor);
+
+		return midiOut;
+	}
+
+	virtual IMidiOutPtr GetMidiOut(unsigned int deviceIdx) override
+	{
+		auto it = mMidiOuts.find(deviceIdx);
+		return it == mMidiOuts.end() ? nullptr : it->second;
+	}
+
+	virtual unsigned int GetMidiOutDeviceIndex(const std::string & deviceName) override
+	{
+		return GetMidiOutDeviceNames().Find(deviceName);
+	}
+
+	virtual void OpenMidiOuts() override
+	{
+		std::vector<std::pair<unsigned int, IMidiOutPtr>> toOpen;
+		for (auto & cur : mMidiOuts)
+		{
+			if (cur.second && !cur.second->IsMidiOutOpen())
+				toOpen.emplace_back(cur.first, cur.second);
+		}
+
+		const MidiDeviceNames & names = GetMidiOutDeviceNames();
+		const unsigned int kCnt = names.GetCount();
+		const std::vector<bool> opened(::OpenMidiPorts(toOpen, [kCnt](IMidiOutPtr curOut, unsigned int deviceIdx)
+		{
+			return deviceIdx < kCnt && curOut->OpenMidiOut(deviceIdx);
+		}));
+
+		for (size_t idx = 0; idx < toOpen.size(); ++idx)
+		{
+			const unsigned int kDeviceIdx = toOpen[idx].first;
+			if (opened[idx])
+				Trace(std::format("Opened MIDI out {} {}\n", kDeviceIdx, names.GetName(kDeviceIdx)));
+			else
+				Trace(std::format("Failed to open MIDI out {}\n", kDeviceIdx));
+		}
+	}
+
+	virtual void CloseMidiOuts() override
+	{
+		for (auto & cur : mMidiOuts)
+		{
+			if (cur.second && cur.second->IsMidiOutOpen())
+				cur.second->CloseMidiOut();
+		}
+	}
+
+	// IMidiInGenerator
+	virtual IMidiInPtr CreateMidiIn(unsigned int deviceIdx) override
+	{
+		IMidiInPtr & midiIn = mMidiIns[deviceIdx];
+		if (!midiIn)
+			midiIn = std::make_shared<TMidiIn>(mTrace);
+
+		return midiIn;
+	}
+
+	virtual IMidiInPtr GetMidiIn(unsigned int deviceIdx) override
+	{
+		auto it = mMidiIns.find(deviceIdx);
+		return it == mMidiIns.end() ? nullptr : it->second;
+	}
+
+	virtual unsigned int GetMidiInDeviceIndex(const std::string & deviceName) override
+	{
+		return GetMidiInDeviceNames().Find(deviceName);
+	}
+
+	virtual void OpenMidiIns() override
+	{
+		std::vector<std::pair<unsigned int, IMidiInPtr>> toOpen;
+		for (auto & cur : mMidiIns)
+		{
+			if (cur.second && !cur.second->IsMidiInOpen())
+				toOpen.emplace_back(cur.first, cur.second);
+		}
+
+		const MidiDeviceNames & names = GetMidiInDeviceNames();
+		const unsigned int kCnt = names.GetCount();
+		const std::vector<bool> opened(::OpenMidiPorts(toOpen, [kCnt](IMidiInPtr curIn, unsigned int deviceIdx)
+		{
+			return deviceIdx < kCnt && curIn->OpenMidiIn(deviceIdx);
+		}));
+
+		for (size_t idx = 0; idx < toOpen.size(); ++idx)
+		{
+			const unsigned int kDeviceIdx = toOpen[idx].first;
+			if (opened[idx])
+				Trace(std::format("Opened MIDI in {} {}\n", kDeviceIdx, names.GetName(kDeviceIdx)));
+			else
+				Trace(std::format("Failed to open MIDI in {}\n", kDeviceIdx));
+		}
+	}
+
+	virtual void CloseMidiIns() override
+	{
+		for (auto & cur : mMidiIns)
+		{
+			if (cur.second && cur.second->IsMidiInOpen())
+				cur.second->CloseMidiIn();
+		}
+	}
+
+private:
+	const MidiDeviceNames & GetMidiOutDeviceNames()
+	{
+		if (!mMidiOutDeviceNames.IsScanned())
+		{
+			TMidiOut midiOut(nullptr);
+			mMidiOutDeviceNames.Scan(midiOut.GetMidiOutDeviceCount(), [&midiOut](unsigned int idx) { return midiOut.GetMidiOutDeviceName(idx); });
+		}
+		return mMidiOutDeviceNames;
+	}
+
+	const MidiDeviceNames & GetMidiInDeviceNames()
+	{
+		if (!mMidiInDeviceNames.IsScanned())
+		{
+			TMidiIn midiIn(nullptr);
+			mMidiInDeviceNames.Scan(midiIn.GetMidiInDeviceCount(), [&midiIn](unsigned int idx) { return midiIn.GetMidiInDeviceName(idx); });
+		}
+		return mMidiInDeviceNames;
+	}
+
+	void Trace(const std::string & msg)
+	{
+		if (mTrace)
+			mTrace->Trace(msg);
+	}
+
+	ITraceDisplay					* mTrace;
+	ISwitchDisplay					* mActivityDisplay;
+	std::map<unsigned int, IMidiOutPtr>	mMidiOuts;
+	std::map<unsigned int, IMidiInPtr>	mMidiIns;
+	MidiDeviceNames					mMidiOutDeviceNames;
+	MidiDeviceNames					mMidiInDeviceNames;
+};
+
+#endif // MidiPortGenerator_h__
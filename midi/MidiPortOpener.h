@@ -0,0 +1,66 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef MidiPortOpener_h__
+#define MidiPortOpener_h__
+
+#include <future>
+#include <utility>
+#include <vector>
+
+
+// OpenMidiPorts
+// ----------------------------------------------------------------------------
+// Runs open(port, deviceIdx) for each port concurrently and waits for all
+// of them, so that startup and resume take as long as the slowest device
+// rather than the sum of all of them (opening a Windows input port waits
+// for its service thread; USB drivers can be slow to answer).
+// Results are returned in the order of ports; a single port is opened on
+// the calling thread.
+//
+template<typename TPort, typename TOpen>
+std::vector<bool>
+OpenMidiPorts(const std::vector<std::pair<unsigned int, TPort>> & ports, 
+			  TOpen open)
+{
+	std::vector<bool> opened(ports.size(), false);
+	if (1 == ports.size())
+	{
+		opened[0] = open(ports[0].second, ports[0].first);
+		return opened;
+	}
+
+	std::vector<std::future<bool>> pending;
+	pending.reserve(ports.size());
+	for (const auto & cur : ports)
+		pending.push_back(std::async(std::launch::async, open, cur.second, cur.first));
+
+	for (size_t idx = 0; idx < pending.size(); ++idx)
+		opened[idx] = pending[idx].get();
+
+	return opened;
+}
+
+#endif // MidiPortOpener_h__
@@ -0,0 +1,71 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+#ifndef RunningStatusEncoder_h__
+#define RunningStatusEncoder_h__
+
+
+// RunningStatusEncoder
+// ----------------------------------------------------------------------------
+// Drops the status byte of channel messages that repeat the previous
+// channel status.  Must see every message in wire order.
+// Rules:
+//   channel voice/mode (0x80-0xEF): becomes running status
+//   system common and sysex (0xF0-0xF7): cancels running status
+//   realtime (0xF8-0xFF): may be interleaved, no effect
+// Short messages are packed status | data1 << 8 | data2 << 16; an encoded
+// message with the status dropped is data1 | data2 << 8 (what
+// midiOutShortMsg expects for running status).
+//
+class RunningStatusEncoder
+{
+public:
+	RunningStatusEncoder() = default;
+
+	void Reset() { mRunningStatus = 0; }
+
+	unsigned int Encode(unsigned int shortMsg)
+	{
+		const unsigned int status = shortMsg & 0xFF;
+		if (status < 0xF0)
+		{
+			if (status == mRunningStatus)
+				return shortMsg >> 8;
+
+			mRunningStatus = status;
+		}
+		else if (status < 0xF8)
+			mRunningStatus = 0;
+
+		return shortMsg;
+	}
+
+	// sysex is sent outside of Encode
+	void SysexSent() { mRunningStatus = 0; }
+
+private:
+	unsigned int		mRunningStatus = 0;
+};
+
+#endif // RunningStatusEncoder_h__
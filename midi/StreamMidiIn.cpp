@@ -0,0 +1,147 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include "StreamMidiIn.h"
+#include "../Engine/IMidiInSubscriber.h"
+#include "../Engine/ITraceDisplay.h"
+#include "../Engine/CrossPlatform.h"
+
+
+StreamMidiIn::StreamMidiIn(ITraceDisplay * trace) :
+	mTrace(trace),
+	mParser(MidiInQueue::kMaxSysexLen),
+	mInQueue(this)
+{
+}
+
+StreamMidiIn::~StreamMidiIn()
+{
+	// device was closed by the derived class
+	_ASSERTE(!mOpen);
+}
+
+bool
+StreamMidiIn::OpenMidiIn(unsigned int deviceIdx)
+{
+	_ASSERTE(!mOpen);
+	mDeviceIdx = deviceIdx;
+	// subscribers may have added interests since subscribing
+	mInputSubscribers.Rebuild();
+	mParser.Reset();
+	mInQueue.Start();
+	if (!OpenDevice(deviceIdx))
+	{
+		mInQueue.Stop();
+		mInputSubscribers.DispatchStopped();
+		return false;
+	}
+
+	mOpen = true;
+	return true;
+}
+
+void
+StreamMidiIn::ReceiveBytes(const byte * data, 
+						   size_t len, 
+						   MidiInQueue::Clock::time_point driverTime)
+{
+	mParser.Parse(data, len, 
+		[this, driverTime](unsigned int shortMsg) { mInQueue.PushData(shortMsg, driverTime); },
+		[this, driverTime](const byte * sysex, size_t sysexLen) { mInQueue.PushSysex(sysex, sysexLen, driverTime); });
+}
+
+// IMidiInQueueSink (dispatch thread)
+void
+StreamMidiIn::DispatchData(byte b1, 
+						   byte b2, 
+						   byte b3)
+{
+	mInputSubscribers.RouteData(b1, b2, b3);
+}
+
+void
+StreamMidiIn::DispatchSysex(const byte * bytes, 
+							int len)
+{
+	mInputSubscribers.RouteSysex(bytes, len);
+}
+
+bool
+StreamMidiIn::Subscribe(IMidiInSubscriberPtr sub)
+{
+	return mInputSubscribers.Subscribe(sub);
+}
+
+void
+StreamMidiIn::Unsubscribe(IMidiInSubscriberPtr sub)
+{
+	mInputSubscribers.Unsubscribe(sub);
+}
+
+bool
+StreamMidiIn::SuspendMidiIn()
+{
+	if (!mOpen)
+		return false;
+
+	ReleaseMidiIn();
+	return true;
+}
+
+bool
+StreamMidiIn::ResumeMidiIn()
+{
+	return OpenMidiIn(mDeviceIdx);
+}
+
+void
+StreamMidiIn::CloseMidiIn()
+{
+	ReleaseMidiIn();
+	mInQueue.SetCapture(nullptr, 0);
+	mInputSubscribers.CloseAll(weak_from_this().lock());
+}
+
+void
+StreamMidiIn::ReleaseMidiIn()
+{
+	if (!mOpen)
+		return;
+
+	// once the device is closed nothing more can be pushed
+	CloseDevice();
+	mOpen = false;
+	mInQueue.Stop();
+	mInputSubscribers.DispatchStopped();
+
+	mInQueue.ReportStats(mTrace, mDeviceIdx);
+}
+
+void
+StreamMidiIn::ReportError(const std::string & msg)
+{
+	if (mTrace)
+		mTrace->Trace(msg);
+}
@@ -0,0 +1,90 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef StreamMidiIn_h__
+#define StreamMidiIn_h__
+
+#include "../Engine/IMidiIn.h"
+#include "MidiInQueue.h"
+#include "MidiInRouter.h"
+#include "MidiByteStream.h"
+
+class ITraceDisplay;
+
+
+// StreamMidiIn
+// ----------------------------------------------------------------------------
+// IMidiIn for backends that read a raw MIDI byte stream (ALSA rawmidi,
+// loopback).  The backend hands whatever it reads to ReceiveBytes from a
+// single thread; the bytes are split into messages and go through a
+// MidiInQueue to the subscribers, as in WinMidiIn.
+// Derived classes must call CloseMidiIn in their destructor.
+//
+class StreamMidiIn : public IMidiIn, private IMidiInQueueSink
+{
+public:
+	StreamMidiIn(ITraceDisplay * trace);
+	virtual ~StreamMidiIn();
+
+	// IMidiIn
+	virtual bool OpenMidiIn(unsigned int deviceIdx) override;
+	virtual bool IsMidiInOpen() const override { return mOpen; }
+	virtual bool Subscribe(IMidiInSubscriberPtr sub) override;
+	virtual void Unsubscribe(IMidiInSubscriberPtr sub) override;
+	virtual void InterestChanged() override { mInputSubscribers.Rebuild(); }
+	virtual MidiInStats GetMidiInStats() const override { return mInQueue.GetStats(); }
+	virtual void SetCapture(MidiInCaptureWriterPtr capture, int port) override { mInQueue.SetCapture(capture, port); }
+	virtual bool SuspendMidiIn() override;
+	virtual bool ResumeMidiIn() override;
+	virtual void CloseMidiIn() override;
+
+protected:
+	// once OpenDevice returns true, ReceiveBytes may be called until
+	// CloseDevice returns
+	virtual bool OpenDevice(unsigned int deviceIdx) = 0;
+	virtual void CloseDevice() = 0;
+
+	// from one thread at a time; never blocks
+	void ReceiveBytes(const byte * data, size_t len, MidiInQueue::Clock::time_point driverTime = MidiInQueue::Clock::time_point());
+
+	void ReportError(const std::string & msg);
+
+	ITraceDisplay				* mTrace;
+
+private:
+	void ReleaseMidiIn();
+
+	// IMidiInQueueSink
+	virtual void DispatchData(byte b1, byte b2, byte b3) override;
+	virtual void DispatchSysex(const byte * bytes, int len) override;
+
+	unsigned int				mDeviceIdx = 0;
+	bool						mOpen = false;
+	MidiByteStreamParser		mParser;	// receiving thread only
+	MidiInSubscriberSet			mInputSubscribers;	// can change while the port is open
+	MidiInQueue					mInQueue;
+};
+
+#endif // StreamMidiIn_h__
@@ -0,0 +1,254 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#include "StreamMidiOut.h"
+#include "../Engine/ITraceDisplay.h"
+#include "../Engine/CrossPlatform.h"
+
+
+StreamMidiOut::StreamMidiOut(ITraceDisplay * trace) :
+	mTrace(trace),
+	mOutQueue(this),
+	mClock(this)
+{
+}
+
+StreamMidiOut::~StreamMidiOut()
+{
+	// device was closed by the derived class
+	_ASSERTE(!mOpen);
+}
+
+void
+StreamMidiOut::SetActivityIndicator(ISwitchDisplay * activityIndicator, 
+									int activityIndicatorIdx, 
+									unsigned int ledColor)
+{
+	mActivity.SetIndicator(activityIndicator, activityIndicatorIdx, ledColor);
+}
+
+void
+StreamMidiOut::EnableActivityIndicator(bool enable)
+{
+	mActivity.Enable(enable);
+}
+
+bool
+StreamMidiOut::OpenMidiOut(unsigned int deviceIdx)
+{
+	_ASSERTE(!mOpen);
+	mDeviceIdx = deviceIdx;
+	if (!OpenDevice(deviceIdx))
+		return false;
+
+	mOpen = true;
+	mName = GetMidiOutDeviceName(deviceIdx);
+	mWriter.Reset();
+	mOutQueue.Start();
+
+	if (mClockEnabled)
+		EnableMidiClock(true);
+
+	return true;
+}
+
+bool
+StreamMidiOut::MidiOut(const Bytes & bytes, 
+					   bool useIndicator /*= true*/)
+{
+	if (!mOpen || bytes.empty())
+		return false;
+
+	// runtime generated strings are split here; strings loaded from
+	// config are split at load time (see MidiCommandString)
+	EncodedMidi msgs;
+	std::string errMsg;
+	if (!msgs.Encode(bytes, &errMsg))
+		ReportError(errMsg);
+
+	return MidiOut(msgs, useIndicator);
+}
+
+bool
+StreamMidiOut::MidiOut(const EncodedMidi & msgs, 
+					   bool useIndicator /*= true*/)
+{
+	if (!mOpen || msgs.Empty())
+		return false;
+
+	if (useIndicator)
+		mActivity.Activity();
+
+	mOutQueue.Enqueue(msgs);
+	return true;
+}
+
+bool
+StreamMidiOut::MidiOutBatch(std::span<const EncodedMidi * const> batch, 
+							bool useIndicator /*= true*/)
+{
+	if (!mOpen || batch.empty())
+		return false;
+
+	if (useIndicator)
+		mActivity.Activity();
+
+	mOutQueue.Enqueue(batch);
+	return true;
+}
+
+void
+StreamMidiOut::MidiOut(MidiEvent evt, 
+					   bool useIndicator /*= true*/)
+{
+	if (!mOpen)
+		return;
+
+	if (useIndicator)
+		mActivity.Activity();
+
+	mOutQueue.Enqueue(evt.GetShortMsg());
+}
+
+void
+StreamMidiOut::ControlChangeLatestValue(byte statusByte, 
+										byte controller, 
+										byte value, 
+										bool useIndicator /*= true*/)
+{
+	if (!mOpen)
+		return;
+
+	if (useIndicator)
+		mActivity.Activity();
+
+	mOutQueue.EnqueueLatestValue(statusByte, controller, value);
+}
+
+void
+StreamMidiOut::ControlChange14LatestValue(byte statusByte, 
+										  byte controller, 
+										  byte msb, 
+										  byte lsb, 
+										  bool useIndicator /*= true*/)
+{
+	if (!mOpen)
+		return;
+
+	if (useIndicator)
+		mActivity.Activity();
+
+	mOutQueue.EnqueueLatestValue14(statusByte, controller, msb, lsb);
+}
+
+// IMidiOutQueueSink (sender thread)
+void
+StreamMidiOut::SendShortMsg(unsigned int shortMsg)
+{
+	byte bytes[3];
+	const size_t len = mWriter.Encode(shortMsg, bytes);
+	if (len)
+		WriteBytes(bytes, len);
+}
+
+void
+StreamMidiOut::SendSysex(const byte * data, 
+						 size_t len)
+{
+	mWriter.SysexSent();
+	if (len)
+		WriteBytes(data, len);
+}
+
+// IMidiClockSink (clock thread)
+void
+StreamMidiOut::SendClockTick()
+{
+	// realtime is legal anywhere in the stream, even inside sysex, so ticks
+	// are written directly rather than waiting on the sender thread (which
+	// can be held up by pacing or a slow device).  realtime doesn't affect
+	// running status, so the writer doesn't need to see it.
+	const byte tick = 0xF8;
+	WriteBytes(&tick, 1);
+}
+
+void
+StreamMidiOut::EnableMidiClock(bool enable)
+{
+	mClockEnabled = enable;
+	if (enable && mOpen)
+		mClock.Start();
+	else
+		mClock.Stop();
+}
+
+bool
+StreamMidiOut::SuspendMidiOut()
+{
+	if (!mOpen)
+		return false;
+
+	const bool prevVal = mClockEnabled;
+	ReleaseMidiOut();
+	mClockEnabled = prevVal;
+	return true;
+}
+
+bool
+StreamMidiOut::ResumeMidiOut()
+{
+	return OpenMidiOut(mDeviceIdx);
+}
+
+void
+StreamMidiOut::CloseMidiOut()
+{
+	mActivity.SetIndicator(nullptr, 0, 0);
+	ReleaseMidiOut();
+}
+
+void
+StreamMidiOut::ReleaseMidiOut()
+{
+	EnableMidiClock(false);
+
+	// let the sender thread finish what was queued before the device goes away
+	mOutQueue.Stop();
+
+	mOutQueue.ReportStats(mTrace, mName);
+
+	if (mOpen)
+	{
+		CloseDevice();
+		mOpen = false;
+	}
+}
+
+void
+StreamMidiOut::ReportError(const std::string & msg)
+{
+	if (mTrace)
+		mTrace->Trace(msg);
+}
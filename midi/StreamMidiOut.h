@@ -0,0 +1,114 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef StreamMidiOut_h__
+#define StreamMidiOut_h__
+
+#include <string>
+#include "../Engine/IMidiOut.h"
+#include "../Engine/MidiActivityIndicator.h"
+#include "MidiOutQueue.h"
+#include "MidiClockGenerator.h"
+#include "MidiByteStream.h"
+
+class ITraceDisplay;
+
+
+// StreamMidiOut
+// ----------------------------------------------------------------------------
+// IMidiOut for backends that write a raw MIDI byte stream (ALSA rawmidi,
+// loopback).  As in WinMidiOut, sends go through a MidiOutQueue and the
+// beat clock comes from a MidiClockGenerator; the backend only opens the
+// device and writes bytes on the queue's sender thread (clock ticks are
+// written on the clock thread).
+// Derived classes must call CloseMidiOut in their destructor.
+//
+class StreamMidiOut : public IMidiOut, private IMidiOutQueueSink, private IMidiClockSink
+{
+public:
+	StreamMidiOut(ITraceDisplay * trace);
+	virtual ~StreamMidiOut();
+
+	// IMidiOut
+	using IMidiOut::GetMidiOutDeviceName;
+	virtual std::string GetMidiOutDeviceName() const override { return mName; }
+	virtual void SetActivityIndicator(ISwitchDisplay * activityIndicator, int activityIndicatorIdx, unsigned int ledColor) override;
+	virtual void EnableActivityIndicator(bool enable) override;
+	virtual bool OpenMidiOut(unsigned int deviceIdx) override;
+	virtual bool IsMidiOutOpen() const override { return mOpen; }
+	virtual bool MidiOut(const Bytes & bytes, bool useIndicator = true) override;
+	virtual bool MidiOut(const EncodedMidi & msgs, bool useIndicator = true) override;
+	virtual bool MidiOutBatch(std::span<const EncodedMidi * const> batch, bool useIndicator = true) override;
+	virtual void MidiOut(MidiEvent evt, bool useIndicator = true) override;
+	virtual void ControlChangeLatestValue(byte statusByte, byte controller, byte value, bool useIndicator = true) override;
+	virtual void ControlChange14LatestValue(byte statusByte, byte controller, byte msb, byte lsb, bool useIndicator = true) override;
+	virtual void EnableRunningStatus(bool enable) override { mOutQueue.EnableRunningStatus(enable); }
+	virtual void SetBandwidth(unsigned int bytesPerSecond) override { mOutQueue.SetBandwidth(bytesPerSecond); }
+	virtual void EnableShadowState(unsigned int channelMask, int axeFxChannel = -1) override { mOutQueue.EnableShadowState(channelMask, axeFxChannel); }
+	virtual void ResetShadowState(int channel) override { mOutQueue.ResetShadowState(channel); }
+	virtual MidiShadowStats GetShadowStats() const override { return mOutQueue.GetShadowStats(); }
+	virtual void EnableMidiClock(bool enable) override;
+	virtual bool IsMidiClockEnabled() override { return mClockEnabled && mClock.IsRunning(); }
+	virtual void SetTempo(int bpm) override { mClock.SetTempo(bpm); }
+	virtual int GetTempo() const override { return mClock.GetTempo(); }
+	virtual MidiClockStats GetMidiClockStats() const override { return mClock.GetStats(); }
+	virtual bool SuspendMidiOut() override;
+	virtual bool ResumeMidiOut() override;
+	virtual void CloseMidiOut() override;
+
+	MidiOutQueue::Stats GetQueueStats() const { return mOutQueue.GetStats(); }
+
+protected:
+	virtual bool OpenDevice(unsigned int deviceIdx) = 0;
+	virtual void CloseDevice() = 0;
+	// sender thread, and the clock thread for single realtime bytes (which
+	// may land anywhere in the stream); len is never 0
+	virtual void WriteBytes(const byte * data, size_t len) = 0;
+
+	void ReportError(const std::string & msg);
+
+	ITraceDisplay				* mTrace;
+
+private:
+	void ReleaseMidiOut();
+
+	// IMidiOutQueueSink
+	virtual void SendShortMsg(unsigned int shortMsg) override;
+	virtual void SendSysex(const byte * data, size_t len) override;
+
+	// IMidiClockSink
+	virtual void SendClockTick() override;
+
+	std::string					mName;
+	unsigned int				mDeviceIdx = 0;
+	bool						mOpen = false;
+	MidiActivityIndicator		mActivity;
+	MidiOutQueue				mOutQueue;
+	MidiByteStreamWriter		mWriter;	// sender thread only
+	MidiClockGenerator			mClock;
+	bool						mClockEnabled = false; // separate control state from clock thread since suspend command stops the thread
+};
+
+#endif // StreamMidiOut_h__
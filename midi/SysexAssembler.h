@@ -0,0 +1,155 @@
+/*
+ * mTroll MIDI Controller
+ * Copyright (C) 2026 Sean Echevarria
+ *
+ * This file is part of mTroll.
+ *
+ * mTroll is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mTroll is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Let me know if you modify, extend or use mTroll.
+ * Original project site: http://www.creepingfog.com/mTroll/
+ * Contact Sean: "fester" at the domain of the original project site
+ */
+
+
+#ifndef SysexAssembler_h__
+#define SysexAssembler_h__
+
+#include <atomic>
+#include <span>
+#include <vector>
+
+using byte = unsigned char;
+
+
+// SysexAssembler
+// ----------------------------------------------------------------------------
+// Rebuilds whole sysex messages from the pieces a driver delivers them in
+// (a message larger than a driver buffer arrives in several buffers).
+// Pieces are accumulated in an arena that is reused from message to
+// message; a message that arrives in a single piece is delivered straight
+// from the driver's buffer without being copied.
+// Realtime bytes interleaved in a message are removed.  A message that
+// grows past the size limit is dropped; one that is cut off by another
+// status byte is counted as truncated and also dropped.
+//
+class SysexAssembler
+{
+public:
+	SysexAssembler(size_t maxMessageLen = kDefaultMaxMessageLen) : mMaxMessageLen(maxMessageLen) { }
+
+	enum { kDefaultMaxMessageLen = 64 * 1024 };
+
+	// calls deliver(std::span<const byte>) for each message completed by
+	// this piece; the span is only valid for the duration of the call
+	template<typename Deliver>
+	void Append(const byte * data, size_t len, Deliver && deliver);
+	// drop any partial message (port closed)
+	void Reset();
+	// drop any partial message and count it as truncated (pieces of it
+	// were lost, so what follows can't be appended to it)
+	void Truncate();
+
+	unsigned int GetDroppedCount() const { return mDropped; }
+	unsigned int GetTruncatedCount() const { return mTruncated; }
+	void ResetStats() { mDropped = 0; mTruncated = 0; }
+
+private:
+	void Start() { mArena.clear(); mState = stAssembling; }
+	void Add(const byte * data, size_t len);
+
+	enum State { stIdle, stAssembling, stDiscarding };
+
+	const size_t				mMaxMessageLen;
+	State						mState = stIdle;
+	std::vector<byte>			mArena;		// capacity is kept between messages
+	std::atomic<unsigned int>	mDropped{0};
+	std::atomic<unsigned int>	mTruncated{0};
+};
+
+
+template<typename Deliver>
+void
+SysexAssembler::Append(const byte * data, 
+					   size_t len, 
+					   Deliver && deliver)
+{
+	size_t pos = 0;
+	while (pos < len)
+	{
+		if (stIdle == mState)
+		{
+			// skip anything that isn't the start of a message
+			while (pos < len && data[pos] != 0xF0)
+				++pos;
+			if (pos == len)
+				return;
+
+			// whole message in this piece with nothing to strip: no copy
+			size_t end = pos + 1;
+			while (end < len && data[end] < 0x80)
+				++end;
+			if (end < len && data[end] == 0xF7 && end + 1 - pos <= mMaxMessageLen)
+			{
+				deliver(std::span<const byte>(&data[pos], end + 1 - pos));
+				pos = end + 1;
+				continue;
+			}
+
+			Start();
+			Add(&data[pos++], 1);
+			continue;
+		}
+
+		// copy data bytes up to the next status byte in one go
+		size_t runEnd = pos;
+		while (runEnd < len && data[runEnd] < 0x80)
+			++runEnd;
+		Add(&data[pos], runEnd - pos);
+		pos = runEnd;
+		if (pos == len)
+			return;
+
+		const byte status = data[pos];
+		if (status >= 0xF8)
+		{
+			// realtime can be interleaved anywhere
+			++pos;
+			continue;
+		}
+
+		if (0xF7 == status && stAssembling == mState)
+		{
+			Add(&data[pos++], 1);
+			deliver(std::span<const byte>(mArena.data(), mArena.size()));
+			mState = stIdle;
+			continue;
+		}
+
+		if (0xF7 == status)
+		{
+			// end of a message that was too large
+			++pos;
+			mState = stIdle;
+			continue;
+		}
+
+		// any other status byte ends the message without an EOX
+		Truncate();
+		if (0xF0 != status)
+			++pos;
+	}
+}
+
+#endif // SysexAssembler_h__
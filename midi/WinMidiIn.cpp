@@ -48,7 +48,8 @@ WinMidiIn::WinMidiIn(ITraceDisplay * trace) :
 	mThreadId(0),
 	mDeviceIdx(0),
 	mThreadState(tsNotStarted),
-	mCurMidiHdrIdx(0)
+	mCurMidiHdrIdx(0),
+	mInQueue(this)
 {
 #ifdef ITEM_COUNTING
 	++gWinMidiInCnt;
@@ -57,6 +58,7 @@ WinMidiIn::WinMidiIn(ITraceDisplay * trace) :
 	for (auto & midiHdr : mMidiHdrs)
 		ZeroMemory(&midiHdr, sizeof(MIDIHDR));
 	mDoneEvent = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
+	mStartedEvent = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
 }
 
 WinMidiIn::~WinMidiIn()
@@ -64,6 +66,8 @@ WinMidiIn::~WinMidiIn()
 	CloseMidiIn();
 	if (mDoneEvent && mDoneEvent != INVALID_HANDLE_VALUE)
 		::CloseHandle(mDoneEvent);
+	if (mStartedEvent && mStartedEvent != INVALID_HANDLE_VALUE)
+		::CloseHandle(mStartedEvent);
 
 #ifdef ITEM_COUNTING
 	--gWinMidiInCnt;
@@ -101,7 +105,10 @@ WinMidiIn::OpenMidiIn(unsigned int deviceIdx)
 {
 	_ASSERTE(!mMidiIn);
 	mDeviceIdx = deviceIdx;
+	// subscribers may have added interests since subscribing
+	mInputSubscribers.Rebuild();
 	mThreadState = tsStarting;
+	::ResetEvent(mStartedEvent);
 	mThread = (HANDLE)_beginthreadex(nullptr, 0, ServiceThread, this, 0, (unsigned int*)&mThreadId);
 	if (!mThread)
 	{
@@ -109,10 +116,13 @@ WinMidiIn::OpenMidiIn(unsigned int deviceIdx)
 		return false;
 	}
 
-	while (mThread && mThreadState == tsStarting)
-		::Sleep(500);
+	// the thread signals once the driver has started, or exits if the
+	// open failed; either way there is nothing to poll for
+	_ASSERTE(mStartedEvent && mStartedEvent != INVALID_HANDLE_VALUE);
+	const HANDLE waitHandles[] = { mStartedEvent, mThread };
+	::WaitForMultipleObjects(2, waitHandles, FALSE, INFINITE);
 
-	return mThread && mThreadState == tsRunning;
+	return mThreadState == tsRunning;
 }
 
 void
@@ -128,12 +138,13 @@ WinMidiIn::ServiceThread()
 		return;
 	}
 
-	const int kDataBufLen = 512;
+	// buffers go back to the driver as soon as they are copied into the
+	// input queue, and the queue reassembles sysex that spans buffers
 	int idx;
 	for (idx = 0; idx < MIDIHDR_CNT; ++idx)
 	{
-		mMidiHdrs[idx].lpData = (LPSTR) ::malloc(kDataBufLen);
-		mMidiHdrs[idx].dwBufferLength = kDataBufLen;
+		mMidiHdrs[idx].lpData = (LPSTR) mHdrBuffers[idx];
+		mMidiHdrs[idx].dwBufferLength = MidiInQueue::kMaxSysexLen;
 		
 		res = ::midiInPrepareHeader(mMidiIn, &mMidiHdrs[idx], (UINT)sizeof(MIDIHDR));
 		if (MMSYSERR_NOERROR != res)
@@ -144,10 +155,13 @@ WinMidiIn::ServiceThread()
 			ReportMidiError(res, __LINE__);
 	}
 
+	mInQueue.Start();
 	mThreadState = tsRunning;
+	mStartTime = MidiInQueue::Clock::now();
 	res = ::midiInStart(mMidiIn);
 	if (MMSYSERR_NOERROR != res)
 		ReportMidiError(res, __LINE__);
+	::SetEvent(mStartedEvent);
 
 	_ASSERTE(mDoneEvent && mDoneEvent != INVALID_HANDLE_VALUE);
 	for (;;)
@@ -197,7 +211,6 @@ WinMidiIn::ServiceThread()
 		res = ::midiInUnprepareHeader(mMidiIn, &mMidiHdrs[idx], (UINT)sizeof(MIDIHDR));
 		if (MMSYSERR_NOERROR != res)
 			ReportMidiError(res, __LINE__);
-		::free(mMidiHdrs[idx].lpData);
 		mMidiHdrs[idx].lpData = nullptr;
 	}
 
@@ -250,12 +263,8 @@ WinMidiIn::MidiInCallbackProc(HMIDIIN hmi,
 		if (_this->mThreadState != tsRunning)
 			return;
 
-		for (MidiInSubscribers::const_iterator it = _this->mInputSubscribers.begin();
-			it != _this->mInputSubscribers.end(); ++it)
-		{
-			if (*it)
-				(*it)->ReceivedData(LOBYTE(dwParam1), HIBYTE(dwParam1), LOBYTE(HIWORD(dwParam1)));
-		}
+		// subscribers are called on the queue's dispatch thread
+		_this->mInQueue.PushData((unsigned int)dwParam1, _this->mStartTime + std::chrono::milliseconds(dwParam2));
 		break;
 	case MIM_ERROR:
 		break;
@@ -264,15 +273,9 @@ WinMidiIn::MidiInCallbackProc(HMIDIIN hmi,
 		// 	dwParam2 is the event time in ms since the start of midi in
 		hdr = (LPMIDIHDR) dwParam1;
 		if (_this->mThreadState == tsRunning)
-		{
-			for (MidiInSubscribers::const_iterator it = _this->mInputSubscribers.begin();
-				it != _this->mInputSubscribers.end(); ++it)
-			{
-				if (*it)
-					(*it)->ReceivedSysex((byte*)hdr->lpData, (int)hdr->dwBytesRecorded);
-			}
-		}
+			_this->mInQueue.PushSysex((const byte*)hdr->lpData, hdr->dwBytesRecorded, _this->mStartTime + std::chrono::milliseconds(dwParam2));
 
+		// the data has been copied so the buffer goes straight back to the driver
 		res = ::midiInAddBuffer(_this->mMidiIn, hdr, sizeof(MIDIHDR));
 		if (MMSYSERR_NOERROR != res)
 			_this->ReportMidiError(res, __LINE__);
@@ -286,23 +289,28 @@ WinMidiIn::MidiInCallbackProc(HMIDIIN hmi,
 	}
 }
 
+// IMidiInQueueSink (dispatch thread)
+void
+WinMidiIn::DispatchData(byte b1, 
+						byte b2, 
+						byte b3)
+{
+	mInputSubscribers.RouteData(b1, b2, b3);
+}
+
+void
+WinMidiIn::DispatchSysex(const byte * bytes, 
+						 int len)
+{
+	mInputSubscribers.RouteSysex(bytes, len);
+}
+
 void
 WinMidiIn::CloseMidiIn()
 {
 	ReleaseMidiIn();
-	for (auto & curItem : mInputSubscribers)
-	{
-		try
-		{
-			auto _this = shared_from_this();
-			if (_this)
-				curItem->Closed(_this);
-		}
-		catch (const std::exception &)
-		{
-		}
-	}
-	mInputSubscribers.clear();
+	mInQueue.SetCapture(nullptr, 0);
+	mInputSubscribers.CloseAll(weak_from_this().lock());
 }
 
 void
@@ -349,39 +357,15 @@ WinMidiIn::ReportError(LPCTSTR msg,
 bool
 WinMidiIn::Subscribe(IMidiInSubscriberPtr sub)
 {
-	if (mThreadState != tsRunning)
-	{
-		for (auto & inputSubscriber : mInputSubscribers)
-		{
-			if (inputSubscriber == sub)
-				return false;
-		}
-
-		mInputSubscribers.push_back(sub);
-		return true;
-	}
-	else
-	{
-		_ASSERTE(!"don't subscribe to midi in events after thread has started");
-		return false;
-	}
+	// takes effect on the dispatch thread with the next event; no need to
+	// restart input
+	return mInputSubscribers.Subscribe(sub);
 }
 
 void
 WinMidiIn::Unsubscribe(IMidiInSubscriberPtr sub)
 {
-	if (mThreadState != tsRunning)
-	{
-		for (auto & inputSubscriber : mInputSubscribers)
-		{
-			if (inputSubscriber == sub)
-				inputSubscriber = nullptr;
-		}
-	}
-	else
-	{
-		_ASSERTE(!"don't unsubscribe to midi in events until thread has stopped");
-	}
+	mInputSubscribers.Unsubscribe(sub);
 }
 
 bool
@@ -418,6 +402,12 @@ WinMidiIn::ReleaseMidiIn()
 	}
 
 	_ASSERTE(!mMidiIn);
+
+	// driver is closed so nothing more can be pushed
+	mInQueue.Stop();
+	mInputSubscribers.DispatchStopped();
+
+	mInQueue.ReportStats(mTrace, mDeviceIdx);
 }
 
 
@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2010,2013,2018,2022,2025 Sean Echevarria
+ * Copyright (C) 2010,2013,2018,2022,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -29,12 +29,13 @@
 #include <Windows.h>
 #include <MMSystem.h>
 #include <tchar.h>
-#include <vector>
+#include "MidiInQueue.h"
+#include "MidiInRouter.h"
 
 class ITraceDisplay;
 
 
-class WinMidiIn : public IMidiIn
+class WinMidiIn : public IMidiIn, private IMidiInQueueSink
 {
 public:
 	WinMidiIn(ITraceDisplay * trace);
@@ -47,6 +48,9 @@ public:
 	virtual bool IsMidiInOpen() const override {return mMidiIn != nullptr;}
 	virtual bool Subscribe(IMidiInSubscriberPtr sub) override;
 	virtual void Unsubscribe(IMidiInSubscriberPtr sub) override;
+	virtual void InterestChanged() override { mInputSubscribers.Rebuild(); }
+	virtual MidiInStats GetMidiInStats() const override { return mInQueue.GetStats(); }
+	virtual void SetCapture(MidiInCaptureWriterPtr capture, int port) override { mInQueue.SetCapture(capture, port); }
 	virtual bool SuspendMidiIn() override;
 	virtual bool ResumeMidiIn() override;
 	virtual void CloseMidiIn() override;
@@ -60,23 +64,30 @@ private:
 	void ReportError(LPCTSTR msg, int param1);
 	void ReportError(LPCTSTR msg, int param1, int param2);
 
+	// IMidiInQueueSink
+	virtual void DispatchData(byte b1, byte b2, byte b3) override;
+	virtual void DispatchSysex(const byte * bytes, int len) override;
+
 	static void CALLBACK MidiInCallbackProc(HMIDIIN hmi, UINT wMsg, DWORD_PTR dwInstance, DWORD_PTR dwParam1, DWORD_PTR dwParam2);
 
 	enum ThreadState { tsNotStarted, tsStarting, tsRunning, tsEnding };
 
 	ITraceDisplay				* mTrace;
 	HMIDIIN						mMidiIn;
-	enum { MIDIHDR_CNT = 512 };
+	enum { MIDIHDR_CNT = 64 };
 	MIDIHDR						mMidiHdrs[MIDIHDR_CNT];
+	char						mHdrBuffers[MIDIHDR_CNT][MidiInQueue::kMaxSysexLen];
 	int							mCurMidiHdrIdx;
 	unsigned int				mDeviceIdx;
 	bool						mMidiInError;
 	HANDLE						mDoneEvent;
+	HANDLE						mStartedEvent;		// service thread is running (or gave up)
 	HANDLE						mThread;
 	ThreadState					mThreadState;
 	DWORD						mThreadId;
-	using MidiInSubscribers = std::vector<IMidiInSubscriberPtr>;
-	MidiInSubscribers			mInputSubscribers;
+	MidiInQueue::Clock::time_point	mStartTime;		// driver timestamps are ms since midiInStart
+	MidiInSubscriberSet			mInputSubscribers;	// can change while the port is open
+	MidiInQueue					mInQueue;
 };
 
 #endif // WinMidiIn_h__
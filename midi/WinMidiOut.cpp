@@ -23,30 +23,14 @@
  *
  */
 
-/*
- * The following notice applies to WinMidiOut::SetTempo and WinMidiOut::ClockThread:
- * 
-Copyright (c) 2016 Pete Brown
-
-Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
- **/
-
 #include <atomic>
-#include <cmath>
 #include "WinMidiOut.h"
 #include "../Engine/ITraceDisplay.h"
-#include "../Engine/ISwitchDisplay.h"
 #include <atlstr.h>
-#include "SleepShort.h"
 
 #pragma comment(lib, "winmm.lib")
 
 static CString GetMidiErrorText(MMRESULT resultCode);
-static WinMidiOut * sOutOnTimer = nullptr;
 #ifdef ITEM_COUNTING
 std::atomic<int> gWinMidiOutCnt = 0;
 #endif
@@ -57,12 +41,9 @@ WinMidiOut::WinMidiOut(ITraceDisplay * trace) :
 	mMidiOut(nullptr),
 	mMidiOutError(false),
 	mCurMidiHdrIdx(0),
-	mActivityIndicator(nullptr),
-	mActivityIndicatorIndex(0),
-	mEnableActivityIndicator(false),
-	mTimerEventCount(0),
-	mTimerId(0),
-	mDeviceIdx(0)
+	mDeviceIdx(0),
+	mOutQueue(this),
+	mClock(this)
 {
 #ifdef ITEM_COUNTING
 	++gWinMidiOutCnt;
@@ -70,21 +51,12 @@ WinMidiOut::WinMidiOut(ITraceDisplay * trace) :
 
 	for (auto & midiHdr : mMidiHdrs)
 		ZeroMemory(&midiHdr, sizeof(MIDIHDR));
-
-	mTimerId = ::SetTimer(nullptr, mTimerId, 150, TimerProc);
-	::QueryPerformanceFrequency(&mPerfFreq);
+	for (auto & pending : mMidiHdrPending)
+		pending.store(false, std::memory_order_relaxed);
 }
 
 WinMidiOut::~WinMidiOut()
 {
-	::KillTimer(nullptr, mTimerId);
-
-	if (sOutOnTimer == this)
-	{
-		sOutOnTimer = nullptr;
-		TurnOffIndicator();
-	}
-
 	CloseMidiOut();
 
 #ifdef ITEM_COUNTING
@@ -129,25 +101,13 @@ WinMidiOut::SetActivityIndicator(ISwitchDisplay * activityIndicator,
 								 int activityIndicatorIdx, 
 								 unsigned int ledColor)
 {
-	mActivityIndicator = activityIndicator;
-	mActivityIndicatorIndex = activityIndicatorIdx;
-	mEnableActivityIndicator = mActivityIndicatorIndex > 0 && mActivityIndicator != nullptr;
-	mLedColor = ledColor;
+	mActivity.SetIndicator(activityIndicator, activityIndicatorIdx, ledColor);
 }
 
 void
 WinMidiOut::EnableActivityIndicator(bool enable)
 {
-	if (enable)
-	{
-		mEnableActivityIndicator = mActivityIndicatorIndex > 0 && mActivityIndicator != nullptr;
-		mTimerEventCount = 0;
-	}
-	else
-	{
-		mEnableActivityIndicator = false;
-		TurnOffIndicator();
-	}
+	mActivity.Enable(enable);
 }
 
 bool
@@ -159,13 +119,13 @@ WinMidiOut::OpenMidiOut(unsigned int deviceIdx)
 	if (MMSYSERR_NOERROR != res)
 		ReportMidiError(res, __LINE__);
 	else
+	{
 		mName = GetMidiOutDeviceName(deviceIdx);
+		mOutQueue.Start();
+	}
 
 	if (mClockEnabled)
-	{
-		SetTempo(mTempo);
 		EnableMidiClock(true);
-	}
 
 	return res == MMSYSERR_NOERROR;
 }
@@ -189,96 +149,87 @@ WinMidiOut::MidiOut(const Bytes & bytes, bool useIndicator /*= true*/)
 		return false;
 	}
 
-	const size_t kDataSize = bytes.size();
-	if (!kDataSize)
+	if (bytes.empty())
 		return false;
 
-	if (useIndicator)
-		IndicateActivity();
-
-	// number of data bytes for each status
-	static const int kMsgDataBytesLen = 23;
-	static const int kMsgDataBytes[23] = { 2, 2, 2, 2, 1, 1, 2, 0, 1, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	// runtime generated strings are split here; strings loaded from
+	// config are split at load time (see MidiCommandString)
+	EncodedMidi msgs;
+	std::string errMsg;
+	if (!msgs.Encode(bytes, &errMsg))
+		ReportError(CString(errMsg.c_str()));
 
-	const byte * dataPtr = &bytes[0];
-	size_t idx = 0;
-	MMRESULT res;
-	mMidiOutError = false;
-	int sysexDepth = 0;
-
-	const int kBufferSize = 256;
-	const int kDelayTime = 60;
+	return MidiOut(msgs, useIndicator);
+}
 
-	for ( ; idx < kDataSize && !mMidiOutError; )
-	{
-		int curMsgLen;
-		int statusByteIdx = dataPtr[idx];
+bool
+WinMidiOut::MidiOut(const EncodedMidi & msgs, bool useIndicator /*= true*/)
+{
+	if (!mMidiOut || msgs.Empty())
+		return false;
 
-		if (sysexDepth || SYSEX == statusByteIdx)
-		{
-			curMsgLen = 0;
+	if (useIndicator)
+		mActivity.Activity();
 
-			do
-			{
-				if (SYSEX == statusByteIdx)
-					sysexDepth++;	// nested sysex
-				else if (EOX == statusByteIdx)
-					sysexDepth--;
+	// pacing and retries happen on the queue's sender thread
+	mOutQueue.Enqueue(msgs);
+	return true;
+}
 
-				if (!((idx + ++curMsgLen) % kBufferSize))
-					break;
-			}
-			while (sysexDepth && (idx + curMsgLen) < kDataSize);
+bool
+WinMidiOut::MidiOutBatch(std::span<const EncodedMidi * const> batch, 
+						 bool useIndicator /*= true*/)
+{
+	if (!mMidiOut || batch.empty())
+		return false;
 
-			LPMIDIHDR curHdr = &mMidiHdrs[mCurMidiHdrIdx++];
-			if (mCurMidiHdrIdx == MIDIHDR_CNT)
-				mCurMidiHdrIdx = 0;
+	if (useIndicator)
+		mActivity.Activity();
 
-			curHdr->dwBufferLength = curMsgLen;
-			curHdr->lpData = (LPSTR)(byte*)&bytes[idx];
+	mOutQueue.Enqueue(batch);
+	return true;
+}
 
-			res = ::midiOutPrepareHeader(mMidiOut, curHdr, sizeof(MIDIHDR));
-			if (MMSYSERR_NOERROR == res)
-				res = ::midiOutLongMsg(mMidiOut, curHdr, sizeof(MIDIHDR));
-		}
-		else
+// IMidiOutQueueSink (sender thread)
+void
+WinMidiOut::SendSysex(const byte * data, 
+					  size_t len)
+{
+	// the queue slices and paces sysex; this is one slice.  data belongs
+	// to the queue, so it is copied to the header's own buffer and the
+	// driver sends it after we return.  the header is recycled on MOM_DONE.
+	mMidiOutError = false;
+	const int hdrIdx = mCurMidiHdrIdx++;
+	if (mCurMidiHdrIdx == MIDIHDR_CNT)
+		mCurMidiHdrIdx = 0;
+
+	// only waits if the driver has every header
+	while (mMidiOut && mMidiHdrPending[hdrIdx].load(std::memory_order_acquire))
+		::Sleep(1);
+
+	Bytes & buffer = mMidiHdrBuffers[hdrIdx];
+	buffer.assign(data, data + len);
+	LPMIDIHDR curHdr = &mMidiHdrs[hdrIdx];
+	ZeroMemory(curHdr, sizeof(MIDIHDR));
+	curHdr->lpData = (LPSTR)buffer.data();
+	curHdr->dwBufferLength = (DWORD)len;
+	curHdr->dwUser = (DWORD_PTR)hdrIdx;
+
+	while (mMidiOut)
+	{
+		MMRESULT res = ::midiOutPrepareHeader(mMidiOut, curHdr, sizeof(MIDIHDR));
+		if (MMSYSERR_NOERROR == res)
 		{
-			if ((statusByteIdx & 0xF0) < SYSEX)		// is it a channel message?
-				statusByteIdx = ((statusByteIdx & 0xF0) >> 4) - 8;
-			else		// or system message
-				statusByteIdx = (statusByteIdx & 0x0F) + 7;
-
-			if (statusByteIdx < 0)
-			{
-				ReportError(_T("Status byte handling error at byte %d (%x).\n"), (int)idx+1, dataPtr[idx]);
-				break;
-			}
-
-			curMsgLen = statusByteIdx >= kMsgDataBytesLen ? 1 : kMsgDataBytes[statusByteIdx] + 1;
-			if ((idx + curMsgLen) > kDataSize)
-			{
-				ReportError(_T("Data string consistency error at byte %d.  Missing data byte.\n"), (int)idx+1);
-				break;
-			}
-
-			DWORD shortMsg;
-			switch (curMsgLen)
+			// MOM_DONE can arrive before midiOutLongMsg returns
+			mMidiHdrPending[hdrIdx].store(true, std::memory_order_release);
+			++mSysexPending;
+			res = ::midiOutLongMsg(mMidiOut, curHdr, sizeof(MIDIHDR));
+			if (MMSYSERR_NOERROR != res)
 			{
-			case 1:			// no data bytes
-				shortMsg = dataPtr[idx];
-				break;
-			case 2:			// one data byte
-				shortMsg = dataPtr[idx] | (dataPtr[idx+1] << 8);
-				break;
-			case 3:			// two data bytes
-				shortMsg = dataPtr[idx] | (dataPtr[idx+1] << 8) | (dataPtr[idx+2] << 16);
-				break;
-			default:
-				_ASSERTE(!"impossible");
-				shortMsg = 0;
+				::midiOutUnprepareHeader(mMidiOut, curHdr, sizeof(MIDIHDR));
+				--mSysexPending;
+				mMidiHdrPending[hdrIdx].store(false, std::memory_order_release);
 			}
-
-			res = ::midiOutShortMsg(mMidiOut, shortMsg);
 		}
 
 		if (MMSYSERR_NOERROR != res)
@@ -288,63 +239,70 @@ WinMidiOut::MidiOut(const Bytes & bytes, bool useIndicator /*= true*/)
 				Sleep(10);
 				continue;
 			}
-			else
-			{
-				ReportMidiError(res, __LINE__);
-				break;
-			}
-		}
 
-		idx += curMsgLen;
-		if (!(idx % kBufferSize))
-			::Sleep(kDelayTime);
+			ReportMidiError(res, __LINE__);
+		}
+		break;
 	}
-
-	if (false && mTrace && !mMidiOutError)
-		mTrace->Trace("Transmission complete.\n");
-
-	return true;
 }
 
 void
-WinMidiOut::MidiOut(byte singleByte,
+WinMidiOut::MidiOut(MidiEvent evt,
 					bool useIndicator /*= true*/)
 {
 	if (!mMidiOut)
 		return;
 
-	MidiOut((DWORD)singleByte, useIndicator);
+	if (useIndicator)
+		mActivity.Activity();
+
+	mOutQueue.Enqueue(evt.GetShortMsg());
 }
 
 void
-WinMidiOut::MidiOut(byte byte1, 
-					byte byte2,
-					bool useIndicator /*= true*/)
+WinMidiOut::ControlChangeLatestValue(byte statusByte, 
+									 byte controller, 
+									 byte value,
+									 bool useIndicator /*= true*/)
 {
 	if (!mMidiOut)
 		return;
 
-	const DWORD shortMsg = byte1 | (byte2 << 8);
-	MidiOut(shortMsg, useIndicator);
+	if (useIndicator)
+		mActivity.Activity();
+
+	mOutQueue.EnqueueLatestValue(statusByte, controller, value);
 }
 
 void
-WinMidiOut::MidiOut(byte byte1, 
-					byte byte2, 
-					byte byte3,
-					bool useIndicator /*= true*/)
+WinMidiOut::ControlChange14LatestValue(byte statusByte, 
+									   byte controller, 
+									   byte msb, 
+									   byte lsb, 
+									   bool useIndicator /*= true*/)
 {
 	if (!mMidiOut)
 		return;
 
-	const DWORD shortMsg = byte1 | (byte2 << 8) | (byte3 << 16);
-	MidiOut(shortMsg, useIndicator);
+	if (useIndicator)
+		mActivity.Activity();
+
+	mOutQueue.EnqueueLatestValue14(statusByte, controller, msb, lsb);
 }
 
+// IMidiOutQueueSink (sender thread)
 void
-WinMidiOut::MidiOut(DWORD shortMsg, 
-					bool useIndicator /*= true*/)
+WinMidiOut::SendShortMsg(unsigned int shortMsg)
 {
+	// short messages don't queue behind long ones in the driver; wait for
+	// sysex that was handed off to go out so that wire order is kept
+	// (realtime may be sent anywhere)
+	if ((shortMsg & 0xFF) < MIDI_CLOCK)
+	{
+		while (mMidiOut && mSysexPending.load(std::memory_order_acquire))
+			::Sleep(1);
+	}
+
 	MMRESULT res;
 	for (;;)
 	{
@@ -361,168 +319,41 @@ WinMidiOut::MidiOut(DWORD shortMsg,
 				ReportMidiError(res, __LINE__);
 			}
 		}
-		else if (useIndicator)
-			IndicateActivity();
 		break;
 	}
 }
 
-unsigned int __stdcall
-WinMidiOut::ClockThread(void* _thisParam)
-{
-	WinMidiOut* _this = static_cast<WinMidiOut*>(_thisParam);
-	_this->ClockThread();
-	_endthreadex(0);
-	return 0;
-}
-
-// if mPerfFreq is 10,000,000 counts per second, then:
-// 240bpm: (10000000 / (240 / 60)) / 24 = 104167 -> 96 pulses per second, ~10ms per clock pulse
-// 120bpm: (10000000 / (120 / 60)) / 24 = 208333 -> 48 pulses per second, ~21ms per clock pulse
-//  60bpm: (10000000 /  (60 / 60)) / 24 = 416666 -> 24 pulses per second, ~42ms per clock pulse
-
-// WinMidiOut::ClockThread is from the implementation of MidiClockGenerator::ThreadWorker by Pete Brown
-// https://github.com/Psychlist1972/Windows-10-MIDI-Library/blob/master/PeteBrown.Devices.Midi/PeteBrown.Devices.Midi/MidiClockGenerator.cpp
-// Copyright (c) 2016 Pete Brown
-// MIT License https://github.com/Psychlist1972/Windows-10-MIDI-Library/blob/master/LICENSE.md
-// https://github.com/Psychlist1972
+// IMidiClockSink (clock thread)
 void
-WinMidiOut::ClockThread()
+WinMidiOut::SendClockTick()
 {
-	MMRESULT res;
-	LARGE_INTEGER lastTime;
-	LONGLONG nextTime;
-	LARGE_INTEGER currentTime;
-
-	currentTime.QuadPart = 0;
-
-	double errorAccumulator = 0.0;
-	// not exact 5ms boundaries for breathing room...
-	const LONGLONG k40msInCycles = (LONGLONG)((mPerfFreq.QuadPart / 1000) * 40.2f);
-	const LONGLONG k35msInCycles = (LONGLONG)((mPerfFreq.QuadPart / 1000) * 35.2f);
-	const LONGLONG k30msInCycles = (LONGLONG)((mPerfFreq.QuadPart / 1000) * 30.2f);
-	const LONGLONG k25msInCycles = (LONGLONG)((mPerfFreq.QuadPart / 1000) * 25.2f);
-	const LONGLONG k20msInCycles = (LONGLONG)((mPerfFreq.QuadPart / 1000) * 20.2f);
-	const LONGLONG k15msInCycles = (LONGLONG)((mPerfFreq.QuadPart / 1000) * 15.2f);
-	const LONGLONG k10msInCycles = (LONGLONG)((mPerfFreq.QuadPart / 1000) * 10.4f);
-	const LONGLONG k5msInCycles = (LONGLONG)((mPerfFreq.QuadPart / 1000) * 5.5f);
-
-	while (mRunClockThread)
-	{
-		::QueryPerformanceCounter(&lastTime);
-
-		// send the message
-		res = ::midiOutShortMsg(mMidiOut, (DWORD)MIDI_CLOCK);
-
-		nextTime = lastTime.QuadPart + mTickInterval;
-
-		if (errorAccumulator >= 1.0)
-		{
-			// get the whole number part of the error and then remove it from
-			// the accumulator (which is a double)
-			nextTime += (long)(std::trunc(errorAccumulator));
-			errorAccumulator -= (long)(std::trunc(errorAccumulator));
-		}
-
-		::QueryPerformanceCounter(&currentTime);
-		if (nextTime > currentTime.QuadPart)
-		{
-			const LONGLONG waitCycles = nextTime - currentTime.QuadPart;
-			// if nextTime is more than XXms away, use SleepShort for at least XXms of the time
-			if (waitCycles > k40msInCycles)
-				::SleepShort(40.0); // 60bpm
-			else if (waitCycles > k35msInCycles)
-				::SleepShort(35.0);
-			else if (waitCycles > k30msInCycles)
-				::SleepShort(30.0);
-			else if (waitCycles > k25msInCycles)
-				::SleepShort(25.0); // 90bpm
-			else if (waitCycles > k20msInCycles)
-				::SleepShort(20.0); // 120bpm
-			else if (waitCycles > k15msInCycles)
-				::SleepShort(15.0); // 120bpm
-			else if (waitCycles > k10msInCycles)
-				::SleepShort(10.0); // 180bpm, 240bpm
-			else if (waitCycles > k5msInCycles)
-				::SleepShort(5.0);// 240bpm
-			else
-				; // 240bpm
-		}
-
-		// spin until this cycle is done
-		// This is the one part I really dislike here.
-		// sleeping the thread is no good due to durations required
-		while (currentTime.QuadPart < nextTime)
-			::QueryPerformanceCounter(&currentTime);
-
-		// accumulate some error :)
-		errorAccumulator += mTickTruncationError;
-	}
-
-	mClockThreadId = 0;
+	// realtime is legal anywhere on the wire, even inside sysex, so ticks
+	// go straight to the driver rather than waiting on the sender thread
+	// (which can be held up by pacing or a busy driver).
+	// a dropped tick is better than a flood of error reports at 96 per second
+	::midiOutShortMsg(mMidiOut, (DWORD)MIDI_CLOCK);
 }
 
 void
 WinMidiOut::EnableMidiClock(bool enable)
 {
-	if (enable)
-	{
-		if (mClockThread)
-		{
-			// end the thread if already running
-			EnableMidiClock(false);
-		}
-
-		// start the thread
-		mClockEnabled = mRunClockThread = true;
-		mClockThread = (HANDLE)_beginthreadex(nullptr, 0, ClockThread, this, 0, (unsigned int*)&mClockThreadId);
-	}
-	else 
-	{
-		mClockEnabled = false;
-		if (mRunClockThread)
-		{
-			// end the thread
-			if (mClockThread)
-			{
-				mRunClockThread = false;
-				::WaitForSingleObjectEx(mClockThread, 30000, FALSE);
-				::CloseHandle(mClockThread);
-				mClockThread = nullptr;
-			}
-		}
-	}
+	mClockEnabled = enable;
+	if (enable && mMidiOut)
+		mClock.Start();
+	else
+		mClock.Stop();
 }
 
-// WinMidiOut::SetTempo is from the implementation of MidiClockGenerator::Tempo::set by Pete Brown
-// https://github.com/Psychlist1972/Windows-10-MIDI-Library/blob/master/PeteBrown.Devices.Midi/PeteBrown.Devices.Midi/MidiClockGenerator.cpp
-// Copyright (c) 2016 Pete Brown
-// MIT License https://github.com/Psychlist1972/Windows-10-MIDI-Library/blob/master/LICENSE.md
-// https://github.com/Psychlist1972
 void
 WinMidiOut::SetTempo(int bpm)
 {
-	constexpr int ppqn = 24;
-
-	// The Fractal Audio Axe-FX III tempo range is 24-250, which seems reasonable to enforce
-	if (bpm < 24)
-		mTempo = 24;
-	else if (bpm > 250)
-		mTempo = 250;
-	else
-		mTempo = bpm;
-
-	// this is going to have rounding errors
-	// we account for this in the clock worker thread function
-	mTickInterval = (LONGLONG)(std::trunc(((double)mPerfFreq.QuadPart / (mTempo / 60.0F)) / ppqn));
-
-	mTickTruncationError = (double)(((double)mPerfFreq.QuadPart / (mTempo / 60.0F)) / ppqn) - mTickInterval;
+	mClock.SetTempo(bpm);
 }
 
 int
 WinMidiOut::GetTempo() const
 {
-	return mTempo;
+	return mClock.GetTempo();
 }
 
 void CALLBACK 
@@ -540,63 +371,10 @@ WinMidiOut::MidiOutCallbackProc(HMIDIOUT hmo,
 		hdr->dwFlags = 0;
 		if (MMSYSERR_NOERROR != res)
 			_this->ReportMidiError(res, __LINE__);
-	}
-}
-
-void
-WinMidiOut::IndicateActivity()
-{
-	if (!mEnableActivityIndicator)
-	{
-		if (sOutOnTimer == this)
-		{
-			sOutOnTimer = nullptr;
-			TurnOffIndicator();
-		}
 
-		return;
-	}
-
-	LONG prevCount = ::InterlockedIncrement(&mTimerEventCount);
-	if (sOutOnTimer)
-	{
-		sOutOnTimer->TurnOffIndicator();
-		if (prevCount > 1)
-		{
-			if (!::InterlockedDecrement(&mTimerEventCount))
-			{
-				// whoops - don't go to 0 else the timer will make the count go negative
-				::InterlockedIncrement(&mTimerEventCount);
-			}
-		}
-	}
-
-	mActivityIndicator->SetSwitchDisplay(mActivityIndicatorIndex, mLedColor);
-	// this seems to sometimes cause indicator to remain on
-	// mTimerId = ::SetTimer(nullptr, mTimerId, 150, TimerProc);
-	sOutOnTimer = this;
-}
-
-void
-WinMidiOut::TurnOffIndicator()
-{
-	if (mActivityIndicator)
-		mActivityIndicator->TurnOffSwitchDisplay(mActivityIndicatorIndex);
-}
-
-void CALLBACK
-WinMidiOut::TimerProc(HWND, 
-					  UINT, 
-					  UINT_PTR id, 
-					  DWORD)
-{
-	WinMidiOut * _this = sOutOnTimer;
-	if (_this)
-	{
-		if (!::InterlockedDecrement(&_this->mTimerEventCount))
-			sOutOnTimer = nullptr;
-
-		_this->TurnOffIndicator();
+		// header (and its buffer) can be reused
+		--_this->mSysexPending;
+		_this->mMidiHdrPending[hdr->dwUser].store(false, std::memory_order_release);
 	}
 }
 
@@ -624,9 +402,7 @@ WinMidiOut::ResumeMidiOut()
 void
 WinMidiOut::CloseMidiOut()
 {
-	mEnableActivityIndicator = false;
-	mActivityIndicator = nullptr;
-	mTimerEventCount = 0;
+	mActivity.SetIndicator(nullptr, 0, 0);
 	ReleaseMidiOut();
 }
 
@@ -635,6 +411,11 @@ WinMidiOut::ReleaseMidiOut()
 {
 	EnableMidiClock(false);
 
+	// let the sender thread finish what was queued before the handle goes away
+	mOutQueue.Stop();
+
+	mOutQueue.ReportStats(mTrace, mName);
+
 	if (mMidiOut)
 	{
 		MMRESULT res = ::midiOutReset(mMidiOut);
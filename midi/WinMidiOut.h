@@ -1,6 +1,6 @@
 /*
  * mTroll MIDI Controller
- * Copyright (C) 2007-2008,2013,2018,2020,2022,2025 Sean Echevarria
+ * Copyright (C) 2007-2008,2013,2018,2020,2022,2025,2026 Sean Echevarria
  *
  * This file is part of mTroll.
  *
@@ -25,16 +25,20 @@
 #ifndef WinMidiOut_h__
 #define WinMidiOut_h__
 
+#include <atomic>
 #include "../Engine/IMidiOut.h"
 #include <Windows.h>
 #include <MMSystem.h>
 #include <tchar.h>
 #include "../Engine/EngineLoader.h"
+#include "MidiOutQueue.h"
+#include "MidiClockGenerator.h"
+#include "../Engine/MidiActivityIndicator.h"
 
 class ITraceDisplay;
 
 
-class WinMidiOut : public IMidiOut
+class WinMidiOut : public IMidiOut, private IMidiOutQueueSink, private IMidiClockSink
 {
 public:
 	WinMidiOut(ITraceDisplay * trace);
@@ -49,16 +53,24 @@ public:
 	virtual bool OpenMidiOut(unsigned int deviceIdx) override;
 	virtual bool IsMidiOutOpen() const override {return mMidiOut != nullptr;}
 	virtual bool MidiOut(const Bytes & bytes, bool useIndicator = true) override;
-	virtual void MidiOut(byte singleByte, bool useIndicator = true) override;
-	virtual void MidiOut(byte byte1, byte byte2, bool useIndicator = true) override;
-	virtual void MidiOut(byte byte1, byte byte2, byte byte3, bool useIndicator = true) override;
+	virtual bool MidiOut(const EncodedMidi & msgs, bool useIndicator = true) override;
+	virtual bool MidiOutBatch(std::span<const EncodedMidi * const> batch, bool useIndicator = true) override;
+	virtual void MidiOut(MidiEvent evt, bool useIndicator = true) override;
+	virtual void ControlChangeLatestValue(byte statusByte, byte controller, byte value, bool useIndicator = true) override;
+	virtual void ControlChange14LatestValue(byte statusByte, byte controller, byte msb, byte lsb, bool useIndicator = true) override;
+	virtual void EnableRunningStatus(bool enable) override { mOutQueue.EnableRunningStatus(enable); }
+	virtual void SetBandwidth(unsigned int bytesPerSecond) override { mOutQueue.SetBandwidth(bytesPerSecond); }
+	virtual void EnableShadowState(unsigned int channelMask, int axeFxChannel = -1) override { mOutQueue.EnableShadowState(channelMask, axeFxChannel); }
+	virtual void ResetShadowState(int channel) override { mOutQueue.ResetShadowState(channel); }
+	virtual MidiShadowStats GetShadowStats() const override { return mOutQueue.GetShadowStats(); }
 	virtual void EnableMidiClock(bool enable) override;
 	virtual bool IsMidiClockEnabled() override
 	{
-		return mClockEnabled && mClockThread && mRunClockThread;
+		return mClockEnabled && mClock.IsRunning();
 	}
 	virtual void SetTempo(int bpm) override;
 	virtual int GetTempo() const override;
+	virtual MidiClockStats GetMidiClockStats() const override { return mClock.GetStats(); }
 	virtual bool SuspendMidiOut() override;
 	virtual bool ResumeMidiOut() override;
 	virtual void CloseMidiOut() override;
@@ -69,40 +81,32 @@ private:
 	void ReportError(LPCTSTR msg, int param1);
 	void ReportError(LPCTSTR msg, int param1, int param2);
 
-	void MidiOut(DWORD shortMsg, bool useIndicator = true);
-	void IndicateActivity();
-	void TurnOffIndicator();
+	// IMidiOutQueueSink
+	virtual void SendShortMsg(unsigned int shortMsg) override;
+	virtual void SendSysex(const byte * data, size_t len) override;
+
 	void ReleaseMidiOut();
-	static void CALLBACK TimerProc(HWND, UINT, UINT_PTR id, DWORD);
 	static void CALLBACK MidiOutCallbackProc(HMIDIOUT hmo, UINT wMsg, DWORD_PTR dwInstance, DWORD_PTR dwParam1, DWORD_PTR dwParam2);
 
-	static unsigned int __stdcall ClockThread(void* _this);
-	void ClockThread();
+	// IMidiClockSink
+	virtual void SendClockTick() override;
 
 	std::string					mName;
 	ITraceDisplay				* mTrace;
-	ISwitchDisplay				* mActivityIndicator;
-	volatile bool				mEnableActivityIndicator;
-	int							mActivityIndicatorIndex;
 	HMIDIOUT					mMidiOut;
 	enum {MIDIHDR_CNT = 128};
 	MIDIHDR						mMidiHdrs[MIDIHDR_CNT];
+	Bytes						mMidiHdrBuffers[MIDIHDR_CNT];	// sysex slice of each header; capacity is retained
+	std::atomic_bool			mMidiHdrPending[MIDIHDR_CNT];	// header is with the driver; cleared on MOM_DONE
+	std::atomic<int>			mSysexPending{0};
 	int							mCurMidiHdrIdx;
 	bool						mMidiOutError;
-	UINT_PTR					mTimerId;
-	LONG						mTimerEventCount;
 	unsigned int				mDeviceIdx;
-	unsigned int				mLedColor = kFirstColorPreset;
-
-	HANDLE						mClockThread = nullptr;
-	DWORD						mClockThreadId = 0;
-	std::atomic_bool			mRunClockThread = false;
-	bool						mClockEnabled = false; // separate control state from thread loop since suspend command kills the thread
+	MidiActivityIndicator		mActivity;
+	MidiOutQueue				mOutQueue;
 
-	LARGE_INTEGER				mPerfFreq = { 0, 0 };
-	int							mTempo = 120;
-	LONGLONG					mTickInterval;
-	double						mTickTruncationError; // diff between ideal interval and mTickInterval
+	MidiClockGenerator			mClock;
+	bool						mClockEnabled = false; // separate control state from clock thread since suspend command stops the thread
 };
 
 #endif // WinMidiOut_h__